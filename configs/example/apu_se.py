@@ -380,6 +380,15 @@ parser.add_argument(
     help="Gfx version for gpuNote: gfx902 is not fully supported by ROCm",
 )
 
+parser.add_argument(
+    "--gpu-mem-trace-dir",
+    type=str,
+    default=None,
+    help="Record the global memory instructions of every compute unit "
+    "in a trace in this directory, to be replayed with "
+    "configs/example/gpu_trace_replay.py",
+)
+
 Ruby.define_options(parser)
 
 # add TLB options to the parser
@@ -397,6 +406,9 @@ else:
     # Set default benchmark search path to current dir
     benchmark_path = ["."]
 
+if args.gpu_mem_trace_dir:
+    os.makedirs(args.gpu_mem_trace_dir, exist_ok=True)
+
 ########################## Sanity Check ########################
 
 # Currently the gpu model requires ruby
@@ -563,6 +575,11 @@ for i in range(n_cu):
         compute_units[-1].prefetch_depth = args.TLB_prefetch
         compute_units[-1].prefetch_prev_type = args.pf_type
 
+    if args.gpu_mem_trace_dir:
+        compute_units[-1].mem_trace = GpuMemTrace(
+            trace_file=os.path.join(args.gpu_mem_trace_dir, "gpu_mem_trace.gz")
+        )
+
     # attach the LDS and the CU to the bus (actually a Bridge)
     compute_units[-1].ldsPort = compute_units[-1].ldsBus.cpu_side_port
     compute_units[-1].ldsBus.mem_side_port = compute_units[
@@ -0,0 +1,154 @@
+# Copyright (c) 2026 University of Murcia
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Replay the global memory traces recorded by GpuMemTrace through the VIPER
+GPU caches, in place of the compute units that issued the accesses.
+
+Record the traces of a kernel, one per compute unit, with
+
+    build/VEGA_X86/gem5.opt configs/example/apu_se.py -n 3 \
+        --gpu-mem-trace-dir=traces -c square
+
+and replay them with
+
+    build/VEGA_X86/gem5.opt configs/example/gpu_trace_replay.py \
+        --trace-dir=traces
+
+The memory system options (e.g., the cache sizes) may differ from the ones
+of the recording, which is the point of replaying the traces.
+"""
+
+import argparse
+import glob
+import os
+import sys
+
+import m5
+from m5.objects import *
+from m5.util import addToPath
+
+addToPath("../")
+
+from common import Options
+from ruby import Ruby
+
+parser = argparse.ArgumentParser()
+Options.addNoISAOptions(parser)
+Ruby.define_options(parser)
+
+parser.add_argument(
+    "--trace-dir",
+    type=str,
+    required=True,
+    help="Directory with the traces recorded by apu_se.py "
+    "--gpu-mem-trace-dir, one per compute unit",
+)
+parser.add_argument(
+    "--trace-name",
+    type=str,
+    default="gpu_mem_trace.gz",
+    help="Name the traces end with",
+)
+parser.add_argument(
+    "--gpu-clock", type=str, default="1GHz", help="Clock of the replayers"
+)
+parser.add_argument(
+    "--max-cu-tokens",
+    type=int,
+    default=4,
+    help="Number of tokens of each replayer, i.e., the number of packets "
+    "it can send to its coalescer before back-pressure occurs",
+)
+
+args = parser.parse_args()
+
+traces = sorted(
+    glob.glob(os.path.join(args.trace_dir, "*." + args.trace_name))
+)
+if not traces:
+    sys.exit(f"No traces named *.{args.trace_name} in {args.trace_dir}")
+
+# One replayer and one vector coalescer per traced compute unit. The
+# instruction caches are not used, but the protocol needs at least one of
+# each. There are neither CPUs nor command processors.
+n_CUs = len(traces)
+args.num_compute_units = n_CUs
+args.cu_per_sqc = n_CUs
+args.num_sqc = 1
+args.cu_per_scalar_cache = n_CUs
+args.num_scalar_cache = 1
+args.num_cpus = 0
+args.num_cp = 0
+
+system = System(
+    mem_ranges=[AddrRange(args.mem_size)],
+    cache_line_size=args.cacheline_size,
+    mem_mode="timing",
+)
+
+system.voltage_domain = VoltageDomain(voltage=args.sys_voltage)
+system.clk_domain = SrcClockDomain(
+    clock=args.sys_clock, voltage_domain=system.voltage_domain
+)
+
+Ruby.create_system(args, full_system=False, system=system, cpus=[])
+
+gpu_clock = SrcClockDomain(
+    clock=args.gpu_clock, voltage_domain=system.voltage_domain
+)
+
+# The vector coalescers are not necessarily the first Ruby ports
+coalescers = [
+    port for port in system.ruby._cpu_ports if isinstance(port, VIPERCoalescer)
+]
+assert len(coalescers) == n_CUs
+
+replayers = []
+for trace, ruby_port in zip(traces, coalescers):
+    # The replayer has no dynamic instructions to hand over
+    ruby_port.using_ruby_tester = True
+
+    replayer = GpuTraceReplayer(
+        trace_file=os.path.abspath(trace),
+        max_tokens=args.max_cu_tokens,
+        clk_domain=gpu_clock,
+    )
+    replayer.port = ruby_port.in_ports
+    replayer.token_port = ruby_port.gmTokenPort
+    replayers.append(replayer)
+system.replayers = replayers
+
+root = Root(full_system=False, system=system)
+m5.instantiate()
+
+# Every replayer exits the simulation loop at the end of its trace
+for _ in range(n_CUs):
+    exit_event = m5.simulate()
+    if exit_event.getCause() != "End of GPU memory trace reached":
+        break
+
+print("Exiting @ tick %i because %s" % (m5.curTick(), exit_event.getCause()))
@@ -326,6 +326,15 @@ class TCCCntrl(TCC_Controller, CntrlBase):
         if options.recycle_latency:
             self.recycle_latency = options.recycle_latency
 
+        self.prefetchQueue = MessageBuffer()
+        if options.tcc_hwp_type:
+            hwpClass = ObjectList.hwp_list.get(options.tcc_hwp_type)
+            self.prefetcher = hwpClass()
+            self.use_prefetcher = True
+        else:
+            self.prefetcher = NULL
+            self.use_prefetcher = False
+
 
 class L3Cache(RubyCache):
     dataArrayBanks = 16
@@ -549,6 +558,14 @@ def define_options(parser):
         default="8",
         help="Data access latency in L2 cache",
     )
+    parser.add_argument(
+        "--tcc-hwp-type",
+        default=None,
+        choices=ObjectList.hwp_list.get_names(),
+        help="""
+        type of hardware prefetcher to use with the TCC.
+        (if not set, the TCC does not prefetch).""",
+    )
 
 
 def construct_dirs(options, system, ruby_system, network):
@@ -154,6 +154,19 @@ class InstDecoder : public SimObject
      * decoder isn't ready (see instReady()).
      */
     virtual StaticInstPtr decode(PCStateBase &pc) = 0;
+
+    /**
+     * Does decoding only depend on the instruction data and the PC?
+     *
+     * When true, an instruction decoded from a single moreBytes() call
+     * is fully determined by that data and by the PC state it is
+     * decoded with (as compared by PCStateBase::equals()), and so is
+     * the PC state decode() leaves. CPU models may then reuse the
+     * instruction and that PC state instead of decoding the same data
+     * again. Decoders that keep state of their own across instructions
+     * (e.g., processor modes or IT blocks) must return false.
+     */
+    virtual bool pureDecode() const { return false; }
 };
 
 } // namespace gem5
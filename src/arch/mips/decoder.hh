@@ -94,6 +94,8 @@ class Decoder : public InstDecoder
         instDone = false;
         return decode(emi, next_pc.instAddr());
     }
+
+    bool pureDecode() const override { return true; }
 };
 
 } // namespace MipsISA
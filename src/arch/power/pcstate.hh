@@ -63,6 +63,14 @@ class PCState : public GenericISA::SimplePCState<4>
         guestByteOrder = pcstate.guestByteOrder;
     }
 
+    bool
+    equals(const PCStateBase &other) const override
+    {
+        auto &opc = other.as<PCState>();
+        return GenericISA::SimplePCState<4>::equals(other) &&
+            guestByteOrder == opc.guestByteOrder;
+    }
+
     ByteOrder
     byteOrder() const
     {
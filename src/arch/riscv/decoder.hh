@@ -82,6 +82,8 @@ class Decoder : public InstDecoder
     void moreBytes(const PCStateBase &pc, Addr fetchPC) override;
 
     StaticInstPtr decode(PCStateBase &nextPC) override;
+
+    bool pureDecode() const override { return true; }
 };
 
 } // namespace RiscvISA
@@ -126,6 +126,7 @@ class PCState : public GenericISA::UPCState<4>
     {
         auto &opc = other.as<PCState>();
         return Base::equals(other) &&
+            _rvType == opc._rvType &&
             _vlenb == opc._vlenb &&
             _vtype == opc._vtype &&
             _vl == opc._vl;
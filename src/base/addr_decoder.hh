@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_ADDR_DECODER_HH__
+#define __BASE_ADDR_DECODER_HH__
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "base/addr_range.hh"
+#include "base/bitfield.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * An immutable, flattened address decoder. It is built from a set of
+ * non-overlapping address ranges (typically the contents of an
+ * AddrRangeMap once all ranges are known) and answers the same
+ * queries as AddrRangeMap::contains() without walking a tree.
+ *
+ * The ranges are kept as a sorted array of disjoint spans which is
+ * searched with a binary search. Interleaved ranges that merge with
+ * each other (same span and interleaving masks) share a single span,
+ * and the entry matching an address is selected by indexing a table
+ * with the interleaving bits of the address, so decoding for many
+ * interleaved channels costs the same as for a single range.
+ */
+template <typename V>
+class AddrDecoder
+{
+  private:
+    /** A contiguous span covered by one range or an interleaved group. */
+    struct Span
+    {
+        Addr start;
+        Addr end;
+        /** Interleaving masks, empty if the span is not interleaved. */
+        std::vector<Addr> masks;
+        /**
+         * For plain spans, the index of the entry. For interleaved
+         * spans, the offset in the stripe table of the first stripe.
+         */
+        size_t index;
+    };
+
+    /** The original ranges and their values. */
+    std::vector<std::pair<AddrRange, V>> entries;
+
+    /** Spans sorted by start address. */
+    std::vector<Span> spans;
+
+    /** Entry index of each stripe of the interleaved spans, or -1. */
+    std::vector<int> stripes;
+
+    /** Index of the interleaving stripe an address belongs to. */
+    static unsigned
+    stripeOf(const Span &span, Addr a)
+    {
+        unsigned sel = 0;
+        for (unsigned i = 0; i < span.masks.size(); i++)
+            sel |= (popCount(a & span.masks[i]) % 2) << i;
+        return sel;
+    }
+
+  public:
+    /**
+     * Rebuild the decoder.
+     *
+     * @param map Ranges and values, sorted as in an AddrRangeMap, i.e.
+     * interleaved ranges that merge with each other are adjacent.
+     */
+    template <typename Map>
+    void
+    build(const Map &map)
+    {
+        clear();
+
+        for (const auto &r : map) {
+            const AddrRange &range = r.first;
+            const size_t entry = entries.size();
+            entries.emplace_back(range, r.second);
+
+            if (!range.interleaved()) {
+                spans.push_back({range.start(), range.end(), {}, entry});
+                continue;
+            }
+
+            // Start a new interleaved group unless this range merges
+            // with the previous one
+            if (spans.empty() || spans.back().masks.empty() ||
+                !entries[entry - 1].first.mergesWith(range)) {
+                spans.push_back({range.start(), range.end(),
+                                 range.intlvMasks(), stripes.size()});
+                stripes.resize(stripes.size() + range.stripes(), -1);
+            }
+
+            stripes[spans.back().index + range.intlvMatchValue()] =
+                static_cast<int>(entry);
+        }
+
+        std::sort(spans.begin(), spans.end(),
+                  [](const Span &a, const Span &b)
+                  { return a.start < b.start; });
+    }
+
+    /** Remove all ranges. */
+    void
+    clear()
+    {
+        entries.clear();
+        spans.clear();
+        stripes.clear();
+    }
+
+    /** Is the decoder empty? */
+    bool empty() const { return entries.empty(); }
+
+    /**
+     * Find the value of the range that contains the given address range.
+     *
+     * @param r A non-interleaved address range
+     * @return A pointer to the value, or nullptr if no range contains r
+     */
+    const V *
+    contains(const AddrRange &r) const
+    {
+        auto it = std::upper_bound(spans.begin(), spans.end(), r.start(),
+                                   [](Addr a, const Span &s)
+                                   { return a < s.start; });
+        if (it == spans.begin())
+            return nullptr;
+        --it;
+        if (r.start() >= it->end)
+            return nullptr;
+
+        const int entry = it->masks.empty() ? static_cast<int>(it->index) :
+            stripes[it->index + stripeOf(*it, r.start())];
+        if (entry < 0)
+            return nullptr;
+
+        const auto &e = entries[entry];
+        return r.isSubset(e.first) ? &e.second : nullptr;
+    }
+
+    /**
+     * Find the value of the range that contains the given address.
+     *
+     * @param a An address
+     * @return A pointer to the value, or nullptr if no range contains a
+     */
+    const V *contains(Addr a) const { return contains(RangeSize(a, 1)); }
+};
+
+} // namespace gem5
+
+#endif // __BASE_ADDR_DECODER_HH__
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "base/addr_decoder.hh"
+#include "base/addr_range_map.hh"
+
+using namespace gem5;
+
+TEST(AddrDecoderTest, Empty)
+{
+    AddrDecoder<int> d;
+    EXPECT_TRUE(d.empty());
+    EXPECT_EQ(d.contains(0x1000), nullptr);
+}
+
+TEST(AddrDecoderTest, PlainRanges)
+{
+    AddrRangeMap<int> r;
+    r.insert(RangeIn(10, 40), 5);
+    r.insert(RangeIn(60, 90), 3);
+    r.insert(RangeIn(0, 9), 1);
+
+    AddrDecoder<int> d;
+    d.build(r);
+    EXPECT_FALSE(d.empty());
+
+    ASSERT_NE(d.contains(RangeIn(20, 30)), nullptr);
+    EXPECT_EQ(*d.contains(RangeIn(20, 30)), 5);
+    ASSERT_NE(d.contains(RangeIn(60, 90)), nullptr);
+    EXPECT_EQ(*d.contains(RangeIn(60, 90)), 3);
+    ASSERT_NE(d.contains(Addr(0)), nullptr);
+    EXPECT_EQ(*d.contains(Addr(0)), 1);
+
+    // Gaps and ranges straddling two entries
+    EXPECT_EQ(d.contains(RangeIn(55, 55)), nullptr);
+    EXPECT_EQ(d.contains(RangeIn(35, 65)), nullptr);
+    EXPECT_EQ(d.contains(RangeIn(91, 95)), nullptr);
+
+    d.clear();
+    EXPECT_TRUE(d.empty());
+    EXPECT_EQ(d.contains(RangeIn(20, 30)), nullptr);
+}
+
+/**
+ * An interleaved group decodes each address to the stripe selected by
+ * the parity of the masked address bits.
+ */
+TEST(AddrDecoderTest, Interleaved)
+{
+    const auto N = 16;
+    const auto masks = std::vector<Addr>{
+        0x4444444444440,
+        0x8888888888880,
+        0x1111111111100,
+        0x2222222222200
+    };
+    const Addr start = 0x80000000;
+    const Addr end   = 0xc0000000;
+
+    AddrRangeMap<int> r;
+    for (int k = 0; k < N; k++)
+        r.insert(AddrRange(start, end, masks, k), k);
+    r.insert(RangeIn(0x1000, 0x1fff), N);
+
+    AddrDecoder<int> d;
+    d.build(r);
+
+    for (Addr a = start; a < start + 0x10000; a += 0x40) {
+        auto i = r.contains(RangeSize(a, 0x40));
+        ASSERT_NE(i, r.end());
+        const int *v = d.contains(RangeSize(a, 0x40));
+        ASSERT_NE(v, nullptr);
+        EXPECT_EQ(*v, i->second);
+    }
+
+    // Crossing a stripe boundary is not contained in any stripe
+    EXPECT_EQ(d.contains(RangeSize(start + 0x20, 0x40)), nullptr);
+
+    ASSERT_NE(d.contains(Addr(0x1800)), nullptr);
+    EXPECT_EQ(*d.contains(Addr(0x1800)), N);
+}
+
+/**
+ * A partially populated interleaved group only decodes the stripes
+ * that are present.
+ */
+TEST(AddrDecoderTest, MissingStripe)
+{
+    const auto masks = std::vector<Addr>{0x40, 0x80};
+
+    AddrRangeMap<int> r;
+    r.insert(AddrRange(0, 0x1000, masks, 0), 0);
+    r.insert(AddrRange(0, 0x1000, masks, 2), 2);
+
+    AddrDecoder<int> d;
+    d.build(r);
+
+    ASSERT_NE(d.contains(Addr(0x00)), nullptr);
+    EXPECT_EQ(*d.contains(Addr(0x00)), 0);
+    EXPECT_EQ(d.contains(Addr(0x40)), nullptr);
+    ASSERT_NE(d.contains(Addr(0x80)), nullptr);
+    EXPECT_EQ(*d.contains(Addr(0x80)), 2);
+    EXPECT_EQ(d.contains(Addr(0xc0)), nullptr);
+}
+
+/** The decoder agrees with AddrRangeMap on random lookups. */
+TEST(AddrDecoderTest, MatchesAddrRangeMap)
+{
+    const auto masks = std::vector<Addr>{0x100 | 0x10000, 0x200, 0x400};
+
+    AddrRangeMap<int> r;
+    for (int k = 0; k < 8; k++)
+        r.insert(AddrRange(0x100000, 0x200000, masks, k), k);
+    r.insert(RangeSize(0x0, 0x1000), 8);
+    r.insert(RangeSize(0x300000, 0x1000), 9);
+
+    AddrDecoder<int> d;
+    d.build(r);
+
+    std::mt19937_64 rng(1234);
+    std::uniform_int_distribution<Addr> dist(0, 0x310000);
+    for (int n = 0; n < 10000; n++) {
+        const Addr a = dist(rng) & ~Addr(0x3f);
+        const AddrRange pkt = RangeSize(a, 0x40);
+        auto i = r.contains(pkt);
+        const int *v = d.contains(pkt);
+        if (i == r.end()) {
+            EXPECT_EQ(v, nullptr);
+        } else {
+            ASSERT_NE(v, nullptr);
+            EXPECT_EQ(*v, i->second);
+        }
+    }
+}
@@ -315,6 +315,25 @@ class AddrRange
      */
     uint32_t stripes() const { return 1ULL << masks.size(); }
 
+    /**
+     * Get the interleaving masks of the range, empty if the range is not
+     * interleaved.
+     *
+     * @return The masks selecting the bits of each interleaving bit
+     *
+     * @ingroup api_addr_range
+     */
+    const std::vector<Addr> &intlvMasks() const { return masks; }
+
+    /**
+     * Get the stripe of the interleaving this range corresponds to.
+     *
+     * @return The value the interleaving bits of an address must match
+     *
+     * @ingroup api_addr_range
+     */
+    uint8_t intlvMatchValue() const { return intlvMatch; }
+
     /**
      * Get the size of the address range. For a case where
      * interleaving is used we make the simplifying assumption that
@@ -0,0 +1,511 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/binary_logger.hh"
+
+#include <atomic>
+#include <cstring>
+#include <istream>
+#include <string_view>
+
+#include "base/logging.hh"
+#include "debug/FmtFlag.hh"
+#include "debug/FmtTicksOff.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+namespace
+{
+
+/** Identifies a binary debug trace */
+constexpr char traceMagic[8] = {'g', 'e', 'm', '5', 'd', 'b', 'g', '\0'};
+constexpr uint32_t traceVersion = 1;
+/** Detects traces decoded on a host with a different byte order */
+constexpr uint32_t byteOrderMark = 0x01020304;
+
+/** Number of full buffers that can wait for the writer thread */
+constexpr size_t maxPendingChunks = 8;
+
+/** Length recorded for a C string that is a null pointer */
+constexpr uint32_t nullString = 0xffffffff;
+
+enum RecordKind : uint8_t
+{
+    /** Adds a string to the string table of the stream */
+    DefineString,
+    /** A message recorded with its format and arguments */
+    DeferredMessage,
+    /** A message recorded as text */
+    FormattedMessage,
+    /** Text written to the ostream of the logger */
+    RawText,
+};
+
+/** Bits recording the state of the format flags for a message */
+enum FormatBits : uint8_t
+{
+    TicksOff = 1 << 0,
+    ShowFlag = 1 << 1,
+};
+
+uint8_t
+formatBits()
+{
+    return (debug::FmtTicksOff ? TicksOff : 0) |
+        (debug::FmtFlag ? ShowFlag : 0);
+}
+
+template <typename T>
+void
+put(std::vector<uint8_t> &buf, const T &value)
+{
+    size_t size = buf.size();
+    buf.resize(size + sizeof(T));
+    std::memcpy(&buf[size], &value, sizeof(T));
+}
+
+void
+putBytes(std::vector<uint8_t> &buf, const char *data, uint32_t length)
+{
+    put(buf, length);
+    buf.insert(buf.end(), data, data + length);
+}
+
+/** Output the text of a message the same way OstreamLogger does. */
+void
+printMessage(std::ostream &out, uint8_t bits, Tick when,
+             const std::string &name, const std::string &flag,
+             const std::string &message)
+{
+    if (!(bits & TicksOff) && (when != MaxTick))
+        ccprintf(out, "%7d: ", when);
+
+    if ((bits & ShowFlag) && !flag.empty())
+        out << flag << ": ";
+
+    if (!name.empty())
+        out << name << ": ";
+
+    out << message;
+}
+
+std::atomic<uint64_t> nextLoggerSerial(1);
+
+} // anonymous namespace
+
+struct BinaryLogger::Stream
+{
+    Stream(uint32_t id, size_t buffer_size) : id(id)
+    {
+        buffer.reserve(buffer_size);
+    }
+
+    /**
+     * Get the identifier of a string, adding it to the string table if
+     * needed. The strings are looked up by their contents, since names
+     * and other non-literal strings live at a different address on every
+     * call.
+     */
+    uint32_t
+    intern(const char *str, size_t length)
+    {
+        auto it = ids.find(std::string_view(str, length));
+        if (it != ids.end())
+            return it->second;
+
+        uint32_t id = strings.size();
+        strings.emplace_back(str, length);
+        ids.emplace(strings.back(), id);
+        put(buffer, DefineString);
+        putBytes(buffer, str, length);
+        return id;
+    }
+
+    /** Protects the buffer against flushes from other threads */
+    std::mutex mutex;
+    const uint32_t id;
+    std::vector<uint8_t> buffer;
+    /** Interned strings, which never move so that ids can refer to them */
+    std::deque<std::string> strings;
+    std::unordered_map<std::string_view, uint32_t> ids;
+};
+
+int
+BinaryLogger::RawBuf::sync()
+{
+    if (pptr() != pbase()) {
+        logger.logRaw(str());
+        str(std::string());
+    }
+    return 0;
+}
+
+BinaryLogger::BinaryLogger(std::ostream &stream, size_t buffer_size)
+    : out(stream), bufferSize(buffer_size), serial(nextLoggerSerial++),
+      rawBuf(*this), rawStream(&rawBuf), pending(0), stopping(false)
+{
+    deferFormatting = true;
+
+    out.write(traceMagic, sizeof(traceMagic));
+    out.write((const char *)&traceVersion, sizeof(traceVersion));
+    out.write((const char *)&byteOrderMark, sizeof(byteOrderMark));
+
+    writer = std::thread([this]() { writerLoop(); });
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCond.notify_one();
+    writer.join();
+}
+
+BinaryLogger::Stream &
+BinaryLogger::threadStream()
+{
+    // The serials are never reused, so the streams of loggers that have
+    // been destroyed are never looked up again.
+    thread_local std::unordered_map<uint64_t, Stream *> thread_streams;
+    thread_local uint64_t cached_serial = 0;
+    thread_local Stream *cached_stream = nullptr;
+
+    if (cached_serial != serial) {
+        Stream *&stream = thread_streams[serial];
+        if (!stream) {
+            std::lock_guard<std::mutex> lock(streamsMutex);
+            streams.emplace_back(new Stream(streams.size(), bufferSize));
+            stream = streams.back().get();
+        }
+        cached_stream = stream;
+        cached_serial = serial;
+    }
+    return *cached_stream;
+}
+
+void
+BinaryLogger::flushRaw()
+{
+    if (!rawBuf.empty())
+        rawStream.flush();
+}
+
+void
+BinaryLogger::logRaw(const std::string &text)
+{
+    Stream &stream = threadStream();
+    std::lock_guard<std::mutex> lock(stream.mutex);
+    put(stream.buffer, RawText);
+    putBytes(stream.buffer, text.data(), text.size());
+    if (stream.buffer.size() >= bufferSize)
+        submit(stream);
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    if (!isEnabled(name))
+        return;
+
+    flushRaw();
+
+    Stream &stream = threadStream();
+    std::lock_guard<std::mutex> lock(stream.mutex);
+    uint32_t name_id = stream.intern(name.data(), name.size());
+    uint32_t flag_id = stream.intern(flag.data(), flag.size());
+
+    std::vector<uint8_t> &buf = stream.buffer;
+    put(buf, FormattedMessage);
+    put(buf, formatBits());
+    put(buf, when);
+    put(buf, name_id);
+    put(buf, flag_id);
+    putBytes(buf, message.data(), message.size());
+    if (buf.size() >= bufferSize)
+        submit(stream);
+}
+
+void
+BinaryLogger::logDeferred(Tick when, const std::string &name,
+        const std::string &flag, const char *fmt,
+        const DeferredArg *args, size_t num_args)
+{
+    flushRaw();
+
+    Stream &stream = threadStream();
+    std::lock_guard<std::mutex> lock(stream.mutex);
+    uint32_t name_id = stream.intern(name.data(), name.size());
+    uint32_t flag_id = stream.intern(flag.data(), flag.size());
+    uint32_t fmt_id = stream.intern(fmt, std::strlen(fmt));
+
+    std::vector<uint8_t> &buf = stream.buffer;
+    put(buf, DeferredMessage);
+    put(buf, formatBits());
+    put(buf, when);
+    put(buf, name_id);
+    put(buf, flag_id);
+    put(buf, fmt_id);
+    put(buf, uint32_t(num_args));
+    for (size_t i = 0; i < num_args; i++) {
+        const DeferredArg &arg = args[i];
+        put(buf, arg.type);
+        if (arg.type == DeferredArg::CString && !arg.string) {
+            put(buf, nullString);
+        } else if (arg.type == DeferredArg::CString ||
+                   arg.type == DeferredArg::String) {
+            putBytes(buf, arg.string, arg.length);
+        } else if (arg.type == DeferredArg::Float ||
+                   arg.type == DeferredArg::Double) {
+            put(buf, arg.floating);
+        } else {
+            put(buf, arg.integer);
+        }
+    }
+    if (buf.size() >= bufferSize)
+        submit(stream);
+}
+
+void
+BinaryLogger::submit(Stream &stream)
+{
+    if (stream.buffer.empty())
+        return;
+
+    std::vector<uint8_t> fresh;
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        // Do not let the buffers pile up if the writer falls behind
+        writtenCond.wait(lock,
+            [this]() { return pending < maxPendingChunks; });
+        if (!freeBuffers.empty()) {
+            fresh = std::move(freeBuffers.back());
+            freeBuffers.pop_back();
+        }
+        queue.push_back(Chunk{stream.id, std::move(stream.buffer)});
+        pending++;
+    }
+    queueCond.notify_one();
+
+    fresh.clear();
+    fresh.reserve(bufferSize);
+    stream.buffer = std::move(fresh);
+}
+
+void
+BinaryLogger::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(queueMutex);
+    while (true) {
+        queueCond.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (queue.empty())
+            break;
+
+        Chunk chunk = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+
+        uint32_t size = chunk.data.size();
+        out.write((const char *)&chunk.stream, sizeof(chunk.stream));
+        out.write((const char *)&size, sizeof(size));
+        out.write((const char *)chunk.data.data(), size);
+
+        lock.lock();
+        freeBuffers.push_back(std::move(chunk.data));
+        pending--;
+        writtenCond.notify_all();
+    }
+}
+
+void
+BinaryLogger::flush()
+{
+    flushRaw();
+    {
+        std::lock_guard<std::mutex> lock(streamsMutex);
+        for (auto &stream : streams) {
+            std::lock_guard<std::mutex> stream_lock(stream->mutex);
+            submit(*stream);
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(queueMutex);
+    writtenCond.wait(lock, [this]() { return pending == 0; });
+    out.flush();
+}
+
+namespace
+{
+
+/** Reads the records of a chunk of a binary trace. */
+class ChunkReader
+{
+  public:
+    ChunkReader(const std::vector<uint8_t> &data) : data(data), pos(0) {}
+
+    bool done() const { return pos == data.size(); }
+
+    template <typename T>
+    T
+    get()
+    {
+        T value;
+        panic_if(pos + sizeof(T) > data.size(),
+                 "Truncated record in binary debug trace\n");
+        std::memcpy(&value, &data[pos], sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    std::string
+    getBytes(uint32_t length)
+    {
+        panic_if(pos + length > data.size(),
+                 "Truncated record in binary debug trace\n");
+        std::string str((const char *)&data[pos], length);
+        pos += length;
+        return str;
+    }
+
+    std::string getBytes() { return getBytes(get<uint32_t>()); }
+
+  private:
+    const std::vector<uint8_t> &data;
+    size_t pos;
+};
+
+} // anonymous namespace
+
+void
+decodeBinaryTrace(std::istream &in, std::ostream &out)
+{
+    char magic[sizeof(traceMagic)];
+    uint32_t version = 0;
+    uint32_t byte_order = 0;
+    in.read(magic, sizeof(magic));
+    in.read((char *)&version, sizeof(version));
+    in.read((char *)&byte_order, sizeof(byte_order));
+    fatal_if(!in || std::memcmp(magic, traceMagic, sizeof(magic)) != 0,
+             "Not a binary debug trace\n");
+    fatal_if(version != traceVersion,
+             "Unsupported binary debug trace version %d\n", version);
+    fatal_if(byte_order != byteOrderMark,
+             "The binary debug trace was recorded on a host with a "
+             "different byte order\n");
+
+    // String tables of the streams, indexed by stream and string id
+    std::unordered_map<uint32_t, std::vector<std::string>> strings;
+    std::vector<uint8_t> data;
+    std::vector<DeferredArg> args;
+    std::vector<std::string> arg_strings;
+
+    uint32_t stream_id;
+    while (in.read((char *)&stream_id, sizeof(stream_id))) {
+        uint32_t size;
+        in.read((char *)&size, sizeof(size));
+        data.resize(size);
+        in.read((char *)data.data(), size);
+        fatal_if(!in, "Truncated binary debug trace\n");
+
+        std::vector<std::string> &table = strings[stream_id];
+        auto lookup = [&table](uint32_t id) -> const std::string & {
+            panic_if(id >= table.size(),
+                     "Unknown string %d in binary debug trace\n", id);
+            return table[id];
+        };
+
+        ChunkReader reader(data);
+        while (!reader.done()) {
+            auto kind = reader.get<RecordKind>();
+            if (kind == DefineString) {
+                table.push_back(reader.getBytes());
+                continue;
+            } else if (kind == RawText) {
+                out << reader.getBytes();
+                continue;
+            }
+
+            auto bits = reader.get<uint8_t>();
+            auto when = reader.get<Tick>();
+            const std::string &name = lookup(reader.get<uint32_t>());
+            const std::string &flag = lookup(reader.get<uint32_t>());
+
+            if (kind == FormattedMessage) {
+                printMessage(out, bits, when, name, flag, reader.getBytes());
+                continue;
+            }
+            panic_if(kind != DeferredMessage,
+                     "Invalid record %d in binary debug trace\n", kind);
+
+            const std::string &fmt = lookup(reader.get<uint32_t>());
+            auto num_args = reader.get<uint32_t>();
+            args.resize(num_args);
+            // Reserve the strings up front so that they are not moved
+            // while the arguments point to them
+            arg_strings.clear();
+            arg_strings.reserve(num_args);
+            for (auto &arg : args) {
+                arg.type = reader.get<DeferredArg::Type>();
+                arg.length = 0;
+                if (arg.type == DeferredArg::CString ||
+                        arg.type == DeferredArg::String) {
+                    auto length = reader.get<uint32_t>();
+                    if (length == nullString) {
+                        arg.string = nullptr;
+                    } else {
+                        arg_strings.push_back(reader.getBytes(length));
+                        arg.string = arg_strings.back().c_str();
+                        arg.length = length;
+                    }
+                } else if (arg.type == DeferredArg::Float ||
+                           arg.type == DeferredArg::Double) {
+                    arg.floating = reader.get<double>();
+                } else {
+                    panic_if(arg.type >= DeferredArg::NumTypes,
+                             "Invalid argument type %d in binary debug "
+                             "trace\n", arg.type);
+                    arg.integer = reader.get<uint64_t>();
+                }
+            }
+
+            std::ostringstream message;
+            formatDeferred(message, fmt.c_str(), args.data(), args.size());
+            printMessage(out, bits, when, name, flag, message.str());
+        }
+    }
+}
+
+} // namespace trace
+} // namespace gem5
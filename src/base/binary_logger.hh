@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_BINARY_LOGGER_HH__
+#define __BASE_BINARY_LOGGER_HH__
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "base/trace.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+/**
+ * Debug logger that records the messages in a compact binary format
+ * instead of formatting them. The tick, the name of the object, the flag
+ * and the format string of a message are recorded along with the raw
+ * values of its arguments, and the strings are only recorded the first
+ * time they are seen. The messages whose arguments cannot be captured
+ * (see DeferredArg) are formatted and recorded as text.
+ *
+ * Every thread records its messages into its own buffer, and the full
+ * buffers are written to the output stream by a background thread. The
+ * trace can be turned into the text that an OstreamLogger would have
+ * produced with decodeBinaryTrace(). The stack traces requested with the
+ * FmtStackTrace flag are not recorded.
+ */
+class BinaryLogger : public Logger
+{
+  public:
+    /**
+     * @param stream Stream the trace is written to
+     * @param buffer_size Size of the per-thread buffers, in bytes
+     */
+    BinaryLogger(std::ostream &stream, size_t buffer_size = 1 << 20);
+    ~BinaryLogger();
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    void logDeferred(Tick when, const std::string &name,
+            const std::string &flag, const char *fmt,
+            const DeferredArg *args, size_t num_args) override;
+
+    /**
+     * The text written to this stream is recorded verbatim when the
+     * stream is flushed, or before the next message is logged.
+     */
+    std::ostream &getOstream() override { return rawStream; }
+
+    /**
+     * Write the messages recorded so far to the output stream. This must
+     * not be called while other threads are logging messages.
+     */
+    void flush();
+
+  private:
+    /** Per-thread buffer of records and string table */
+    struct Stream;
+
+    /** Records the text written to the ostream of the logger */
+    class RawBuf : public std::stringbuf
+    {
+      public:
+        RawBuf(BinaryLogger &logger) : logger(logger) {}
+
+        bool empty() const { return pptr() == pbase(); }
+
+      protected:
+        int sync() override;
+
+      private:
+        BinaryLogger &logger;
+    };
+
+    /** A full buffer waiting to be written to the output stream */
+    struct Chunk
+    {
+        uint32_t stream;
+        std::vector<uint8_t> data;
+    };
+
+    /** @return The stream of the calling thread. */
+    Stream &threadStream();
+
+    /** Record the pending text of the ostream of the logger. */
+    void flushRaw();
+
+    void logRaw(const std::string &text);
+
+    /** Hand the buffer of a stream over to the writer thread. */
+    void submit(Stream &stream);
+
+    void writerLoop();
+
+    std::ostream &out;
+    const size_t bufferSize;
+
+    /** Unique identifier of this logger, to find the thread streams */
+    const uint64_t serial;
+
+    std::mutex streamsMutex;
+    std::vector<std::unique_ptr<Stream>> streams;
+
+    RawBuf rawBuf;
+    std::ostream rawStream;
+
+    std::mutex queueMutex;
+    /** Signals the writer thread that there are chunks to write */
+    std::condition_variable queueCond;
+    /** Signals the loggers that chunks have been written */
+    std::condition_variable writtenCond;
+    std::deque<Chunk> queue;
+    std::vector<std::vector<uint8_t>> freeBuffers;
+    /** Chunks submitted but not yet written */
+    size_t pending;
+    bool stopping;
+    std::thread writer;
+};
+
+/**
+ * Decode a trace recorded by a BinaryLogger into the text an
+ * OstreamLogger would have written for the same messages.
+ */
+void decodeBinaryTrace(std::istream &in, std::ostream &out);
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __BASE_BINARY_LOGGER_HH__
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/binary_logger.hh"
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/named.hh"
+#include "base/trace.hh"
+
+using namespace gem5;
+
+// Instantiate the mock class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+/** An argument that cannot be captured by the binary logger. */
+struct Opaque
+{
+    int value;
+};
+
+std::ostream &
+operator<<(std::ostream &os, const Opaque &opaque)
+{
+    return os << "<" << opaque.value << ">";
+}
+
+/** Log the same messages to a text logger and to a binary logger. */
+void
+logMessages(trace::Logger &logger)
+{
+    const std::string name("system.cpu");
+    const char *null_str = nullptr;
+    char buf[] = "buffer";
+
+    logger.dprintf_flag(100, name, "Flag", "Plain message\n");
+    logger.dprintf_flag(200, name, "Flag", "%d %u %#x %5.2f %c %s\n",
+                        -42, 42u, 0xbeefULL, 3.14159, 'z', true);
+    logger.dprintf_flag(300, name, "Other", "%s|%-8s|%8s|%s\n",
+                        std::string("str"), "cstr", buf, null_str);
+    logger.dprintf_flag(MaxTick, "", "Flag", "No tick nor name %lld %hhd\n",
+                        (long long)-1, (signed char)-3);
+    logger.dprintf_flag(400, name, "Flag", "Opaque %s %d\n",
+                        Opaque{7}, 8);
+    logger.getOstream() << "Raw output\n";
+    logger.getOstream().flush();
+    logger.dprintf(500, name, "Width %*d and float %f\n", 6, 12, 2.5f);
+    uint8_t data[20];
+    for (int i = 0; i < sizeof(data); i++)
+        data[i] = 'a' + i;
+    logger.dump(600, name, data, sizeof(data), "Dump");
+}
+
+/** @return The text a binary trace decodes to. */
+std::string
+decode(const std::string &trace)
+{
+    std::istringstream in(trace);
+    std::ostringstream out;
+    trace::decodeBinaryTrace(in, out);
+    return out.str();
+}
+
+} // anonymous namespace
+
+/** Test that a binary trace decodes to the same text as a text logger's. */
+TEST(BinaryLoggerTest, DecodesToText)
+{
+    std::stringstream text;
+    trace::OstreamLogger text_logger(text);
+    logMessages(text_logger);
+
+    std::stringstream binary;
+    {
+        trace::BinaryLogger binary_logger(binary);
+        logMessages(binary_logger);
+    }
+
+    ASSERT_EQ(decode(binary.str()), text.str());
+}
+
+/** Test that messages are kept across small buffers and repeated strings. */
+TEST(BinaryLoggerTest, SmallBuffers)
+{
+    std::stringstream text;
+    trace::OstreamLogger text_logger(text);
+    std::stringstream binary;
+    {
+        trace::BinaryLogger binary_logger(binary, 64);
+        for (int i = 0; i < 1000; i++) {
+            text_logger.dprintf_flag(i, "obj", "Flag", "Message %d\n", i);
+            binary_logger.dprintf_flag(i, "obj", "Flag", "Message %d\n", i);
+        }
+    }
+
+    ASSERT_EQ(decode(binary.str()), text.str());
+}
+
+/** Test that a format flag in effect when logging is kept in the trace. */
+TEST(BinaryLoggerTest, FormatFlags)
+{
+    std::stringstream text;
+    trace::OstreamLogger text_logger(text);
+    std::stringstream binary;
+    trace::BinaryLogger binary_logger(binary);
+
+    trace::enable();
+    EXPECT_TRUE(debug::changeFlag("FmtFlag", true));
+    text_logger.dprintf_flag(100, "Foo", "Bar", "Test %d\n", 1);
+    binary_logger.dprintf_flag(100, "Foo", "Bar", "Test %d\n", 1);
+    debug::changeFlag("FmtFlag", false);
+    trace::disable();
+
+    text_logger.dprintf_flag(200, "Foo", "Bar", "Test %d\n", 2);
+    binary_logger.dprintf_flag(200, "Foo", "Bar", "Test %d\n", 2);
+
+    binary_logger.flush();
+    ASSERT_EQ(decode(binary.str()), text.str());
+}
+
+/** Test that the messages of every thread are recorded. */
+TEST(BinaryLoggerTest, MultipleThreads)
+{
+    std::stringstream binary;
+    {
+        trace::BinaryLogger binary_logger(binary, 256);
+        auto log = [&binary_logger](int thread) {
+            for (int i = 0; i < 100; i++) {
+                binary_logger.dprintf_flag(i, "obj", "Flag", "%d:%d\n",
+                                           thread, i);
+            }
+        };
+        std::thread first(log, 0);
+        std::thread second(log, 1);
+        first.join();
+        second.join();
+    }
+
+    std::istringstream lines(decode(binary.str()));
+    std::string line;
+    int num_lines = 0;
+    while (std::getline(lines, line))
+        num_lines++;
+    ASSERT_EQ(num_lines, 200);
+}
+
+/** Test that ignored objects are not recorded. */
+TEST(BinaryLoggerTest, Ignore)
+{
+    std::stringstream binary;
+    {
+        trace::BinaryLogger binary_logger(binary);
+        ObjectMatch ignore_foo("Foo");
+        binary_logger.setIgnore(ignore_foo);
+        binary_logger.dprintf_flag(100, "Foo", "", "Ignored %d\n", 1);
+        binary_logger.dprintf_flag(100, "Bar", "", "Kept %d\n", 2);
+    }
+
+    ASSERT_EQ(decode(binary.str()), "    100: Bar: Kept 2\n");
+}
+
+/**
+ * Test that strings are interned by their contents, so that names that
+ * live at a different address for every message, as the ones returned by
+ * Named::name(), are only recorded once.
+ */
+TEST(BinaryLoggerTest, NonLiteralNames)
+{
+    // Long enough to be allocated separately for every copy
+    const std::string name("system.cpu.mmu.dtb.walker.port.peer");
+    std::vector<std::string> copies(100, name);
+
+    std::stringstream text;
+    trace::OstreamLogger text_logger(text);
+    std::stringstream same;
+    std::stringstream copied;
+    {
+        trace::BinaryLogger same_logger(same);
+        trace::BinaryLogger copied_logger(copied);
+        for (int i = 0; i < 1000; i++) {
+            const std::string &copy = copies[i % copies.size()];
+            text_logger.dprintf_flag(i, copy, "Flag", "Message %d\n", i);
+            same_logger.dprintf_flag(i, name, "Flag", "Message %d\n", i);
+            copied_logger.dprintf_flag(i, copy, "Flag", "Message %d\n", i);
+        }
+    }
+
+    ASSERT_EQ(decode(copied.str()), text.str());
+    ASSERT_EQ(copied.str().size(), same.str().size());
+}
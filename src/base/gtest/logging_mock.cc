@@ -104,4 +104,11 @@ Logger::getHack() {
     return *hack_logger;
 }
 
+// The exit loggers above throw rather than exit, so there is nothing to
+// do before exiting.
+void
+Logger::addExitHook(std::function<void()> hook)
+{
+}
+
 } // namespace gem5
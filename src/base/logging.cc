@@ -41,6 +41,7 @@
 #include "base/logging.hh"
 
 #include <sstream>
+#include <vector>
 
 #include "base/hostinfo.hh"
 
@@ -49,6 +50,13 @@ namespace gem5
 
 namespace {
 
+std::vector<std::function<void()>> &
+exitHooks()
+{
+    static auto *hooks = new std::vector<std::function<void()>>();
+    return *hooks;
+}
+
 class ExitLogger : public Logger
 {
   public:
@@ -62,6 +70,18 @@ class ExitLogger : public Logger
         ccprintf(ss, "Memory Usage: %ld KBytes\n", memUsage());
         Logger::log(loc, s + ss.str());
     }
+
+    void
+    exit() override
+    {
+        // A hook that panics must not run the hooks again.
+        static bool exiting = false;
+        if (exiting)
+            return;
+        exiting = true;
+        for (auto &hook : exitHooks())
+            hook();
+    }
 };
 
 class FatalLogger : public ExitLogger
@@ -70,11 +90,22 @@ class FatalLogger : public ExitLogger
     using ExitLogger::ExitLogger;
 
   protected:
-    void exit() override { ::exit(1); }
+    void
+    exit() override
+    {
+        ExitLogger::exit();
+        ::exit(1);
+    }
 };
 
 } // anonymous namespace
 
+void
+Logger::addExitHook(std::function<void()> hook)
+{
+    exitHooks().push_back(std::move(hook));
+}
+
 // We intentionally put all the loggers on the heap to prevent them from being
 // destructed at the end of the program. This make them safe to be used inside
 // destructor of other global objects. Also, we make them function static
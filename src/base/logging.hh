@@ -42,6 +42,7 @@
 #define __BASE_LOGGING_HH__
 
 #include <cassert>
+#include <functional>
 #include <sstream>
 #include <utility>
 
@@ -123,6 +124,13 @@ class Logger
      */
     [[noreturn]] void exit_helper() { exit(); ::abort(); }
 
+    /**
+     * Add a function for the panic and fatal loggers to call before
+     * exiting, e.g., to write out output that is still buffered and
+     * would be lost otherwise.
+     */
+    static void addExitHook(std::function<void()> hook);
+
   protected:
     bool enabled;
 
@@ -506,6 +506,20 @@ TEST(LoggingDeathTest, PanicLoggerExitHelper)
     ASSERT_DEATH(Logger::getPanic().exit_helper(), "");
 }
 
+/** Test that the panic and fatal loggers run the exit hooks. */
+TEST(LoggingDeathTest, ExitHooks)
+{
+    auto hook = []() { std::cerr << "hook ran\n"; };
+    ASSERT_DEATH({
+            Logger::addExitHook(hook);
+            Logger::getPanic().exit_helper();
+        }, "hook ran\n");
+    ASSERT_DEATH({
+            Logger::addExitHook(hook);
+            Logger::getFatal().exit_helper();
+        }, "hook ran\n");
+}
+
 /** Test that exit_message prints a message and exits. */
 TEST(LoggingDeathTest, ExitMessage)
 {
@@ -2529,6 +2529,50 @@ class SparseHistogram : public SparseHistBase<SparseHistogram, SparseHistStor>
     }
 };
 
+/**
+ * A sparse histogram with logarithmic buckets, tracking wide ranges of
+ * values with a bounded relative error and memory footprint.
+ * @sa Stat, SparseHistBase, LogHistStor
+ */
+class LogHistogram : public SparseHistBase<LogHistogram, LogHistStor>
+{
+  public:
+    LogHistogram(Group *parent = nullptr)
+        : SparseHistBase<LogHistogram, LogHistStor>(parent, nullptr,
+            units::Unspecified::get(), nullptr)
+    {
+    }
+
+    LogHistogram(Group *parent, const char *name,
+                 const char *desc = nullptr)
+        : SparseHistBase<LogHistogram, LogHistStor>(parent, name,
+            units::Unspecified::get(), desc)
+    {
+    }
+
+    LogHistogram(Group *parent, const char *name, const units::Base *unit,
+                 const char *desc = nullptr)
+        : SparseHistBase<LogHistogram, LogHistStor>(parent, name, unit,
+                                                    desc)
+    {
+    }
+
+    /**
+     * Set the parameters of this histogram. @sa LogHistStor::Params
+     * @param precision Log2 of the number of buckets each power of two
+     *        is split into
+     * @return A reference to this histogram.
+     */
+    LogHistogram &
+    init(unsigned precision)
+    {
+        LogHistStor::Params *params = new LogHistStor::Params(precision);
+        this->setParams(params);
+        this->doInit();
+        return this->self();
+    }
+};
+
 class Temp;
 /**
  * A formula for statistics that is calculated when printed. A formula is
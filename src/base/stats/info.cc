@@ -76,6 +76,13 @@ Info::Info()
         debug::breakpoint();
 }
 
+Info::Info(const Info &other)
+    : name(other.name), unit(other.unit), desc(other.desc),
+      flags(other.flags), precision(other.precision), prereq(other.prereq),
+      id(other.id), storageParams()
+{
+}
+
 Info::~Info()
 {
 }
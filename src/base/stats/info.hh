@@ -103,6 +103,13 @@ class Info
   private:
     std::unique_ptr<const StorageParams> storageParams;
 
+  protected:
+    /**
+     * Copy the description of another stat, e.g., to keep a snapshot of
+     * it. The copy keeps the ID of the original and has no storage params.
+     */
+    Info(const Info &other);
+
   public:
     Info();
     virtual ~Info();
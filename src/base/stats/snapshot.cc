@@ -0,0 +1,629 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/snapshot.hh"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include "base/logging.hh"
+#include "base/stats/group.hh"
+#include "base/stats/info.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+namespace
+{
+
+/**
+ * Stand-in for a stat while a snapshot is replayed. It is described like
+ * the live stat, and holds the values the stat had in the snapshot. A
+ * single view of each kind is reused for all the stats of that kind, so
+ * replaying does not allocate once the views have grown to the largest
+ * stats.
+ */
+template <class Base>
+class View : public Base
+{
+  private:
+    bool _zero;
+
+  public:
+    View(const Base &live) : Base(live), _zero(false) {}
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return _zero; }
+    void visit(Output &visitor) override { visitor.visit(*this); }
+
+    void
+    describe(const Base &live, const Info *prereq, bool zero)
+    {
+        this->name = live.name;
+        this->unit = live.unit;
+        this->desc = live.desc;
+        this->flags = live.flags;
+        this->precision = live.precision;
+        this->id = live.id;
+        this->prereq = prereq;
+        _zero = zero;
+    }
+};
+
+/** Stand-in for a prerequisite, only telling if it was zero. */
+class PrereqView : public Info
+{
+  private:
+    bool _zero;
+
+  public:
+    PrereqView(const Info &live, bool zero) : Info(live), _zero(zero)
+    {
+        prereq = nullptr;
+    }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return _zero; }
+    void visit(Output &visitor) override {}
+};
+
+class ScalarView : public View<ScalarInfo>
+{
+  public:
+    Counter _value;
+    Result _result;
+    Result _total;
+
+    using View<ScalarInfo>::View;
+
+    Counter value() const override { return _value; }
+    Result result() const override { return _result; }
+    Result total() const override { return _total; }
+};
+
+template <class Base>
+class VectorView : public View<Base>
+{
+  public:
+    VCounter _value;
+    VResult _result;
+    Result _total;
+
+    using View<Base>::View;
+
+    void
+    describe(const Base &live, const Info *prereq, bool zero)
+    {
+        View<Base>::describe(live, prereq, zero);
+        this->subnames = live.subnames;
+        this->subdescs = live.subdescs;
+    }
+
+    size_type size() const override { return _result.size(); }
+    const VCounter &value() const override { return _value; }
+    const VResult &result() const override { return _result; }
+    Result total() const override { return _total; }
+};
+
+class FormulaView : public VectorView<FormulaInfo>
+{
+  private:
+    const FormulaInfo *live;
+
+  public:
+    FormulaView(const FormulaInfo &_live)
+        : VectorView<FormulaInfo>(_live), live(&_live)
+    {}
+
+    void
+    describe(const FormulaInfo &_live, const Info *prereq, bool zero)
+    {
+        VectorView<FormulaInfo>::describe(_live, prereq, zero);
+        live = &_live;
+    }
+
+    std::string str() const override { return live->str(); }
+};
+
+class VectorDistView : public View<VectorDistInfo>
+{
+  public:
+    using View<VectorDistInfo>::View;
+
+    void
+    describe(const VectorDistInfo &live, const Info *prereq, bool zero)
+    {
+        View<VectorDistInfo>::describe(live, prereq, zero);
+        subnames = live.subnames;
+        subdescs = live.subdescs;
+    }
+
+    size_type size() const override { return data.size(); }
+};
+
+class Vector2dView : public View<Vector2dInfo>
+{
+  public:
+    Result _total;
+
+    using View<Vector2dInfo>::View;
+
+    void
+    describe(const Vector2dInfo &live, const Info *prereq, bool zero)
+    {
+        View<Vector2dInfo>::describe(live, prereq, zero);
+        subnames = live.subnames;
+        subdescs = live.subdescs;
+        y_subnames = live.y_subnames;
+        x = live.x;
+        y = live.y;
+    }
+
+    Result total() const override { return _total; }
+};
+
+/** The views used to replay a snapshot, made when first needed. */
+struct Views
+{
+    std::optional<ScalarView> scalar;
+    std::optional<VectorView<VectorInfo>> vector;
+    std::optional<View<DistInfo>> dist;
+    std::optional<VectorDistView> vectorDist;
+    std::optional<Vector2dView> vector2d;
+    std::optional<FormulaView> formula;
+    std::optional<View<SparseHistInfo>> sparseHist;
+    std::optional<PrereqView> zeroPrereq;
+    std::optional<PrereqView> nonZeroPrereq;
+
+    template <class V, class Live>
+    static V &
+    get(std::optional<V> &view, const Live &live)
+    {
+        if (!view)
+            view.emplace(live);
+        return *view;
+    }
+
+    /** Get the view of a kind of stat, described like a live one. */
+    template <class V, class Live>
+    V &
+    describe(std::optional<V> &view, const Info &live, bool zero,
+             bool prereq_zero)
+    {
+        const Live &info = static_cast<const Live &>(live);
+        V &v = get(view, info);
+        const Info *prereq = nullptr;
+        if (live.prereq) {
+            auto &p = prereq_zero ? zeroPrereq : nonZeroPrereq;
+            if (!p)
+                p.emplace(*live.prereq, prereq_zero);
+            prereq = &*p;
+        }
+        v.describe(info, prereq, zero);
+        return v;
+    }
+};
+
+/**
+ * Check that a live stat still describes all the values a snapshot has
+ * of it. The descriptions are read while the snapshot is replayed in
+ * the background, so they must not change once the stats are enabled.
+ */
+void
+checkDescription(const Info &info, bool describes_values)
+{
+    panic_if(!describes_values, "Description of stat %s changed after it "
+             "was enabled, while it was being dumped\n", info.name);
+}
+
+/**
+ * Visit all the stats in a group and its subgroups, in the same order
+ * as the dumps done from Python.
+ */
+void
+visitGroup(const Group &group, Output &output)
+{
+    for (auto *info : group.getStats())
+        info->visit(output);
+
+    for (const auto &g : group.getStatGroups()) {
+        output.beginGroup(g.first.c_str());
+        visitGroup(*g.second, output);
+        output.endGroup();
+    }
+}
+
+void
+prepareGroup(const Group &group)
+{
+    for (auto *info : group.getStats())
+        info->prepare();
+
+    for (const auto &g : group.getStatGroups())
+        prepareGroup(*g.second);
+}
+
+/**
+ * Background thread writing the snapshots taken by dumpAsync(). The
+ * number of snapshots waiting to be written is bounded, so dumping
+ * blocks if the writer falls too far behind the simulation.
+ */
+class SnapshotWriter
+{
+  public:
+    SnapshotWriter() : busy(false), stopping(false)
+    {
+        // Panics and fatal errors exit without running the Python exit
+        // handlers, so write out the pending snapshots from there too
+        Logger::addExitHook([this] {
+            if (!destroyed)
+                drain();
+        });
+    }
+
+    ~SnapshotWriter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cond.notify_all();
+        if (thread.joinable())
+            thread.join();
+        destroyed = true;
+    }
+
+    void
+    write(std::unique_ptr<Snapshot> snapshot,
+          const std::vector<Output *> &outputs)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!thread.joinable())
+            thread = std::thread(&SnapshotWriter::run, this);
+
+        cond.wait(lock, [this]{ return pending.size() < maxPending; });
+        pending.emplace_back(std::move(snapshot), outputs);
+        cond.notify_all();
+    }
+
+    void
+    drain()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        // The writer can't wait for itself if it panics while writing
+        if (std::this_thread::get_id() == thread.get_id())
+            return;
+        cond.wait(lock, [this]{ return pending.empty() && !busy; });
+    }
+
+  private:
+    void
+    run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            cond.wait(lock, [this]{ return stopping || !pending.empty(); });
+            if (pending.empty())
+                return;
+
+            Job job = std::move(pending.front());
+            pending.pop_front();
+            busy = true;
+            cond.notify_all();
+
+            lock.unlock();
+            for (auto *output : job.second) {
+                if (!output->valid())
+                    continue;
+                output->begin();
+                job.first->replay(*output);
+                output->end();
+            }
+            job.first.reset();
+            lock.lock();
+
+            busy = false;
+            cond.notify_all();
+        }
+    }
+
+    typedef std::pair<std::unique_ptr<Snapshot>,
+                      std::vector<Output *>> Job;
+
+    /// Number of snapshots that can be waiting to be written
+    static const size_t maxPending = 2;
+
+    /// Protects the queue of snapshots and the flags below
+    std::mutex mutex;
+
+    /// Signals changes in the queue of snapshots and the flags below
+    std::condition_variable cond;
+
+    /// Snapshots waiting to be written, in order
+    std::deque<Job> pending;
+
+    /// Whether a snapshot is being written
+    bool busy;
+
+    /// Whether the thread must stop once the queue is empty
+    bool stopping;
+
+    std::thread thread;
+
+    /// Whether the writer is gone, if exiting after static destruction
+    static inline bool destroyed = false;
+};
+
+SnapshotWriter &
+snapshotWriter()
+{
+    static SnapshotWriter writer;
+    return writer;
+}
+
+} // anonymous namespace
+
+Snapshot::Snapshot()
+    : numStats(0)
+{
+}
+
+Snapshot::Snapshot(const Group &root, const std::vector<Info *> &legacy)
+    : numStats(0)
+{
+    visitGroup(root, *this);
+    for (auto *info : legacy)
+        info->visit(*this);
+}
+
+Snapshot::~Snapshot()
+{
+}
+
+void
+Snapshot::beginGroup(const char *name)
+{
+    entries.push_back(
+        {Kind::BeginGroup, false, false, nullptr, name, 0, 0, 0, 0, 0, 0});
+}
+
+void
+Snapshot::endGroup()
+{
+    entries.push_back(
+        {Kind::EndGroup, false, false, nullptr, nullptr, 0, 0, 0, 0, 0, 0});
+}
+
+Snapshot::Entry &
+Snapshot::add(Kind kind, const Info &info)
+{
+    numStats++;
+    entries.push_back({kind, info.zero(), info.prereq && info.prereq->zero(),
+                       &info, nullptr, 0, 0, 0, counters.size(),
+                       results.size(), dists.size()});
+    return entries.back();
+}
+
+void
+Snapshot::addCounters(const VCounter &value)
+{
+    counters.insert(counters.end(), value.begin(), value.end());
+    entries.back().numCounters += value.size();
+}
+
+void
+Snapshot::addResults(const VResult &result)
+{
+    results.insert(results.end(), result.begin(), result.end());
+    entries.back().numResults += result.size();
+}
+
+void
+Snapshot::visit(const ScalarInfo &info)
+{
+    add(Kind::Scalar, info);
+    addCounters({info.value()});
+    addResults({info.result(), info.total()});
+}
+
+void
+Snapshot::visit(const VectorInfo &info)
+{
+    add(Kind::Vector, info);
+    addCounters(info.value());
+    addResults(info.result());
+    addResults({info.total()});
+}
+
+void
+Snapshot::visit(const DistInfo &info)
+{
+    add(Kind::Dist, info).numDists = 1;
+    dists.push_back(info.data);
+}
+
+void
+Snapshot::visit(const VectorDistInfo &info)
+{
+    add(Kind::VectorDist, info).numDists = info.data.size();
+    dists.insert(dists.end(), info.data.begin(), info.data.end());
+}
+
+void
+Snapshot::visit(const Vector2dInfo &info)
+{
+    add(Kind::Vector2d, info);
+    addCounters(info.cvec);
+    addResults({info.total()});
+}
+
+void
+Snapshot::visit(const FormulaInfo &info)
+{
+    add(Kind::Formula, info);
+    addCounters(info.value());
+    addResults(info.result());
+    addResults({info.total()});
+}
+
+void
+Snapshot::visit(const SparseHistInfo &info)
+{
+    Entry &entry = add(Kind::SparseHist, info);
+    entry.numDists = 1;
+    entry.dists = sparseHists.size();
+    sparseHists.push_back(info.data);
+}
+
+void
+Snapshot::replay(Output &output) const
+{
+    Views views;
+
+    auto counters_of = [this](const Entry &e, VCounter &v) {
+        auto first = counters.begin() + e.counters;
+        v.assign(first, first + e.numCounters);
+    };
+    // The last result of vector-like stats is their total.
+    auto results_of = [this](const Entry &e, VResult &v, Result &total) {
+        auto first = results.begin() + e.results;
+        v.assign(first, first + e.numResults - 1);
+        total = first[e.numResults - 1];
+    };
+
+    for (const auto &e : entries) {
+        switch (e.kind) {
+          case Kind::BeginGroup:
+            output.beginGroup(e.group);
+            break;
+          case Kind::EndGroup:
+            output.endGroup();
+            break;
+          case Kind::Scalar: {
+              auto &v = views.describe<ScalarView, ScalarInfo>(
+                  views.scalar, *e.info, e.zero, e.prereqZero);
+              v._value = counters[e.counters];
+              v._result = results[e.results];
+              v._total = results[e.results + 1];
+              output.visit(v);
+              break;
+          }
+          case Kind::Vector: {
+              auto &v = views.describe<VectorView<VectorInfo>, VectorInfo>(
+                  views.vector, *e.info, e.zero, e.prereqZero);
+              counters_of(e, v._value);
+              results_of(e, v._result, v._total);
+              checkDescription(v, v.subnames.size() >= v._result.size() &&
+                               v.subdescs.size() >= v._result.size());
+              output.visit(v);
+              break;
+          }
+          case Kind::Dist: {
+              auto &v = views.describe<View<DistInfo>, DistInfo>(
+                  views.dist, *e.info, e.zero, e.prereqZero);
+              v.data = dists[e.dists];
+              output.visit(v);
+              break;
+          }
+          case Kind::VectorDist: {
+              auto &v = views.describe<VectorDistView, VectorDistInfo>(
+                  views.vectorDist, *e.info, e.zero, e.prereqZero);
+              auto first = dists.begin() + e.dists;
+              v.data.assign(first, first + e.numDists);
+              checkDescription(v, v.subnames.size() >= v.data.size() &&
+                               v.subdescs.size() >= v.data.size());
+              output.visit(v);
+              break;
+          }
+          case Kind::Vector2d: {
+              auto &v = views.describe<Vector2dView, Vector2dInfo>(
+                  views.vector2d, *e.info, e.zero, e.prereqZero);
+              counters_of(e, v.cvec);
+              v._total = results[e.results];
+              checkDescription(v, v.cvec.size() == v.x * v.y &&
+                               v.subnames.size() >= v.x &&
+                               v.subdescs.size() >= v.x &&
+                               v.y_subnames.size() >= v.y);
+              output.visit(v);
+              break;
+          }
+          case Kind::Formula: {
+              auto &v = views.describe<FormulaView, FormulaInfo>(
+                  views.formula, *e.info, e.zero, e.prereqZero);
+              counters_of(e, v._value);
+              results_of(e, v._result, v._total);
+              output.visit(v);
+              break;
+          }
+          case Kind::SparseHist: {
+              auto &v = views.describe<View<SparseHistInfo>, SparseHistInfo>(
+                  views.sparseHist, *e.info, e.zero, e.prereqZero);
+              v.data = sparseHists[e.dists];
+              output.visit(v);
+              break;
+          }
+        }
+    }
+}
+
+void
+prepareStats(Group &root, const std::vector<Info *> &legacy)
+{
+    for (auto *info : legacy)
+        info->prepare();
+
+    prepareGroup(root);
+}
+
+void
+dumpAsync(const Group &root, const std::vector<Info *> &legacy,
+          const std::vector<Output *> &outputs)
+{
+    snapshotWriter().write(std::make_unique<Snapshot>(root, legacy),
+                           outputs);
+}
+
+void
+drainDumps()
+{
+    snapshotWriter().drain();
+}
+
+} // namespace statistics
+} // namespace gem5
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_SNAPSHOT_HH__
+#define __BASE_STATS_SNAPSHOT_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+class Group;
+class Info;
+
+/**
+ * A Snapshot is an output that keeps the values of the stats it visits
+ * as they were at the time of the visit. It can then be replayed into
+ * other outputs at any later point, e.g., to format and write the stats
+ * while the simulation carries on. Only the values are copied: when
+ * replayed, the stats are described (name, flags, subnames...) by the
+ * live stats, which must outlive the snapshot, and the values of the
+ * live stats are never read again.
+ */
+class Snapshot : public Output
+{
+  public:
+    Snapshot();
+    ~Snapshot();
+
+    /**
+     * Take a snapshot of all the stats in a hierarchy, visiting them
+     * in the same order as a regular dump.
+     *
+     * @param root Group at the top of the hierarchy
+     * @param legacy Stats that do not belong to any group, visited
+     *        after the hierarchy
+     */
+    Snapshot(const Group &root, const std::vector<Info *> &legacy);
+
+    void begin() override {}
+    void end() override {}
+    bool valid() const override { return true; }
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+    /**
+     * Visit the stats in the snapshot in the order in which they were
+     * taken. The caller is responsible for beginning and ending the
+     * output.
+     *
+     * @param output Output to visit the stats with
+     */
+    void replay(Output &output) const;
+
+    /** Number of stats in the snapshot. */
+    size_t size() const { return numStats; }
+
+  private:
+    enum class Kind : uint8_t
+    {
+        Scalar,
+        Vector,
+        Dist,
+        VectorDist,
+        Vector2d,
+        Formula,
+        SparseHist,
+        BeginGroup,
+        EndGroup
+    };
+
+    /**
+     * A visited stat, or the beginning or the end of a group. The values
+     * of a stat are kept in the arrays below, from the given positions.
+     */
+    struct Entry
+    {
+        Kind kind;
+        /** Whether the stat was zero */
+        bool zero;
+        /** Whether the prerequisite of the stat, if any, was zero */
+        bool prereqZero;
+        /** Live stat, nullptr for group boundaries */
+        const Info *info;
+        /** Name of the group beginning, owned by the parent group */
+        const char *group;
+        /** Number of counters and of results of the stat */
+        size_type numCounters;
+        size_type numResults;
+        /** Number of distributions of the stat */
+        size_type numDists;
+        /** Position of the first value in each of the arrays */
+        size_t counters;
+        size_t results;
+        size_t dists;
+    };
+
+    /** Start the entry of a stat, with its values yet to be added. */
+    Entry &add(Kind kind, const Info &info);
+
+    /** Add values to the entry of the last stat. */
+    void addCounters(const VCounter &value);
+    void addResults(const VResult &result);
+
+    std::vector<Entry> entries;
+
+    std::vector<Counter> counters;
+    std::vector<Result> results;
+    /** Distributions; those of sparse histograms are kept apart */
+    std::vector<DistData> dists;
+    std::vector<SparseHistData> sparseHists;
+
+    size_t numStats;
+};
+
+/**
+ * Prepare all the stats in a hierarchy for dumping.
+ *
+ * @param root Group at the top of the hierarchy
+ * @param legacy Stats that do not belong to any group
+ */
+void prepareStats(Group &root, const std::vector<Info *> &legacy);
+
+/**
+ * Take a snapshot of all the stats in a hierarchy, and write it to the
+ * given outputs from a background thread. Snapshots are written in the
+ * order in which they are taken, and each output is only ever used by
+ * that thread until drainDumps() is called. The stats must have been
+ * prepared beforehand.
+ *
+ * The thread reads the descriptions of the live stats (name, flags,
+ * subnames...) while the simulation carries on, so these must not
+ * change once the stats are enabled. A vector stat described by fewer
+ * subnames than it has values when it is written causes a panic.
+ * Pending snapshots are also written out when gem5 panics or exits
+ * with a fatal error.
+ *
+ * @param root Group at the top of the hierarchy
+ * @param legacy Stats that do not belong to any group
+ * @param outputs Outputs to write the snapshot to
+ */
+void dumpAsync(const Group &root, const std::vector<Info *> &legacy,
+               const std::vector<Output *> &outputs);
+
+/**
+ * Wait until all the snapshots handed to dumpAsync() have been
+ * written. This must be done before using any of their outputs
+ * directly.
+ */
+void drainDumps();
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_SNAPSHOT_HH__
@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "base/gtest/logging.hh"
+#include "base/stats/group.hh"
+#include "base/stats/info.hh"
+#include "base/stats/snapshot.hh"
+
+using namespace gem5;
+
+/** A scalar stat whose value can be set directly. */
+class TestScalar : public statistics::ScalarInfo
+{
+  public:
+    statistics::Counter counter = 0;
+    bool prepared = false;
+
+    TestScalar(const std::string &_name) { name = _name; }
+
+    bool check() const override { return true; }
+    void prepare() override { prepared = true; }
+    void reset() override { counter = 0; }
+    bool zero() const override { return counter == 0; }
+    void visit(statistics::Output &visitor) override
+    {
+        visitor.visit(*this);
+    }
+
+    statistics::Counter value() const override { return counter; }
+    statistics::Result result() const override { return counter; }
+    statistics::Result total() const override { return counter; }
+};
+
+/** A vector stat whose values can be set directly. */
+class TestVector : public statistics::VectorInfo
+{
+  public:
+    statistics::VCounter counters;
+    mutable statistics::VResult results;
+
+    TestVector(const std::string &_name, size_t size) : counters(size)
+    {
+        name = _name;
+        subnames.resize(size);
+        subdescs.resize(size);
+    }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return total() == 0; }
+    void visit(statistics::Output &visitor) override
+    {
+        visitor.visit(*this);
+    }
+
+    statistics::size_type size() const override { return counters.size(); }
+    const statistics::VCounter &value() const override { return counters; }
+
+    const statistics::VResult &
+    result() const override
+    {
+        results.assign(counters.begin(), counters.end());
+        return results;
+    }
+
+    statistics::Result
+    total() const override
+    {
+        statistics::Result sum = 0;
+        for (auto c : counters)
+            sum += c;
+        return sum;
+    }
+};
+
+/** A distribution, whose data is filled when prepared. */
+class TestDist : public statistics::DistInfo
+{
+  public:
+    statistics::Counter samples = 0;
+
+    TestDist(const std::string &_name) { name = _name; }
+
+    bool check() const override { return true; }
+    void prepare() override { data.samples = samples; }
+    void reset() override { samples = 0; }
+    bool zero() const override { return samples == 0; }
+    void visit(statistics::Output &visitor) override
+    {
+        visitor.visit(*this);
+    }
+};
+
+/** An output that records what it is asked to do, one line each. */
+class TestOutput : public statistics::Output
+{
+  public:
+    std::vector<std::string> lines;
+
+    void begin() override { lines.push_back("begin"); }
+    void end() override { lines.push_back("end"); }
+    bool valid() const override { return true; }
+
+    void
+    beginGroup(const char *name) override
+    {
+        lines.push_back(std::string("group ") + name);
+    }
+
+    void endGroup() override { lines.push_back("endgroup"); }
+
+    void
+    visit(const statistics::ScalarInfo &info) override
+    {
+        std::string line = info.name + "=" +
+            std::to_string((int)info.value());
+        if (info.prereq)
+            line += info.prereq->zero() ? " (prereq zero)" : " (prereq)";
+        lines.push_back(line);
+    }
+
+    void
+    visit(const statistics::VectorInfo &info) override
+    {
+        std::string line = info.name + "=";
+        for (statistics::size_type i = 0; i < info.size(); i++) {
+            if (!info.subnames[i].empty())
+                line += info.subnames[i] + ":";
+            line += std::to_string((int)info.result()[i]) + ",";
+        }
+        line += "total " + std::to_string((int)info.total());
+        lines.push_back(line);
+    }
+
+    void
+    visit(const statistics::DistInfo &info) override
+    {
+        lines.push_back(info.name + " samples=" +
+                        std::to_string((int)info.data.samples) +
+                        (info.zero() ? " (zero)" : ""));
+    }
+
+    void visit(const statistics::VectorDistInfo &info) override {}
+    void visit(const statistics::Vector2dInfo &info) override {}
+    void visit(const statistics::FormulaInfo &info) override {}
+    void visit(const statistics::SparseHistInfo &info) override {}
+};
+
+/** Test that a snapshot keeps the values the stats had when taken. */
+TEST(StatsSnapshotTest, KeepsValues)
+{
+    statistics::Group root(nullptr);
+    TestScalar a("a");
+    root.addStat(&a);
+
+    a.counter = 3;
+    statistics::Snapshot snapshot(root, {});
+    a.counter = 5;
+
+    TestOutput output;
+    snapshot.replay(output);
+    ASSERT_EQ(snapshot.size(), 1);
+    ASSERT_EQ(output.lines, std::vector<std::string>({"a=3"}));
+}
+
+/**
+ * Test that the stats are replayed in the same order as a regular dump,
+ * with the legacy stats last.
+ */
+TEST(StatsSnapshotTest, ReplayOrder)
+{
+    statistics::Group root(nullptr);
+    statistics::Group node1(nullptr);
+    statistics::Group node2(nullptr);
+    root.addStatGroup("node1", &node1);
+    node1.addStatGroup("node2", &node2);
+
+    TestScalar a("a"), b("b"), c("c"), legacy("legacy");
+    root.addStat(&a);
+    node1.addStat(&b);
+    node2.addStat(&c);
+
+    statistics::Snapshot snapshot(root, {&legacy});
+    TestOutput output;
+    snapshot.replay(output);
+    ASSERT_EQ(snapshot.size(), 4);
+    ASSERT_EQ(output.lines, std::vector<std::string>({
+        "a=0", "group node1", "b=0", "group node2", "c=0", "endgroup",
+        "endgroup", "legacy=0"}));
+}
+
+/** Test that the prerequisites are copied along with the stats. */
+TEST(StatsSnapshotTest, Prereq)
+{
+    statistics::Group root(nullptr);
+    TestScalar a("a"), b("b"), prereq("prereq");
+    a.prereq = &prereq;
+    b.prereq = &prereq;
+    root.addStat(&a);
+    root.addStat(&b);
+
+    statistics::Snapshot snapshot(root, {});
+    prereq.counter = 1;
+
+    TestOutput output;
+    snapshot.replay(output);
+    ASSERT_EQ(output.lines, std::vector<std::string>({
+        "a=0 (prereq zero)", "b=0 (prereq zero)"}));
+}
+
+/** Test that all the stats are prepared, including the legacy ones. */
+TEST(StatsSnapshotTest, PrepareStats)
+{
+    statistics::Group root(nullptr);
+    statistics::Group node1(nullptr);
+    root.addStatGroup("node1", &node1);
+
+    TestScalar a("a"), b("b"), legacy("legacy");
+    root.addStat(&a);
+    node1.addStat(&b);
+
+    statistics::prepareStats(root, {&legacy});
+    ASSERT_TRUE(a.prepared);
+    ASSERT_TRUE(b.prepared);
+    ASSERT_TRUE(legacy.prepared);
+}
+
+/** Test that asynchronous dumps are written in order to every output. */
+TEST(StatsSnapshotTest, DumpAsync)
+{
+    statistics::Group root(nullptr);
+    TestScalar a("a");
+    root.addStat(&a);
+
+    TestOutput output1, output2;
+    for (int i = 0; i < 4; i++) {
+        a.counter = i;
+        statistics::dumpAsync(root, {}, {&output1, &output2});
+    }
+    statistics::drainDumps();
+
+    std::vector<std::string> expected;
+    for (int i = 0; i < 4; i++) {
+        expected.push_back("begin");
+        expected.push_back("a=" + std::to_string(i));
+        expected.push_back("end");
+    }
+    ASSERT_EQ(output1.lines, expected);
+    ASSERT_EQ(output2.lines, expected);
+}
+
+/** Test that the values of vectors and distributions are kept. */
+TEST(StatsSnapshotTest, VectorsAndDists)
+{
+    statistics::Group root(nullptr);
+    TestVector short_vec("short", 2), long_vec("long", 3);
+    TestDist dist("dist");
+    root.addStat(&long_vec);
+    root.addStat(&dist);
+    root.addStat(&short_vec);
+
+    long_vec.counters = {1, 2, 3};
+    short_vec.counters = {4, 5};
+    dist.samples = 7;
+    dist.prepare();
+    statistics::Snapshot snapshot(root, {});
+
+    long_vec.counters = {0, 0, 0};
+    short_vec.counters = {0, 0};
+    dist.samples = 0;
+    dist.prepare();
+
+    // Replaying twice gives the same output, and vectors of different
+    // sizes do not leak into each other.
+    for (int i = 0; i < 2; i++) {
+        TestOutput output;
+        snapshot.replay(output);
+        ASSERT_EQ(output.lines, std::vector<std::string>({
+            "long=1,2,3,total 6", "dist samples=7", "short=4,5,total 9"}));
+    }
+}
+
+/**
+ * Test that only the values are kept, and the stats are described by
+ * the live stats when replayed.
+ */
+TEST(StatsSnapshotTest, DescribedByLiveStats)
+{
+    statistics::Group root(nullptr);
+    TestVector vec("vec", 2);
+    root.addStat(&vec);
+
+    vec.counters = {1, 2};
+    statistics::Snapshot snapshot(root, {});
+    vec.subnames = {"a", "b"};
+
+    TestOutput output;
+    snapshot.replay(output);
+    ASSERT_EQ(output.lines, std::vector<std::string>({
+        "vec=a:1,b:2,total 3"}));
+}
+
+/**
+ * Test that replaying a vector whose live stat lost subnames since the
+ * snapshot was taken panics, rather than reading past them.
+ */
+TEST(StatsSnapshotTest, ShrunkDescription)
+{
+    statistics::Group root(nullptr);
+    TestVector vec("vec", 3);
+    root.addStat(&vec);
+
+    statistics::Snapshot snapshot(root, {});
+    vec.subnames.resize(2);
+
+    gtestLogOutput.str("");
+    TestOutput output;
+    EXPECT_ANY_THROW(snapshot.replay(output));
+    ASSERT_NE(gtestLogOutput.str().find("Description of stat vec changed"),
+              std::string::npos);
+}
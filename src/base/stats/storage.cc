@@ -53,6 +53,7 @@ void
 DistStor::sample(Counter val, int number)
 {
     assert(bucket_size > 0);
+    clearStaleBuckets();
     if (val < min_track)
         underflow += number;
     else if (val > max_track)
@@ -176,6 +177,7 @@ void
 HistStor::sample(Counter val, int number)
 {
     assert(min_bucket < max_bucket);
+    clearStaleBuckets();
     if (val < min_bucket) {
         if (min_bucket == 0)
             growDown();
@@ -212,6 +214,9 @@ HistStor::add(HistStor *hs)
     assert(size() == b_size);
     assert(min_bucket == hs->min_bucket);
 
+    clearStaleBuckets();
+    hs->clearStaleBuckets();
+
     sum += hs->sum;
     logs += hs->logs;
     squares += hs->squares;
@@ -226,5 +231,24 @@ HistStor::add(HistStor *hs)
         cvec[i] += hs->cvec[i];
 }
 
+Counter
+LogHistStor::bucket(Counter val) const
+{
+    const Counter magnitude = std::fabs(val);
+    Counter bound;
+    if (magnitude < std::ldexp(1.0, precision)) {
+        bound = std::floor(magnitude);
+    } else {
+        // frexp() returns the exponent of the power of two above the
+        // magnitude, so the buckets in [2^(exp-1), 2^exp) are
+        // 2^(exp-1-precision) wide
+        int exp;
+        std::frexp(magnitude, &exp);
+        const Counter width = std::ldexp(1.0, exp - 1 - (int)precision);
+        bound = std::floor(magnitude / width) * width;
+    }
+    return val < 0 ? -bound : bound;
+}
+
 } // namespace statistics
 } // namespace gem5
@@ -30,6 +30,7 @@
 #ifndef __BASE_STATS_STORAGE_HH__
 #define __BASE_STATS_STORAGE_HH__
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
@@ -255,6 +256,22 @@ class DistStor
     Counter samples;
     /** Counter for each bucket. */
     VCounter cvec;
+    /** Whether the buckets must be cleared before they are used again. */
+    bool staleBuckets;
+
+    /**
+     * Clear the buckets if they have not been cleared since the last
+     * reset. This is deferred until samples are added, so that resetting
+     * and dumping a distribution that is not sampled again is cheap.
+     */
+    void
+    clearStaleBuckets()
+    {
+        if (staleBuckets) {
+            std::fill(cvec.begin(), cvec.end(), Counter());
+            staleBuckets = false;
+        }
+    }
 
   public:
     /** The parameters for a distribution stat. */
@@ -288,6 +305,7 @@ class DistStor
         : cvec(safe_cast<const Params *>(storage_params)->buckets)
     {
         reset(storage_params);
+        staleBuckets = false;
     }
 
     /**
@@ -329,9 +347,14 @@ class DistStor
         data.underflow = underflow;
         data.overflow = overflow;
 
+        // Stale buckets are left to be cleared when they are used again
         data.cvec.resize(params->buckets);
-        for (off_type i = 0; i < params->buckets; ++i)
-            data.cvec[i] = cvec[i];
+        if (staleBuckets) {
+            std::fill(data.cvec.begin(), data.cvec.end(), Counter());
+        } else {
+            for (off_type i = 0; i < params->buckets; ++i)
+                data.cvec[i] = cvec[i];
+        }
 
         data.sum = sum;
         data.squares = squares;
@@ -353,10 +376,7 @@ class DistStor
         max_val = CounterLimits::min();
         underflow = Counter();
         overflow = Counter();
-
-        size_type size = cvec.size();
-        for (off_type i = 0; i < size; ++i)
-            cvec[i] = Counter();
+        staleBuckets = true;
 
         sum = Counter();
         squares = Counter();
@@ -415,6 +435,21 @@ class HistStor
     Counter samples;
     /** Counter for each bucket. */
     VCounter cvec;
+    /** Whether the buckets must be cleared before they are used again. */
+    bool staleBuckets;
+
+    /**
+     * Clear the buckets if they have not been cleared since the last
+     * reset. @sa DistStor::clearStaleBuckets
+     */
+    void
+    clearStaleBuckets()
+    {
+        if (staleBuckets) {
+            std::fill(cvec.begin(), cvec.end(), Counter());
+            staleBuckets = false;
+        }
+    }
 
     /**
      * Given a bucket size B, and a range of values [0, N], this function
@@ -474,6 +509,7 @@ class HistStor
         : cvec(safe_cast<const Params *>(storage_params)->buckets)
     {
         reset(storage_params);
+        staleBuckets = false;
     }
 
     /**
@@ -519,10 +555,15 @@ class HistStor
         data.min_val = min_bucket;
         data.max_val = max_bucket;
 
+        // Stale buckets are left to be cleared when they are used again
         int buckets = params->buckets;
         data.cvec.resize(buckets);
-        for (off_type i = 0; i < buckets; ++i)
-            data.cvec[i] = cvec[i];
+        if (staleBuckets) {
+            std::fill(data.cvec.begin(), data.cvec.end(), Counter());
+        } else {
+            for (off_type i = 0; i < buckets; ++i)
+                data.cvec[i] = cvec[i];
+        }
 
         data.sum = sum;
         data.logs = logs;
@@ -540,10 +581,7 @@ class HistStor
         min_bucket = 0;
         max_bucket = params->buckets - 1;
         bucket_size = 1;
-
-        size_type size = cvec.size();
-        for (off_type i = 0; i < size; ++i)
-            cvec[i] = Counter();
+        staleBuckets = true;
 
         sum = Counter();
         squares = Counter();
@@ -781,6 +819,102 @@ class SparseHistStor
     }
 };
 
+/**
+ * Templatized storage and interface for a sparse histogram stat whose
+ * buckets grow with the magnitude of the values. Each power of two is
+ * split into 2^precision buckets of the same size, and the values below
+ * 2^precision get a bucket of size 1 each, so the relative error of a
+ * bucket is bounded by 2^-precision however large the values are. As in
+ * SparseHistStor, only the buckets that have been sampled are stored.
+ *
+ * Each bucket is identified by its bound closest to zero; negative
+ * values are bucketed like their absolute value.
+ */
+class LogHistStor
+{
+  private:
+    /** Log2 of the number of buckets each power of two is split into. */
+    unsigned precision;
+    /** Counter for number of samples */
+    Counter samples;
+    /** Counter for each bucket. */
+    MCounter cmap;
+
+  public:
+    /** The parameters for a logarithmic histogram stat. */
+    struct Params : public DistParams
+    {
+        /** Log2 of the number of buckets per power of two. */
+        unsigned precision;
+
+        Params(unsigned _precision)
+          : DistParams(Hist), precision(_precision)
+        {
+            fatal_if(precision > 52,
+                "Histogram precision (%d) must be at most 52 bits",
+                precision);
+        }
+    };
+
+    LogHistStor(const StorageParams* const storage_params)
+        : precision(safe_cast<const Params *>(storage_params)->precision)
+    {
+        reset(storage_params);
+    }
+
+    /**
+     * Find the bucket a value belongs to.
+     * @param val The value to look up.
+     * @return The bound of the bucket closest to zero.
+     */
+    Counter bucket(Counter val) const;
+
+    /**
+     * Add a value to the distribution for the given number of times.
+     * @param val The value to add.
+     * @param number The number of times to add the value.
+     */
+    void
+    sample(Counter val, int number)
+    {
+        cmap[bucket(val)] += number;
+        samples += number;
+    }
+
+    /**
+     * Return the number of buckets in this distribution.
+     * @return the number of buckets.
+     */
+    size_type size() const { return cmap.size(); }
+
+    /**
+     * Returns true if any calls to sample have been made.
+     * @return True if any values have been sampled.
+     */
+    bool
+    zero() const
+    {
+        return samples == Counter();
+    }
+
+    void
+    prepare(const StorageParams* const storage_params, SparseHistData &data)
+    {
+        data.cmap = cmap;
+        data.samples = samples;
+    }
+
+    /**
+     * Reset stat value to default
+     */
+    void
+    reset(const StorageParams* const storage_params)
+    {
+        cmap.clear();
+        samples = 0;
+    }
+};
+
 } // namespace statistics
 } // namespace gem5
 
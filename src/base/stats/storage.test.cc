@@ -471,6 +471,55 @@ TEST(StatsDistStorTest, Reset)
     checkExpectedDistData(data, expected_data, true);
 }
 
+/** Test that the samples before a reset do not leak into the next ones. */
+TEST(StatsDistStorTest, ResetSample)
+{
+    statistics::DistStor::Params params(0, 99, 5);
+    statistics::DistStor stor(&params);
+
+    stor.sample(10, 5);
+    stor.sample(52, 63);
+    stor.reset(&params);
+    stor.sample(12, 3);
+
+    statistics::DistData data;
+    stor.prepare(&params, data);
+    ASSERT_EQ(data.samples, 3);
+    ASSERT_EQ(data.cvec.size(), params.buckets);
+    for (int i = 0; i < data.cvec.size(); i++) {
+        ASSERT_EQ(data.cvec[i], i == 2 ? 3 : 0);
+    }
+}
+
+/** Test dumping a distribution that was not sampled since a reset. */
+TEST(StatsDistStorTest, PrepareAfterReset)
+{
+    statistics::DistStor::Params params(0, 99, 5);
+    statistics::DistStor stor(&params);
+
+    stor.sample(10, 5);
+    stor.reset(&params);
+
+    // The data is dumped with empty buckets, repeatedly
+    for (int dump = 0; dump < 2; dump++) {
+        statistics::DistData data;
+        data.cvec.assign(params.buckets, 1);
+        stor.prepare(&params, data);
+        ASSERT_EQ(data.samples, 0);
+        ASSERT_EQ(data.cvec.size(), params.buckets);
+        for (int i = 0; i < data.cvec.size(); i++)
+            ASSERT_EQ(data.cvec[i], 0);
+    }
+
+    // The old samples are still gone once sampled again
+    stor.sample(12, 3);
+    statistics::DistData data;
+    stor.prepare(&params, data);
+    ASSERT_EQ(data.samples, 3);
+    for (int i = 0; i < data.cvec.size(); i++)
+        ASSERT_EQ(data.cvec[i], i == 2 ? 3 : 0);
+}
+
 #if TRACING_ON
 /** Test that an assertion is thrown when not enough buckets are provided. */
 TEST(StatsHistStorDeathTest, NotEnoughBuckets0)
@@ -886,6 +935,80 @@ TEST(StatsHistStorTest, Reset)
     prepareCheckHistStor(params, values, 0, expected_data);
 }
 
+/** Test that the samples before a reset do not leak into the next ones. */
+TEST(StatsHistStorTest, ResetSample)
+{
+    statistics::HistStor::Params params(4);
+    statistics::HistStor stor(&params);
+
+    // Grow the buckets before resetting
+    stor.sample(1, 2);
+    stor.sample(100, 3);
+    stor.reset(&params);
+    stor.sample(2, 7);
+
+    statistics::DistData data;
+    stor.prepare(&params, data);
+    ASSERT_EQ(data.bucket_size, 1);
+    ASSERT_EQ(data.samples, 7);
+    ASSERT_EQ(data.cvec.size(), params.buckets);
+    for (int i = 0; i < data.cvec.size(); i++) {
+        ASSERT_EQ(data.cvec[i], i == 2 ? 7 : 0);
+    }
+}
+
+/** Test dumping a histogram that was not sampled since a reset. */
+TEST(StatsHistStorTest, PrepareAfterReset)
+{
+    statistics::HistStor::Params params(4);
+    statistics::HistStor stor(&params);
+
+    stor.sample(1, 2);
+    stor.reset(&params);
+
+    // The data is dumped with empty buckets, repeatedly
+    for (int dump = 0; dump < 2; dump++) {
+        statistics::DistData data;
+        data.cvec.assign(params.buckets, 1);
+        stor.prepare(&params, data);
+        ASSERT_EQ(data.samples, 0);
+        ASSERT_EQ(data.cvec.size(), params.buckets);
+        for (int i = 0; i < data.cvec.size(); i++)
+            ASSERT_EQ(data.cvec[i], 0);
+    }
+
+    // The old samples are still gone once sampled again
+    stor.sample(3, 4);
+    statistics::DistData data;
+    stor.prepare(&params, data);
+    ASSERT_EQ(data.samples, 4);
+    for (int i = 0; i < data.cvec.size(); i++)
+        ASSERT_EQ(data.cvec[i], i == 3 ? 4 : 0);
+}
+
+/** Test merging histograms that have been reset. */
+TEST(StatsHistStorTest, ResetAdd)
+{
+    statistics::HistStor::Params params(4);
+    statistics::HistStor stor(&params);
+    statistics::HistStor stor2(&params);
+
+    stor.sample(3, 4);
+    stor2.sample(1, 5);
+    stor.reset(&params);
+    stor2.reset(&params);
+    stor2.sample(0, 6);
+    stor.add(&stor2);
+
+    statistics::DistData data;
+    stor.prepare(&params, data);
+    ASSERT_EQ(data.samples, 6);
+    ASSERT_EQ(data.cvec.size(), params.buckets);
+    for (int i = 0; i < data.cvec.size(); i++) {
+        ASSERT_EQ(data.cvec[i], i == 0 ? 6 : 0);
+    }
+}
+
 #if TRACING_ON
 /** Test whether adding storages with different sizes triggers an assertion. */
 TEST(StatsHistStorDeathTest, AddDifferentSize)
@@ -1214,3 +1337,70 @@ TEST(StatsSparseHistStorTest, SamplePrepare)
     }
     ASSERT_EQ(data.samples, total_samples);
 }
+
+/**
+ * Test whether zero is correctly set as the reset value. The test order is
+ * to check if it is initially zero on creation, then it is made non zero,
+ * and finally reset to zero.
+ */
+TEST(StatsLogHistStorTest, ZeroReset)
+{
+    statistics::LogHistStor::Params params(2);
+    statistics::LogHistStor stor(&params);
+
+    ASSERT_TRUE(stor.zero());
+
+    stor.sample(1000, 5);
+    ASSERT_FALSE(stor.zero());
+
+    stor.reset(&params);
+    ASSERT_TRUE(stor.zero());
+    ASSERT_EQ(stor.size(), 0);
+}
+
+/** Test the bounds of the buckets the values fall into. */
+TEST(StatsLogHistStorTest, Bucket)
+{
+    // Four buckets per power of two
+    statistics::LogHistStor::Params params(2);
+    statistics::LogHistStor stor(&params);
+
+    // Values below 4 have a bucket each
+    ASSERT_EQ(stor.bucket(0), 0);
+    ASSERT_EQ(stor.bucket(1), 1);
+    ASSERT_EQ(stor.bucket(3.5), 3);
+
+    // [4,8[ has buckets of size 1, [8,16[ of size 2, and so on
+    ASSERT_EQ(stor.bucket(4), 4);
+    ASSERT_EQ(stor.bucket(7.9), 7);
+    ASSERT_EQ(stor.bucket(8), 8);
+    ASSERT_EQ(stor.bucket(11), 10);
+    ASSERT_EQ(stor.bucket(1000), 896);
+    ASSERT_EQ(stor.bucket(1024), 1024);
+
+    // Negative values are bucketed like their absolute value
+    ASSERT_EQ(stor.bucket(-11), -10);
+}
+
+/** Test setting and getting value from storage. */
+TEST(StatsLogHistStorTest, SamplePrepare)
+{
+    statistics::LogHistStor::Params params(2);
+    statistics::LogHistStor stor(&params);
+    statistics::SparseHistData data;
+
+    stor.sample(10, 5);
+    stor.sample(11, 2);
+    stor.sample(1000, 18);
+    stor.prepare(&params, data);
+    ASSERT_EQ(stor.size(), 2);
+    ASSERT_EQ(data.cmap.size(), 2);
+    ASSERT_EQ(data.cmap[10], 7);
+    ASSERT_EQ(data.cmap[896], 18);
+    ASSERT_EQ(data.samples, 25);
+
+    stor.reset(&params);
+    stor.prepare(&params, data);
+    ASSERT_EQ(data.cmap.size(), 0);
+    ASSERT_EQ(data.samples, 0);
+}
@@ -103,6 +103,79 @@ disable()
 
 ObjectMatch ignore;
 
+void
+formatDeferred(std::ostream &stream, const char *fmt,
+               const DeferredArg *args, size_t num_args)
+{
+    cp::Print print(stream, fmt);
+    for (size_t i = 0; i < num_args; i++) {
+        const DeferredArg &arg = args[i];
+        switch (arg.type) {
+          case DeferredArg::Bool:
+            print.addArg(static_cast<bool>(arg.integer));
+            break;
+          case DeferredArg::Char:
+            print.addArg(static_cast<char>(arg.integer));
+            break;
+          case DeferredArg::SignedChar:
+            print.addArg(static_cast<signed char>(arg.integer));
+            break;
+          case DeferredArg::UnsignedChar:
+            print.addArg(static_cast<unsigned char>(arg.integer));
+            break;
+          case DeferredArg::Short:
+            print.addArg(static_cast<short>(arg.integer));
+            break;
+          case DeferredArg::UnsignedShort:
+            print.addArg(static_cast<unsigned short>(arg.integer));
+            break;
+          case DeferredArg::Int:
+            print.addArg(static_cast<int>(arg.integer));
+            break;
+          case DeferredArg::UnsignedInt:
+            print.addArg(static_cast<unsigned int>(arg.integer));
+            break;
+          case DeferredArg::Long:
+            print.addArg(static_cast<long>(arg.integer));
+            break;
+          case DeferredArg::UnsignedLong:
+            print.addArg(static_cast<unsigned long>(arg.integer));
+            break;
+          case DeferredArg::LongLong:
+            print.addArg(static_cast<long long>(arg.integer));
+            break;
+          case DeferredArg::UnsignedLongLong:
+            print.addArg(static_cast<unsigned long long>(arg.integer));
+            break;
+          case DeferredArg::Float:
+            print.addArg(static_cast<float>(arg.floating));
+            break;
+          case DeferredArg::Double:
+            print.addArg(arg.floating);
+            break;
+          case DeferredArg::CString:
+            print.addArg(arg.string);
+            break;
+          case DeferredArg::String:
+            print.addArg(std::string(arg.string, arg.length));
+            break;
+          default:
+            panic("Invalid deferred debug argument type %d\n", arg.type);
+        }
+    }
+    print.endArgs();
+}
+
+void
+Logger::logDeferred(Tick when, const std::string &name,
+        const std::string &flag, const char *fmt,
+        const DeferredArg *args, size_t num_args)
+{
+    std::ostringstream line;
+    formatDeferred(line, fmt, args, num_args);
+    logMessage(when, name, flag, line.str());
+}
+
 
 void
 Logger::dump(Tick when, const std::string &name,
@@ -32,9 +32,12 @@
 #ifndef __BASE_TRACE_HH__
 #define __BASE_TRACE_HH__
 
+#include <array>
+#include <cstring>
 #include <ostream>
 #include <string>
 #include <sstream>
+#include <type_traits>
 
 #include "base/compiler.hh"
 #include "base/cprintf.hh"
@@ -54,6 +57,116 @@ namespace gem5
 
 namespace trace {
 
+/**
+ * An argument of a debug message, captured so that the message can be
+ * formatted later on. Only the arguments whose formatting depends on
+ * nothing but their value and type can be captured, i.e., the arithmetic
+ * types and strings.
+ */
+struct DeferredArg
+{
+    enum Type : uint8_t
+    {
+        Bool,
+        Char,
+        SignedChar,
+        UnsignedChar,
+        Short,
+        UnsignedShort,
+        Int,
+        UnsignedInt,
+        Long,
+        UnsignedLong,
+        LongLong,
+        UnsignedLongLong,
+        Float,
+        Double,
+        /** A C string, which may be a null pointer */
+        CString,
+        /** A std::string */
+        String,
+        NumTypes
+    };
+
+    Type type;
+    union
+    {
+        /** Bits of an integral value */
+        uint64_t integer;
+        double floating;
+        const char *string;
+    };
+    /** Length of a string */
+    size_t length;
+
+    /** @return The type of a captured argument of type T, or NumTypes. */
+    template <typename T>
+    static constexpr Type
+    typeOf()
+    {
+        using U = std::remove_cv_t<std::decay_t<T>>;
+        if constexpr (std::is_same_v<U, bool>) return Bool;
+        else if constexpr (std::is_same_v<U, char>) return Char;
+        else if constexpr (std::is_same_v<U, signed char>) return SignedChar;
+        else if constexpr (std::is_same_v<U, unsigned char>)
+            return UnsignedChar;
+        else if constexpr (std::is_same_v<U, short>) return Short;
+        else if constexpr (std::is_same_v<U, unsigned short>)
+            return UnsignedShort;
+        else if constexpr (std::is_same_v<U, int>) return Int;
+        else if constexpr (std::is_same_v<U, unsigned int>) return UnsignedInt;
+        else if constexpr (std::is_same_v<U, long>) return Long;
+        else if constexpr (std::is_same_v<U, unsigned long>)
+            return UnsignedLong;
+        else if constexpr (std::is_same_v<U, long long>) return LongLong;
+        else if constexpr (std::is_same_v<U, unsigned long long>)
+            return UnsignedLongLong;
+        else if constexpr (std::is_same_v<U, float>) return Float;
+        else if constexpr (std::is_same_v<U, double>) return Double;
+        else if constexpr (std::is_same_v<U, char *> ||
+                           std::is_same_v<U, const char *>) return CString;
+        else if constexpr (std::is_same_v<U, std::string>) return String;
+        else return NumTypes;
+    }
+
+    template <typename T>
+    static constexpr bool capturable = typeOf<T>() != NumTypes;
+
+    /**
+     * Capture an argument. Strings are not copied, so the argument is only
+     * valid as long as the captured value is.
+     */
+    template <typename T>
+    static DeferredArg
+    capture(const T &value)
+    {
+        static_assert(capturable<T>, "The argument cannot be captured");
+        DeferredArg arg;
+        arg.type = typeOf<T>();
+        arg.length = 0;
+        if constexpr (typeOf<T>() == String) {
+            arg.string = value.data();
+            arg.length = value.size();
+        } else if constexpr (typeOf<T>() == CString) {
+            const char *str = value;
+            arg.string = str;
+            arg.length = str ? std::strlen(str) : 0;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            arg.floating = value;
+        } else {
+            arg.integer = static_cast<uint64_t>(value);
+        }
+        return arg;
+    }
+};
+
+/**
+ * Format a message from its captured arguments. The result is the same as
+ * the one of ccprintf() on the original arguments.
+ */
+void formatDeferred(std::ostream &stream, const char *fmt,
+                    const DeferredArg *args, size_t num_args);
+
 /** Debug logging base class.  Handles formatting and outputting
  *  time/name/message messages */
 class Logger
@@ -64,6 +177,12 @@ class Logger
     /** Name match for objects to activate log */
     ObjectMatch activate;
 
+    /**
+     * Whether the messages whose arguments can be captured are passed to
+     * logDeferred() instead of being formatted when they are logged.
+     */
+    bool deferFormatting = false;
+
     bool isEnabled(const std::string &name) const
     {
         if (name.empty()) // Enable the logger with a empty name.
@@ -96,6 +215,15 @@ class Logger
     {
         if (!isEnabled(name))
             return;
+        if constexpr ((DeferredArg::capturable<Args> && ...)) {
+            if (deferFormatting) {
+                const std::array<DeferredArg, sizeof...(Args)> deferred{{
+                    DeferredArg::capture(args)...}};
+                logDeferred(when, name, flag, fmt, deferred.data(),
+                            deferred.size());
+                return;
+            }
+        }
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, flag, line.str());
@@ -109,6 +237,14 @@ class Logger
     virtual void logMessage(Tick when, const std::string &name,
             const std::string &flag, const std::string &message) = 0;
 
+    /**
+     * Log a message whose arguments were captured instead of formatted.
+     * By default the message is formatted and logged right away.
+     */
+    virtual void logDeferred(Tick when, const std::string &name,
+            const std::string &flag, const char *fmt,
+            const DeferredArg *args, size_t num_args);
+
     /** Return an ostream that can be used to send messages to
      *  the 'same place' as formatted logMessage messages.  This
      *  can be implemented to use a logger's underlying ostream,
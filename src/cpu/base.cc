@@ -61,6 +61,7 @@
 #include "debug/SyscallVerbose.hh"
 #include "debug/Thread.hh"
 #include "mem/page_table.hh"
+#include "mem/port.hh"
 #include "params/BaseCPU.hh"
 #include "sim/clocked_object.hh"
 #include "sim/full_system.hh"
@@ -262,7 +263,7 @@ BaseCPU::mwait(ThreadID tid, PacketPtr pkt)
 
         assert(pkt->req->hasPaddr());
         monitor.pAddr = pkt->getAddr() & mask;
-        monitor.waiting = true;
+        monitor.setWaiting(true);
 
         DPRINTF(Mwait, "[tid:%d] mwait called (vAddr=0x%lx, "
                 "line's paddr=0x%lx)\n", tid, monitor.vAddr, monitor.pAddr);
@@ -300,7 +301,7 @@ BaseCPU::mwaitAtomic(ThreadID tid, ThreadContext *tc, BaseMMU *mmu)
     assert(fault == NoFault);
 
     monitor.pAddr = req->getPaddr() & mask;
-    monitor.waiting = true;
+    monitor.setWaiting(true);
 
     DPRINTF(Mwait, "[tid:%d] mwait called (vAddr=0x%lx, line's paddr=0x%lx)\n",
             tid, monitor.vAddr, monitor.pAddr);
@@ -467,6 +468,14 @@ BaseCPU::getPort(const std::string &if_name, PortID idx)
         return ClockedObject::getPort(if_name, idx);
 }
 
+void
+BaseCPU::sendFunctional(PacketPtr pkt)
+{
+    const auto *port = dynamic_cast<const RequestPort *>(&getDataPort());
+    assert(port);
+    port->sendFunctional(pkt);
+}
+
 void
 BaseCPU::registerThreadContexts()
 {
@@ -753,6 +762,8 @@ BaseCPU::getCurrentInstCount(ThreadID tid)
     return threadContexts[tid]->getCurrentInstCount();
 }
 
+std::atomic<unsigned> AddressMonitor::numWaiting(0);
+
 AddressMonitor::AddressMonitor()
 {
     armed = false;
@@ -760,6 +771,18 @@ AddressMonitor::AddressMonitor()
     gotWakeup = false;
 }
 
+void
+AddressMonitor::setWaiting(bool w)
+{
+    if (w != waiting) {
+        waiting = w;
+        if (w)
+            numWaiting++;
+        else
+            numWaiting--;
+    }
+}
+
 bool
 AddressMonitor::doMonitor(PacketPtr pkt)
 {
@@ -768,7 +791,7 @@ AddressMonitor::doMonitor(PacketPtr pkt)
         if (pAddr == pkt->getAddr()) {
             DPRINTF(Mwait, "pAddr=0x%lx invalidated: waking up core\n",
                     pkt->getAddr());
-            waiting = false;
+            setWaiting(false);
             return true;
         }
     }
@@ -42,6 +42,7 @@
 #ifndef __CPU_BASE_HH__
 #define __CPU_BASE_HH__
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -72,12 +73,26 @@ struct AddressMonitor
     AddressMonitor();
     bool doMonitor(PacketPtr pkt);
 
+    /** Start or stop waiting for a write to the monitored line */
+    void setWaiting(bool w);
+
+    /**
+     * Whether any monitor, of any CPU, is waiting for a write. Writes
+     * that skip the memory system must not be done while one is, since
+     * they would not be snooped and so would not wake it up.
+     */
+    static bool anyWaiting() { return numWaiting.load() != 0; }
+
     bool armed;
     Addr vAddr;
     Addr pAddr;
     uint64_t val;
     bool waiting;   // 0=normal, 1=mwaiting
     bool gotWakeup;
+
+  private:
+    /** Number of monitors waiting for a write */
+    static std::atomic<unsigned> numWaiting;
 };
 
 class CPUProgressEvent : public Event
@@ -183,6 +198,16 @@ class BaseCPU : public ClockedObject
      */
     virtual Port &getInstPort() = 0;
 
+    /**
+     * Send a functional access issued by one of the threads (e.g., by
+     * system call emulation or a loader) through the data port. The
+     * CPU does not snoop its own accesses, so CPUs keeping state
+     * derived from memory override this to see the writes they issue.
+     *
+     * @param pkt The functional access.
+     */
+    virtual void sendFunctional(PacketPtr pkt);
+
     /** Reads this CPU's ID. */
     int cpuId() const { return _cpuId; }
 
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/age_matrix.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+AgeMatrix::AgeMatrix(unsigned num_slots)
+    : numSlots(std::max(64u, roundUp(num_slots, 64u))),
+      numWords(numSlots / 64), numValid(0),
+      validMask(numWords, 0),
+      rows(numSlots * numWords, 0),
+      seqNums(numSlots, 0)
+{
+}
+
+int
+AgeMatrix::insert(InstSeqNum seq_num)
+{
+    if (numValid == numSlots)
+        grow();
+
+    int slot = -1;
+    for (unsigned w = 0; w < numWords; ++w) {
+        if (~validMask[w]) {
+            slot = w * 64 + findLsbSet(~validMask[w]);
+            break;
+        }
+    }
+    assert(slot >= 0);
+
+    // The row of the new slot is built from scratch, and its column is
+    // updated in the rows of the other instructions, as it may have
+    // held an instruction of a different age before
+    uint64_t *new_row = row(slot);
+    std::fill(new_row, new_row + numWords, 0);
+    const uint64_t slot_bit = uint64_t(1) << (slot % 64);
+    for (unsigned w = 0; w < numWords; ++w) {
+        for (uint64_t bits = validMask[w]; bits; bits &= bits - 1) {
+            int other = w * 64 + findLsbSet(bits);
+            if (seqNums[other] < seq_num) {
+                new_row[w] |= uint64_t(1) << (other % 64);
+                row(other)[slot / 64] &= ~slot_bit;
+            } else {
+                row(other)[slot / 64] |= slot_bit;
+            }
+        }
+    }
+
+    setBit(validMask, slot);
+    seqNums[slot] = seq_num;
+    numValid++;
+
+    return slot;
+}
+
+void
+AgeMatrix::remove(int slot)
+{
+    assert(valid(slot));
+    clearBit(validMask, slot);
+    numValid--;
+}
+
+void
+AgeMatrix::clear()
+{
+    std::fill(validMask.begin(), validMask.end(), 0);
+    numValid = 0;
+}
+
+int
+AgeMatrix::oldest(const Mask &exclude) const
+{
+    assert(exclude.size() == numWords);
+
+    Mask &candidates = scratch;
+    candidates.resize(numWords);
+    for (unsigned w = 0; w < numWords; ++w)
+        candidates[w] = validMask[w] & ~exclude[w];
+
+    for (unsigned w = 0; w < numWords; ++w) {
+        for (uint64_t bits = candidates[w]; bits; bits &= bits - 1) {
+            int slot = w * 64 + findLsbSet(bits);
+            const uint64_t *slot_row = row(slot);
+            bool is_oldest = true;
+            for (unsigned v = 0; v < numWords && is_oldest; ++v)
+                is_oldest = !(slot_row[v] & candidates[v]);
+            if (is_oldest)
+                return slot;
+        }
+    }
+
+    return -1;
+}
+
+void
+AgeMatrix::grow()
+{
+    unsigned new_slots = numSlots * 2;
+    unsigned new_words = new_slots / 64;
+
+    std::vector<uint64_t> new_rows(new_slots * new_words, 0);
+    for (unsigned slot = 0; slot < numSlots; ++slot) {
+        std::copy(row(slot), row(slot) + numWords,
+                  &new_rows[slot * new_words]);
+    }
+
+    rows.swap(new_rows);
+    validMask.resize(new_words, 0);
+    seqNums.resize(new_slots, 0);
+    numSlots = new_slots;
+    numWords = new_words;
+}
+
+} // namespace o3
+} // namespace gem5
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_AGE_MATRIX_HH__
+#define __CPU_O3_AGE_MATRIX_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "cpu/inst_seq.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * An age matrix tracks the relative age of the instructions held in a
+ * fixed number of slots, as the select logic of wide-issue schedulers
+ * does. Each slot has a row with one bit per slot, set if the
+ * instruction in that other slot is older. The oldest instruction in
+ * any subset of the slots is then the one whose row has no bit set
+ * within the subset, which is found with a few word-wide operations per
+ * candidate instead of keeping the instructions sorted.
+ *
+ * Instructions are ordered by sequence number. The matrix grows if all
+ * its slots are in use.
+ */
+class AgeMatrix
+{
+  public:
+    /** A set of slots, one bit per slot. */
+    typedef std::vector<uint64_t> Mask;
+
+    /**
+     * Create an age matrix.
+     *
+     * @param num_slots Initial number of slots
+     */
+    explicit AgeMatrix(unsigned num_slots);
+
+    /**
+     * Put an instruction in a free slot.
+     *
+     * @param seq_num Sequence number of the instruction
+     * @return Slot of the instruction
+     */
+    int insert(InstSeqNum seq_num);
+
+    /** Free a slot. */
+    void remove(int slot);
+
+    /** Free all the slots. */
+    void clear();
+
+    /**
+     * Find the oldest instruction, ignoring some of the slots.
+     *
+     * @param exclude Slots to ignore, as returned by emptyMask()
+     * @return Slot of the oldest instruction, or -1 if there is none
+     */
+    int oldest(const Mask &exclude) const;
+
+    /** Create a set with none of the current slots. */
+    Mask emptyMask() const { return Mask(numWords, 0); }
+
+    /** Extend a set to cover all the current slots, e.g., after growing. */
+    void fitMask(Mask &mask) const { mask.resize(numWords, 0); }
+
+    /** Add a slot to a set. */
+    static void
+    setBit(Mask &mask, int slot)
+    {
+        mask[slot / 64] |= uint64_t(1) << (slot % 64);
+    }
+
+    /** Remove a slot from a set. */
+    static void
+    clearBit(Mask &mask, int slot)
+    {
+        mask[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+    }
+
+    /** Add all the slots of a set to another one of the same size. */
+    static void
+    merge(Mask &mask, const Mask &other)
+    {
+        for (size_t w = 0; w < mask.size(); ++w)
+            mask[w] |= other[w];
+    }
+
+    /**
+     * Call a function on every slot of a set, in slot order. The function
+     * may remove slots from the set.
+     */
+    template <class F>
+    static void
+    forEachSlot(const Mask &mask, F f)
+    {
+        for (size_t w = 0; w < mask.size(); ++w) {
+            for (uint64_t bits = mask[w]; bits; bits &= bits - 1)
+                f(int(w * 64 + findLsbSet(bits)));
+        }
+    }
+
+    /** Whether a slot is in a set. */
+    static bool
+    isSet(const Mask &mask, int slot)
+    {
+        return mask[slot / 64] & (uint64_t(1) << (slot % 64));
+    }
+
+    /** Whether a slot holds an instruction. */
+    bool valid(int slot) const { return isSet(validMask, slot); }
+
+    /** Sequence number of the instruction in a slot. */
+    InstSeqNum seqNum(int slot) const { return seqNums[slot]; }
+
+    /** Number of instructions in the matrix. */
+    unsigned size() const { return numValid; }
+
+    bool empty() const { return numValid == 0; }
+
+    /** Number of slots, which is a multiple of 64. */
+    unsigned capacity() const { return numSlots; }
+
+  private:
+    /** Double the number of slots, keeping the instructions in place. */
+    void grow();
+
+    /** First word of the row of a slot. */
+    uint64_t *row(int slot) { return &rows[slot * numWords]; }
+    const uint64_t *row(int slot) const { return &rows[slot * numWords]; }
+
+    unsigned numSlots;
+    unsigned numWords;
+    unsigned numValid;
+
+    /** Slots holding an instruction */
+    Mask validMask;
+
+    /** Rows of the matrix, one after the other */
+    std::vector<uint64_t> rows;
+
+    /** Sequence number of the instruction in each slot */
+    std::vector<InstSeqNum> seqNums;
+
+    /** Candidate slots of oldest(), kept to avoid reallocating them */
+    mutable Mask scratch;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_AGE_MATRIX_HH__
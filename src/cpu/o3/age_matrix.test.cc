@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "cpu/o3/age_matrix.hh"
+
+using namespace gem5;
+using namespace gem5::o3;
+
+TEST(AgeMatrixTest, Empty)
+{
+    AgeMatrix matrix(16);
+    EXPECT_TRUE(matrix.empty());
+    EXPECT_EQ(matrix.capacity(), 64);
+    EXPECT_EQ(matrix.oldest(matrix.emptyMask()), -1);
+}
+
+TEST(AgeMatrixTest, OldestOutsideMask)
+{
+    AgeMatrix matrix(64);
+    int young = matrix.insert(30);
+    int old = matrix.insert(10);
+    int middle = matrix.insert(20);
+
+    AgeMatrix::Mask exclude = matrix.emptyMask();
+    EXPECT_EQ(matrix.oldest(exclude), old);
+
+    AgeMatrix::setBit(exclude, old);
+    EXPECT_EQ(matrix.oldest(exclude), middle);
+
+    AgeMatrix::setBit(exclude, middle);
+    EXPECT_EQ(matrix.oldest(exclude), young);
+
+    AgeMatrix::setBit(exclude, young);
+    EXPECT_EQ(matrix.oldest(exclude), -1);
+}
+
+/** A freed slot is reused by an instruction of a different age. */
+TEST(AgeMatrixTest, ReuseSlot)
+{
+    AgeMatrix matrix(64);
+    int first = matrix.insert(10);
+    int second = matrix.insert(20);
+    matrix.remove(first);
+
+    int third = matrix.insert(30);
+    EXPECT_EQ(third, first);
+    EXPECT_EQ(matrix.seqNum(third), 30);
+    EXPECT_EQ(matrix.oldest(matrix.emptyMask()), second);
+}
+
+/** Growing keeps the instructions in their slots and in order. */
+TEST(AgeMatrixTest, Grow)
+{
+    AgeMatrix matrix(64);
+    std::map<int, InstSeqNum> slots;
+    for (InstSeqNum seq_num = 200; seq_num > 0; seq_num--)
+        slots[matrix.insert(seq_num)] = seq_num;
+
+    EXPECT_EQ(matrix.size(), 200);
+    EXPECT_EQ(matrix.capacity(), 256);
+    for (auto &slot : slots)
+        EXPECT_EQ(matrix.seqNum(slot.first), slot.second);
+
+    AgeMatrix::Mask exclude = matrix.emptyMask();
+    for (InstSeqNum seq_num = 1; seq_num <= 200; seq_num++) {
+        int slot = matrix.oldest(exclude);
+        ASSERT_GE(slot, 0);
+        EXPECT_EQ(matrix.seqNum(slot), seq_num);
+        AgeMatrix::setBit(exclude, slot);
+    }
+}
+
+TEST(AgeMatrixTest, Clear)
+{
+    AgeMatrix matrix(64);
+    matrix.insert(10);
+    matrix.insert(20);
+    matrix.clear();
+    EXPECT_TRUE(matrix.empty());
+    EXPECT_EQ(matrix.oldest(matrix.emptyMask()), -1);
+
+    int slot = matrix.insert(5);
+    EXPECT_EQ(matrix.oldest(matrix.emptyMask()), slot);
+}
+
+TEST(AgeMatrixTest, MaskHelpers)
+{
+    AgeMatrix matrix(64);
+    AgeMatrix::Mask mask = matrix.emptyMask();
+    AgeMatrix::setBit(mask, 3);
+    AgeMatrix::setBit(mask, 40);
+
+    // Growing keeps the slots of the sets that are extended
+    for (int i = 0; i < 65; i++)
+        matrix.insert(i);
+    matrix.fitMask(mask);
+    ASSERT_EQ(mask.size(), matrix.emptyMask().size());
+    AgeMatrix::setBit(mask, 100);
+
+    AgeMatrix::Mask other = matrix.emptyMask();
+    AgeMatrix::setBit(other, 64);
+    AgeMatrix::merge(other, mask);
+
+    // Slots can be removed while iterating
+    std::vector<int> slots;
+    AgeMatrix::forEachSlot(other, [&](int slot) {
+        slots.push_back(slot);
+        AgeMatrix::clearBit(other, slot);
+    });
+    EXPECT_EQ(slots, std::vector<int>({3, 40, 64, 100}));
+    EXPECT_EQ(other, matrix.emptyMask());
+    EXPECT_TRUE(AgeMatrix::isSet(mask, 100));
+}
+
+/**
+ * Random inserts, removals and selections, with instructions inserted
+ * out of order, checked against a search over all the instructions.
+ */
+TEST(AgeMatrixTest, MatchesBruteForce)
+{
+    std::mt19937 rng(1);
+    AgeMatrix matrix(8);
+    std::map<int, InstSeqNum> ref;
+    InstSeqNum next_seq_num = 100;
+
+    for (int i = 0; i < 100000; i++) {
+        if (rng() % 3 != 0 && ref.size() < 300) {
+            // Mostly in order, as instructions are renamed, but ready
+            // instructions can be older than the ones in the matrix.
+            InstSeqNum seq_num = rng() % 4 == 0 ?
+                next_seq_num - rng() % 50 : next_seq_num++;
+            bool dup = false;
+            for (auto &entry : ref)
+                dup |= entry.second == seq_num;
+            if (dup)
+                continue;
+
+            int slot = matrix.insert(seq_num);
+            ASSERT_EQ(ref.count(slot), 0);
+            ref[slot] = seq_num;
+        } else if (!ref.empty()) {
+            AgeMatrix::Mask exclude = matrix.emptyMask();
+            for (auto &entry : ref) {
+                if (rng() % 4 == 0)
+                    AgeMatrix::setBit(exclude, entry.first);
+            }
+
+            int expected = -1;
+            for (auto &entry : ref) {
+                if (!AgeMatrix::isSet(exclude, entry.first) &&
+                    (expected < 0 || entry.second < ref[expected])) {
+                    expected = entry.first;
+                }
+            }
+            ASSERT_EQ(matrix.oldest(exclude), expected);
+
+            // Remove either the one selected, as when issuing, or any
+            // of them, as when squashing.
+            auto it = ref.begin();
+            if (expected >= 0 && rng() % 2)
+                it = ref.find(expected);
+            else
+                std::advance(it, rng() % ref.size());
+            matrix.remove(it->first);
+            ref.erase(it);
+        }
+        ASSERT_EQ(matrix.size(), ref.size());
+    }
+}
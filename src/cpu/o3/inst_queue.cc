@@ -41,6 +41,7 @@
 
 #include "cpu/o3/inst_queue.hh"
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
@@ -89,7 +90,11 @@ InstructionQueue::InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
     : cpu(cpu_ptr),
       iewStage(iew_ptr),
       fuPool(params.fuPool),
+      readyMatrix(params.numIQEntries),
+      readyOpClassSlots(Num_OpClasses, readyMatrix.emptyMask()),
+      readyThreadSlots(MaxThreads, readyMatrix.emptyMask()),
       iqPolicy(params.smtIQPolicy),
+      scheduler(params.iqScheduler),
       numThreads(params.numThreads),
       numEntries(params.numIQEntries),
       totalWidth(params.issueWidth),
@@ -423,6 +428,12 @@ InstructionQueue::resetState()
     }
     nonSpecInsts.clear();
     listOrder.clear();
+    readyMatrix.clear();
+    readySlots.clear();
+    for (auto &slots : readyOpClassSlots)
+        std::fill(slots.begin(), slots.end(), 0);
+    for (auto &slots : readyThreadSlots)
+        std::fill(slots.begin(), slots.end(), 0);
     deferredMemInsts.clear();
     blockedMemInsts.clear();
     retryMemInsts.clear();
@@ -546,7 +557,7 @@ InstructionQueue::isFull(ThreadID tid)
 bool
 InstructionQueue::hasReadyInsts()
 {
-    if (!listOrder.empty()) {
+    if (!listOrder.empty() || !readyMatrix.empty()) {
         return true;
     }
 
@@ -766,6 +777,26 @@ InstructionQueue::scheduleReadyInsts()
         addReadyMemInst(mem_inst);
     }
 
+    int total_issued = scheduler == IQScheduler::AgeMatrix ?
+        issueFromAgeMatrix(i2e_info) : issueFromReadyList(i2e_info);
+
+    iqStats.numIssuedDist.sample(total_issued);
+    iqStats.instsIssued+= total_issued;
+
+    // If we issued any instructions, tell the CPU we had activity.
+    // @todo If the way deferred memory instructions are handeled due to
+    // translation changes then the deferredMemInsts condition should be
+    // removed from the code below.
+    if (total_issued || !retryMemInsts.empty() || !deferredMemInsts.empty()) {
+        cpu->activityThisCycle();
+    } else {
+        DPRINTF(IQ, "Not able to schedule any instructions.\n");
+    }
+}
+
+int
+InstructionQueue::issueFromReadyList(IssueStruct *i2e_info)
+{
     // Have iterator to head of the list
     // While I haven't exceeded bandwidth or reached the end of the list,
     // Try to get a FU that can do what this op needs.
@@ -812,60 +843,7 @@ InstructionQueue::scheduleReadyInsts()
             continue;
         }
 
-        int idx = FUPool::NoCapableFU;
-        Cycles op_latency = Cycles(1);
-        ThreadID tid = issuing_inst->threadNumber;
-
-        if (op_class != No_OpClass) {
-            idx = fuPool->getUnit(op_class);
-            if (issuing_inst->isFloating()) {
-                iqIOStats.fpAluAccesses++;
-            } else if (issuing_inst->isVector()) {
-                iqIOStats.vecAluAccesses++;
-            } else {
-                iqIOStats.intAluAccesses++;
-            }
-            if (idx > FUPool::NoFreeFU) {
-                op_latency = fuPool->getOpLatency(op_class);
-            }
-        }
-
-        // If we have an instruction that doesn't require a FU, or a
-        // valid FU, then schedule for execution.
-        if (idx != FUPool::NoFreeFU) {
-            if (op_latency == Cycles(1)) {
-                i2e_info->size++;
-                instsToExecute.push_back(issuing_inst);
-
-                // Add the FU onto the list of FU's to be freed next
-                // cycle if we used one.
-                if (idx >= 0)
-                    fuPool->freeUnitNextCycle(idx);
-            } else {
-                bool pipelined = fuPool->isPipelined(op_class);
-                // Generate completion event for the FU
-                ++wbOutstanding;
-                FUCompletion *execution = new FUCompletion(issuing_inst,
-                                                           idx, this);
-
-                cpu->schedule(execution,
-                              cpu->clockEdge(Cycles(op_latency - 1)));
-
-                if (!pipelined) {
-                    // If FU isn't pipelined, then it must be freed
-                    // upon the execution completing.
-                    execution->setFreeFU();
-                } else {
-                    // Add the FU onto the list of FU's to be freed next cycle.
-                    fuPool->freeUnitNextCycle(idx);
-                }
-            }
-
-            DPRINTF(IQ, "Thread %i: Issuing instruction PC %s "
-                    "[sn:%llu]\n",
-                    tid, issuing_inst->pcState(),
-                    issuing_inst->seqNum);
-
+        if (issueInst(issuing_inst, i2e_info)) {
             readyInsts[op_class].pop();
 
             if (!readyInsts[op_class].empty()) {
@@ -875,47 +853,159 @@ InstructionQueue::scheduleReadyInsts()
                 queueOnList[op_class] = false;
             }
 
-            issuing_inst->setIssued();
             ++total_issued;
 
-#if TRACING_ON
-            issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
-#endif
+            listOrder.erase(order_it++);
+        } else {
+            ++order_it;
+        }
+    }
 
-            if (issuing_inst->firstIssue == -1)
-                issuing_inst->firstIssue = curTick();
+    return total_issued;
+}
 
-            if (!issuing_inst->isMemRef()) {
-                // Memory instructions can not be freed from the IQ until they
-                // complete.
-                ++freeEntries;
-                count[tid]--;
-                issuing_inst->clearInIQ();
-            } else {
-                memDepUnit[tid].issue(issuing_inst);
-            }
+int
+InstructionQueue::issueFromAgeMatrix(IssueStruct *i2e_info)
+{
+    // Select the oldest ready instruction until the bandwidth runs out.
+    // When there is no FU for an op class, the ready instructions of
+    // that class are masked out for the rest of the cycle, which issues
+    // in the same order as the ready lists.
+    int total_issued = 0;
+    AgeMatrix::Mask fu_busy = readyMatrix.emptyMask();
 
-            listOrder.erase(order_it++);
-            iqStats.statIssuedInstType[tid][op_class]++;
+    while (total_issued < totalWidth) {
+        int slot = readyMatrix.oldest(fu_busy);
+        if (slot < 0)
+            break;
+
+        DynInstPtr issuing_inst = readySlots[slot];
+
+        if (issuing_inst->isFloating()) {
+            iqIOStats.fpInstQueueReads++;
+        } else if (issuing_inst->isVector()) {
+            iqIOStats.vecInstQueueReads++;
         } else {
-            iqStats.statFuBusy[op_class]++;
-            iqStats.fuBusy[tid]++;
-            ++order_it;
+            iqIOStats.intInstQueueReads++;
+        }
+
+        if (issuing_inst->isSquashed()) {
+            removeFromAgeMatrix(slot);
+
+            ++iqStats.squashedInstsIssued;
+
+            continue;
+        }
+
+        if (issueInst(issuing_inst, i2e_info)) {
+            removeFromAgeMatrix(slot);
+
+            ++total_issued;
+        } else {
+            AgeMatrix::merge(fu_busy,
+                             readyOpClassSlots[issuing_inst->opClass()]);
         }
     }
 
-    iqStats.numIssuedDist.sample(total_issued);
-    iqStats.instsIssued+= total_issued;
+    return total_issued;
+}
 
-    // If we issued any instructions, tell the CPU we had activity.
-    // @todo If the way deferred memory instructions are handeled due to
-    // translation changes then the deferredMemInsts condition should be
-    // removed from the code below.
-    if (total_issued || !retryMemInsts.empty() || !deferredMemInsts.empty()) {
-        cpu->activityThisCycle();
+void
+InstructionQueue::removeFromAgeMatrix(int slot)
+{
+    const DynInstPtr &inst = readySlots[slot];
+    AgeMatrix::clearBit(readyOpClassSlots[inst->opClass()], slot);
+    AgeMatrix::clearBit(readyThreadSlots[inst->threadNumber], slot);
+    readyMatrix.remove(slot);
+    readySlots[slot] = nullptr;
+}
+
+bool
+InstructionQueue::issueInst(const DynInstPtr &issuing_inst,
+                            IssueStruct *i2e_info)
+{
+    OpClass op_class = issuing_inst->opClass();
+    int idx = FUPool::NoCapableFU;
+    Cycles op_latency = Cycles(1);
+    ThreadID tid = issuing_inst->threadNumber;
+
+    if (op_class != No_OpClass) {
+        idx = fuPool->getUnit(op_class);
+        if (issuing_inst->isFloating()) {
+            iqIOStats.fpAluAccesses++;
+        } else if (issuing_inst->isVector()) {
+            iqIOStats.vecAluAccesses++;
+        } else {
+            iqIOStats.intAluAccesses++;
+        }
+        if (idx > FUPool::NoFreeFU) {
+            op_latency = fuPool->getOpLatency(op_class);
+        }
+    }
+
+    // Only an instruction that doesn't require a FU, or that got a
+    // valid FU, can be scheduled for execution.
+    if (idx == FUPool::NoFreeFU) {
+        iqStats.statFuBusy[op_class]++;
+        iqStats.fuBusy[tid]++;
+        return false;
+    }
+
+    if (op_latency == Cycles(1)) {
+        i2e_info->size++;
+        instsToExecute.push_back(issuing_inst);
+
+        // Add the FU onto the list of FU's to be freed next
+        // cycle if we used one.
+        if (idx >= 0)
+            fuPool->freeUnitNextCycle(idx);
     } else {
-        DPRINTF(IQ, "Not able to schedule any instructions.\n");
+        bool pipelined = fuPool->isPipelined(op_class);
+        // Generate completion event for the FU
+        ++wbOutstanding;
+        FUCompletion *execution = new FUCompletion(issuing_inst,
+                                                   idx, this);
+
+        cpu->schedule(execution,
+                      cpu->clockEdge(Cycles(op_latency - 1)));
+
+        if (!pipelined) {
+            // If FU isn't pipelined, then it must be freed
+            // upon the execution completing.
+            execution->setFreeFU();
+        } else {
+            // Add the FU onto the list of FU's to be freed next cycle.
+            fuPool->freeUnitNextCycle(idx);
+        }
     }
+
+    DPRINTF(IQ, "Thread %i: Issuing instruction PC %s "
+            "[sn:%llu]\n",
+            tid, issuing_inst->pcState(),
+            issuing_inst->seqNum);
+
+    issuing_inst->setIssued();
+
+#if TRACING_ON
+    issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
+#endif
+
+    if (issuing_inst->firstIssue == -1)
+        issuing_inst->firstIssue = curTick();
+
+    if (!issuing_inst->isMemRef()) {
+        // Memory instructions can not be freed from the IQ until they
+        // complete.
+        ++freeEntries;
+        count[tid]--;
+        issuing_inst->clearInIQ();
+    } else {
+        memDepUnit[tid].issue(issuing_inst);
+    }
+
+    iqStats.statIssuedInstType[tid][op_class]++;
+
+    return true;
 }
 
 void
@@ -1066,23 +1156,12 @@ InstructionQueue::wakeDependents(const DynInstPtr &completed_inst)
 void
 InstructionQueue::addReadyMemInst(const DynInstPtr &ready_inst)
 {
-    OpClass op_class = ready_inst->opClass();
-
-    readyInsts[op_class].push(ready_inst);
-
-    // Will need to reorder the list if either a queue is not on the list,
-    // or it has an older instruction than last time.
-    if (!queueOnList[op_class]) {
-        addToOrderList(op_class);
-    } else if (readyInsts[op_class].top()->seqNum  <
-               (*readyIt[op_class]).oldestInst) {
-        listOrder.erase(readyIt[op_class]);
-        addToOrderList(op_class);
-    }
+    addToReadyList(ready_inst);
 
     DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
             "the ready list, PC %s opclass:%i [sn:%llu].\n",
-            ready_inst->pcState(), op_class, ready_inst->seqNum);
+            ready_inst->pcState(), ready_inst->opClass(),
+            ready_inst->seqNum);
 }
 
 void
@@ -1321,6 +1400,15 @@ InstructionQueue::doSquash(ThreadID tid)
         instList[tid].erase(squash_it--);
         ++iqStats.squashedInstsExamined;
     }
+
+    // Take the squashed instructions out of the age matrix right away,
+    // so that they neither hold slots nor get selected for issue.
+    if (scheduler == IQScheduler::AgeMatrix) {
+        AgeMatrix::forEachSlot(readyThreadSlots[tid], [this, tid](int slot) {
+            if (readySlots[slot]->seqNum > squashedSeqNum[tid])
+                removeFromAgeMatrix(slot);
+        });
+    }
 }
 
 bool
@@ -1437,17 +1525,40 @@ InstructionQueue::addIfReady(const DynInstPtr &inst)
                 "the ready list, PC %s opclass:%i [sn:%llu].\n",
                 inst->pcState(), op_class, inst->seqNum);
 
-        readyInsts[op_class].push(inst);
+        addToReadyList(inst);
+    }
+}
 
-        // Will need to reorder the list if either a queue is not on the list,
-        // or it has an older instruction than last time.
-        if (!queueOnList[op_class]) {
-            addToOrderList(op_class);
-        } else if (readyInsts[op_class].top()->seqNum  <
-                   (*readyIt[op_class]).oldestInst) {
-            listOrder.erase(readyIt[op_class]);
-            addToOrderList(op_class);
+void
+InstructionQueue::addToReadyList(const DynInstPtr &inst)
+{
+    OpClass op_class = inst->opClass();
+
+    if (scheduler == IQScheduler::AgeMatrix) {
+        int slot = readyMatrix.insert(inst->seqNum);
+        if (slot >= (int)readySlots.size()) {
+            readySlots.resize(readyMatrix.capacity());
+            for (auto &slots : readyOpClassSlots)
+                readyMatrix.fitMask(slots);
+            for (auto &slots : readyThreadSlots)
+                readyMatrix.fitMask(slots);
         }
+        readySlots[slot] = inst;
+        AgeMatrix::setBit(readyOpClassSlots[op_class], slot);
+        AgeMatrix::setBit(readyThreadSlots[inst->threadNumber], slot);
+        return;
+    }
+
+    readyInsts[op_class].push(inst);
+
+    // Will need to reorder the list if either a queue is not on the list,
+    // or it has an older instruction than last time.
+    if (!queueOnList[op_class]) {
+        addToOrderList(op_class);
+    } else if (readyInsts[op_class].top()->seqNum  <
+               (*readyIt[op_class]).oldestInst) {
+        listOrder.erase(readyIt[op_class]);
+        addToOrderList(op_class);
     }
 }
 
@@ -1496,6 +1607,8 @@ InstructionQueue::dumpLists()
     }
 
     cprintf("\n");
+
+    cprintf("Age matrix size: %i\n", readyMatrix.size());
 }
 
 
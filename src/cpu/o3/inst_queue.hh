@@ -50,6 +50,7 @@
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
+#include "cpu/o3/age_matrix.hh"
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/dep_graph.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
@@ -58,6 +59,7 @@
 #include "cpu/o3/store_set.hh"
 #include "cpu/op_class.hh"
 #include "cpu/timebuf.hh"
+#include "enums/IQScheduler.hh"
 #include "enums/SMTQueuePolicy.hh"
 #include "sim/eventq.hh"
 
@@ -402,6 +404,46 @@ class InstructionQueue
      */
     void moveToYoungerInst(ListOrderIt age_order_it);
 
+    /** Age matrix of the ready instructions, used instead of the ready
+     *  queues and the age order list by the age matrix scheduler.
+     */
+    AgeMatrix readyMatrix;
+
+    /** Ready instructions indexed by their slot in the age matrix. */
+    std::vector<DynInstPtr> readySlots;
+
+    /** Age matrix slots of the ready instructions of each op class. */
+    std::vector<AgeMatrix::Mask> readyOpClassSlots;
+
+    /** Age matrix slots of the ready instructions of each thread. */
+    std::vector<AgeMatrix::Mask> readyThreadSlots;
+
+    /** Takes the instruction in a slot out of the age matrix. */
+    void removeFromAgeMatrix(int slot);
+
+    /** Puts a ready instruction where the scheduler will select it. */
+    void addToReadyList(const DynInstPtr &inst);
+
+    /**
+     * Issues the oldest ready instructions using the ready queues and
+     * the age order list.
+     * @return The number of instructions issued.
+     */
+    int issueFromReadyList(IssueStruct *i2e_info);
+
+    /**
+     * Issues the oldest ready instructions using the age matrix.
+     * @return The number of instructions issued.
+     */
+    int issueFromAgeMatrix(IssueStruct *i2e_info);
+
+    /**
+     * Tries to get a FU for an instruction and schedules it for
+     * execution.
+     * @return False if there is no free FU for the instruction.
+     */
+    bool issueInst(const DynInstPtr &issuing_inst, IssueStruct *i2e_info);
+
     DependencyGraph<DynInstPtr> dependGraph;
 
     //////////////////////////////////////
@@ -411,6 +453,9 @@ class InstructionQueue
     /** IQ sharing policy for SMT. */
     SMTQueuePolicy iqPolicy;
 
+    /** Policy used to select the ready instructions to issue. */
+    IQScheduler scheduler;
+
     /** Number of Total Threads*/
     ThreadID numThreads;
 
@@ -41,6 +41,7 @@
 #include "cpu/o3/rob.hh"
 
 #include <list>
+#include <utility>
 
 #include "base/logging.hh"
 #include "cpu/o3/dyn_inst.hh"
@@ -64,6 +65,10 @@ ROB::ROB(CPU *_cpu, const BaseO3CPUParams &params)
       numThreads(params.numThreads),
       stats(_cpu)
 {
+    instList.reserve(MaxThreads);
+    for (ThreadID tid = 0; tid < MaxThreads; tid++)
+        instList.emplace_back(numEntries);
+
     //Figure out rob policy
     if (robPolicy == SMTQueuePolicy::Dynamic) {
         //Set Max Entries to Total ROB Capacity
@@ -105,16 +110,14 @@ ROB::resetState()
 {
     for (ThreadID tid = 0; tid  < MaxThreads; tid++) {
         threadEntries[tid] = 0;
-        squashIt[tid] = instList[tid].end();
         squashedSeqNum[tid] = 0;
         doneSquashing[tid] = true;
     }
     numInstsInROB = 0;
 
-    // Initialize the "universal" ROB head & tail point to invalid
-    // pointers
-    head = instList[0].end();
-    tail = instList[0].end();
+    // The "universal" ROB head & tail are invalid while the ROB is empty
+    head.reset();
+    tail.reset();
 }
 
 std::string
@@ -211,20 +214,17 @@ ROB::insertInst(const DynInstPtr &inst)
     //Set Up head iterator if this is the 1st instruction in the ROB
     if (numInstsInROB == 0) {
         head = instList[tid].begin();
-        assert((*head) == inst);
+        assert((**head) == inst);
     }
 
-    //Must Decrement for iterator to actually be valid  since __.end()
-    //actually points to 1 after the last inst
-    tail = instList[tid].end();
-    tail--;
+    tail = instList[tid].last();
 
     inst->setInROB();
 
     ++numInstsInROB;
     ++threadEntries[tid];
 
-    assert((*tail) == inst);
+    assert((**tail) == inst);
 
     DPRINTF(ROB, "[tid:%i] Now has %d instructions.\n", tid,
             threadEntries[tid]);
@@ -237,11 +237,10 @@ ROB::retireHead(ThreadID tid)
 
     assert(numInstsInROB > 0);
 
-    // Get the head ROB instruction by copying it and remove it from the list
-    InstIt head_it = instList[tid].begin();
-
-    DynInstPtr head_inst = std::move(*head_it);
-    instList[tid].erase(head_it);
+    // Get the head ROB instruction by moving it out of the buffer, so that
+    // the buffer does not keep a reference to it, and remove it
+    DynInstPtr head_inst = std::move(instList[tid].front());
+    instList[tid].pop_front();
 
     assert(head_inst->readyToCommit());
 
@@ -312,19 +311,7 @@ ROB::doSquash(ThreadID tid)
     DPRINTF(ROB, "[tid:%i] Squashing instructions until [sn:%llu].\n",
             tid, squashedSeqNum[tid]);
 
-    assert(squashIt[tid] != instList[tid].end());
-
-    if ((*squashIt[tid])->seqNum < squashedSeqNum[tid]) {
-        DPRINTF(ROB, "[tid:%i] Done squashing instructions.\n",
-                tid);
-
-        squashIt[tid] = instList[tid].end();
-
-        doneSquashing[tid] = true;
-        return;
-    }
-
-    bool robTailUpdate = false;
+    assert(instList[tid].isSquashing());
 
     unsigned int numInstsToSquash = squashWidth;
 
@@ -336,52 +323,23 @@ ROB::doSquash(ThreadID tid)
         numInstsToSquash = numEntries;
     }
 
-    for (int numSquashed = 0;
-         numSquashed < numInstsToSquash &&
-         squashIt[tid] != instList[tid].end() &&
-         (*squashIt[tid])->seqNum > squashedSeqNum[tid];
-         ++numSquashed)
-    {
-        DPRINTF(ROB, "[tid:%i] Squashing instruction PC %s, seq num %i.\n",
-                (*squashIt[tid])->threadNumber,
-                (*squashIt[tid])->pcState(),
-                (*squashIt[tid])->seqNum);
-
-        // Mark the instruction as squashed, and ready to commit so that
-        // it can drain out of the pipeline.
-        (*squashIt[tid])->setSquashed();
+    bool robTailUpdate = instList[tid].squash(numInstsToSquash,
+        [this, tid](const DynInstPtr &inst) {
+            DPRINTF(ROB, "[tid:%i] Squashing instruction PC %s, "
+                    "seq num %i.\n", tid, inst->pcState(), inst->seqNum);
 
-        (*squashIt[tid])->setCanCommit();
-
-
-        if (squashIt[tid] == instList[tid].begin()) {
-            DPRINTF(ROB, "Reached head of instruction list while "
-                    "squashing.\n");
-
-            squashIt[tid] = instList[tid].end();
-
-            doneSquashing[tid] = true;
-
-            return;
-        }
-
-        InstIt tail_thread = instList[tid].end();
-        tail_thread--;
-
-        if ((*squashIt[tid]) == (*tail_thread))
-            robTailUpdate = true;
-
-        squashIt[tid]--;
-    }
+            // Mark the instruction as squashed, and ready to commit so
+            // that it can drain out of the pipeline.
+            inst->setSquashed();
 
+            inst->setCanCommit();
+        });
 
     // Check if ROB is done squashing.
-    if ((*squashIt[tid])->seqNum <= squashedSeqNum[tid]) {
+    if (!instList[tid].isSquashing()) {
         DPRINTF(ROB, "[tid:%i] Done squashing instructions.\n",
                 tid);
 
-        squashIt[tid] = instList[tid].end();
-
         doneSquashing[tid] = true;
     }
 
@@ -409,7 +367,7 @@ ROB::updateHead()
 
         if (first_valid) {
             head = instList[tid].begin();
-            lowest_num = (*head)->seqNum;
+            lowest_num = (**head)->seqNum;
             first_valid = false;
             continue;
         }
@@ -427,7 +385,7 @@ ROB::updateHead()
     }
 
     if (first_valid) {
-        head = instList[0].end();
+        head.reset();
     }
 
 }
@@ -435,7 +393,7 @@ ROB::updateHead()
 void
 ROB::updateTail()
 {
-    tail = instList[0].end();
+    tail.reset();
     bool first_valid = true;
 
     std::list<ThreadID>::iterator threads = activeThreads->begin();
@@ -451,18 +409,16 @@ ROB::updateTail()
         // If this is the first valid then assign w/out
         // comparison
         if (first_valid) {
-            tail = instList[tid].end();
-            tail--;
+            tail = instList[tid].last();
             first_valid = false;
             continue;
         }
 
         // Assign new tail if this thread's tail is younger
         // than our current "tail high"
-        InstIt tail_thread = instList[tid].end();
-        tail_thread--;
+        InstIt tail_thread = instList[tid].last();
 
-        if ((*tail_thread)->seqNum > (*tail)->seqNum) {
+        if ((*tail_thread)->seqNum > (**tail)->seqNum) {
             tail = tail_thread;
         }
     }
@@ -489,10 +445,7 @@ ROB::squash(InstSeqNum squash_num, ThreadID tid)
     squashedSeqNum[tid] = squash_num;
 
     if (!instList[tid].empty()) {
-        InstIt tail_thread = instList[tid].end();
-        tail_thread--;
-
-        squashIt[tid] = tail_thread;
+        instList[tid].startSquash(squash_num);
 
         doSquash(tid);
     }
@@ -515,10 +468,7 @@ ROB::readHeadInst(ThreadID tid)
 DynInstPtr
 ROB::readTailInst(ThreadID tid)
 {
-    InstIt tail_thread = instList[tid].end();
-    tail_thread--;
-
-    return *tail_thread;
+    return *instList[tid].last();
 }
 
 ROB::ROBStats::ROBStats(statistics::Group *parent)
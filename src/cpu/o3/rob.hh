@@ -41,6 +41,7 @@
 #ifndef __CPU_O3_ROB_HH__
 #define __CPU_O3_ROB_HH__
 
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -50,6 +51,7 @@
 #include "cpu/inst_seq.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/limits.hh"
+#include "cpu/o3/rob_queue.hh"
 #include "cpu/reg_class.hh"
 #include "enums/SMTQueuePolicy.hh"
 
@@ -72,7 +74,7 @@ class ROB
 {
   public:
     typedef std::pair<RegIndex, RegIndex> UnmapInfo;
-    typedef typename std::list<DynInstPtr>::iterator InstIt;
+    typedef typename ROBQueue<DynInstPtr>::iterator InstIt;
 
     /** Possible ROB statuses. */
     enum Status
@@ -285,34 +287,29 @@ class ROB
     /** Max Insts a Thread Can Have in the ROB */
     unsigned maxEntries[MaxThreads];
 
-    /** ROB List of Instructions */
-    std::list<DynInstPtr> instList[MaxThreads];
+    /** ROB List of Instructions, one ring buffer per thread, which also
+     *  keeps track of the instructions left to squash.  Used so that there
+     *  is persistent state between cycles; when squashing, the
+     *  instructions are marked as squashed but not immediately removed,
+     *  meaning the tail iterator remains the same before and after a
+     *  squash.
+     */
+    std::vector<ROBQueue<DynInstPtr>> instList;
 
     /** Number of instructions that can be squashed in a single cycle. */
     unsigned squashWidth;
 
   public:
     /** Iterator pointing to the instruction which is the last instruction
-     *  in the ROB.  This may at times be invalid (ie when the ROB is empty),
-     *  however it should never be incorrect.
+     *  in the ROB.  This is unset when the ROB is empty.
      */
-    InstIt tail;
+    std::optional<InstIt> tail;
 
     /** Iterator pointing to the instruction which is the first instruction in
-     *  in the ROB*/
-    InstIt head;
-
-  private:
-    /** Iterator used for walking through the list of instructions when
-     *  squashing.  Used so that there is persistent state between cycles;
-     *  when squashing, the instructions are marked as squashed but not
-     *  immediately removed, meaning the tail iterator remains the same before
-     *  and after a squash.
-     *  This will always be set to cpu->instList.end() if it is invalid.
+     *  in the ROB.  This is unset when the ROB is empty.
      */
-    InstIt squashIt[MaxThreads];
+    std::optional<InstIt> head;
 
-  public:
     /** Number of instructions in the ROB. */
     int numInstsInROB;
 
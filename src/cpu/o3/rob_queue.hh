@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_ROB_QUEUE_HH__
+#define __CPU_O3_ROB_QUEUE_HH__
+
+#include <cassert>
+#include <optional>
+
+#include "base/circular_queue.hh"
+#include "cpu/inst_seq.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * The instructions of one thread in the ROB, from the oldest to the
+ * youngest, along with the progress of a squash that may take several
+ * cycles. Instructions only enter at the tail and leave from the head,
+ * so a ring buffer sized to the whole ROB holds them without allocating
+ * on every insertion.
+ *
+ * The end iterator of a ring buffer refers to the slot the next
+ * instruction is inserted in, so it can't mark the lack of a squash.
+ * Whether a squash is in progress is kept explicitly instead.
+ */
+template <class InstPtr>
+class ROBQueue : public CircularQueue<InstPtr>
+{
+  public:
+    typedef typename CircularQueue<InstPtr>::iterator iterator;
+
+    explicit ROBQueue(size_t size) : CircularQueue<InstPtr>(size) {}
+
+    /** Iterator to the youngest instruction of a non-empty queue. */
+    iterator
+    last()
+    {
+        assert(!this->empty());
+        iterator it = this->end();
+        return --it;
+    }
+
+    /**
+     * Start squashing the instructions younger than a given one,
+     * beginning with the youngest.
+     *
+     * @param seq_num Sequence number of the youngest instruction kept
+     */
+    void
+    startSquash(InstSeqNum seq_num)
+    {
+        squashSeqNum = seq_num;
+        if (this->empty())
+            squashIt.reset();
+        else
+            squashIt = last();
+    }
+
+    /** Is a squash still in progress? */
+    bool isSquashing() const { return squashIt.has_value(); }
+
+    /**
+     * Squash some more of the instructions younger than the one given
+     * to startSquash(). The instructions are left in the queue, so that
+     * they drain out of the pipeline.
+     *
+     * @param width Maximum number of instructions to squash
+     * @param squash_inst Called on every instruction squashed
+     * @return True if the youngest instruction was squashed
+     */
+    template <class SquashInst>
+    bool
+    squash(unsigned width, SquashInst &&squash_inst)
+    {
+        assert(isSquashing());
+        iterator &it = *squashIt;
+
+        if ((*it)->seqNum < squashSeqNum) {
+            squashIt.reset();
+            return false;
+        }
+
+        bool squashed_last = false;
+        for (unsigned num_squashed = 0;
+             num_squashed < width && (*it)->seqNum > squashSeqNum;
+             ++num_squashed) {
+            squash_inst(*it);
+
+            if (it == this->begin()) {
+                squashIt.reset();
+                return squashed_last;
+            }
+
+            if (it == last())
+                squashed_last = true;
+
+            --it;
+        }
+
+        if ((*it)->seqNum <= squashSeqNum)
+            squashIt.reset();
+
+        return squashed_last;
+    }
+
+  private:
+    /** Next instruction to squash, if a squash is in progress */
+    std::optional<iterator> squashIt;
+
+    /** Sequence number of the youngest instruction kept by the squash */
+    InstSeqNum squashSeqNum = 0;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_ROB_QUEUE_HH__
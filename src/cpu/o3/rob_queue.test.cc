@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "cpu/o3/rob_queue.hh"
+
+using namespace gem5;
+using namespace gem5::o3;
+
+namespace
+{
+
+struct Inst
+{
+    InstSeqNum seqNum;
+    bool squashed = false;
+};
+
+typedef std::shared_ptr<Inst> InstPtr;
+
+/** Add instructions first to last to the queue */
+void
+insert(ROBQueue<InstPtr> &queue, InstSeqNum first, InstSeqNum last)
+{
+    for (InstSeqNum seq_num = first; seq_num <= last; seq_num++)
+        queue.push_back(std::make_shared<Inst>(Inst{seq_num}));
+}
+
+/** Squash with a given width, recording the instructions squashed */
+bool
+squash(ROBQueue<InstPtr> &queue, unsigned width,
+       std::vector<InstSeqNum> &squashed)
+{
+    return queue.squash(width, [&squashed](const InstPtr &inst) {
+        inst->squashed = true;
+        squashed.push_back(inst->seqNum);
+    });
+}
+
+} // anonymous namespace
+
+/** Check that a squash walks from the youngest instruction */
+TEST(ROBQueueTest, SquashOverSeveralCycles)
+{
+    ROBQueue<InstPtr> queue(16);
+    insert(queue, 1, 10);
+
+    queue.startSquash(4);
+    EXPECT_TRUE(queue.isSquashing());
+
+    std::vector<InstSeqNum> squashed;
+    EXPECT_TRUE(squash(queue, 3, squashed));
+    EXPECT_EQ(squashed, std::vector<InstSeqNum>({10, 9, 8}));
+    EXPECT_TRUE(queue.isSquashing());
+
+    squashed.clear();
+    EXPECT_FALSE(squash(queue, 3, squashed));
+    EXPECT_EQ(squashed, std::vector<InstSeqNum>({7, 6, 5}));
+    EXPECT_FALSE(queue.isSquashing());
+
+    // The squashed instructions stay in the queue to drain out
+    EXPECT_EQ(queue.size(), 10);
+    for (auto &inst : queue)
+        EXPECT_EQ(inst->squashed, inst->seqNum > 4);
+}
+
+/** Check that a squash stops at the head of the queue */
+TEST(ROBQueueTest, SquashEverything)
+{
+    ROBQueue<InstPtr> queue(8);
+    insert(queue, 5, 7);
+
+    queue.startSquash(0);
+    std::vector<InstSeqNum> squashed;
+    squash(queue, 8, squashed);
+    EXPECT_EQ(squashed, std::vector<InstSeqNum>({7, 6, 5}));
+    EXPECT_FALSE(queue.isSquashing());
+}
+
+/** Check that nothing is squashed if all instructions are kept */
+TEST(ROBQueueTest, SquashNothing)
+{
+    ROBQueue<InstPtr> queue(8);
+    insert(queue, 1, 3);
+
+    queue.startSquash(3);
+    std::vector<InstSeqNum> squashed;
+    EXPECT_FALSE(squash(queue, 8, squashed));
+    EXPECT_TRUE(squashed.empty());
+    EXPECT_FALSE(queue.isSquashing());
+}
+
+/**
+ * Check that inserting after a squash doesn't resume it, which would
+ * happen if the end of the queue marked that no squash is in progress.
+ */
+TEST(ROBQueueTest, InsertAfterSquash)
+{
+    ROBQueue<InstPtr> queue(8);
+    insert(queue, 1, 4);
+
+    queue.startSquash(2);
+    std::vector<InstSeqNum> squashed;
+    squash(queue, 8, squashed);
+    EXPECT_FALSE(queue.isSquashing());
+
+    // Commit the instructions, including the squashed ones
+    queue.pop_front(4);
+    EXPECT_TRUE(queue.empty());
+    queue.startSquash(0);
+    EXPECT_FALSE(queue.isSquashing());
+
+    insert(queue, 5, 6);
+    EXPECT_FALSE(queue.isSquashing());
+    EXPECT_EQ(queue.last()->get()->seqNum, 6);
+}
+
+/** Check a squash across the wrap-around point of the ring buffer */
+TEST(ROBQueueTest, SquashAcrossWrapAround)
+{
+    ROBQueue<InstPtr> queue(8);
+    insert(queue, 1, 6);
+    queue.pop_front(5);
+    insert(queue, 7, 13);
+    EXPECT_TRUE(queue.full());
+
+    queue.startSquash(8);
+    std::vector<InstSeqNum> squashed;
+    EXPECT_TRUE(squash(queue, 8, squashed));
+    EXPECT_EQ(squashed, std::vector<InstSeqNum>({13, 12, 11, 10, 9}));
+    EXPECT_FALSE(queue.isSquashing());
+}
+
+/** Check committing the head while a younger squash is in progress */
+TEST(ROBQueueTest, CommitWhileSquashing)
+{
+    ROBQueue<InstPtr> queue(8);
+    insert(queue, 1, 8);
+
+    queue.startSquash(3);
+    std::vector<InstSeqNum> squashed;
+    squash(queue, 2, squashed);
+    EXPECT_TRUE(queue.isSquashing());
+
+    queue.pop_front(2);
+    EXPECT_EQ(queue.front()->seqNum, 3);
+
+    squashed.clear();
+    squash(queue, 8, squashed);
+    EXPECT_EQ(squashed, std::vector<InstSeqNum>({6, 5, 4}));
+    EXPECT_FALSE(queue.isSquashing());
+}
@@ -429,16 +429,30 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
     bool correct = (bi.yout >= 1) == taken;
     // what is the magnitude of yout?
     int abs_yout = abs(bi.yout);
+    // should the misprediction counts of the tables be tuned?
+    bool tune = threshold >= 0 && (!tuneonly || (abs_yout <= threshold));
+    // if the branch was predicted incorrectly or the correct
+    // prediction was weak, update the weights
+    bool do_train = !correct || (abs_yout <= theta);
+    if (!tune && !do_train) return;
+
+    // the histories do not change while training, so hash the branch
+    // into each table only once
+    hashedIndices.resize(specs.size());
+    for (int i = 0; i < specs.size(); i += 1) {
+        hashedIndices[i] = getIndex(tid, bi, *specs[i], i);
+    }
+    unsigned int sign_idx = bi.getHPC() % n_sign_bits;
+
     // keep track of mispredictions per table
-    if (threshold >= 0) if (!tuneonly || (abs_yout <= threshold)) {
+    if (tune) {
         bool halve = false;
 
         // for each table, figure out if there was a misprediction
         for (int i = 0; i < specs.size(); i += 1) {
             HistorySpec const &spec = *specs[i];
-            // get the hash to index the table
-            unsigned int hashed_idx = getIndex(tid, bi, spec, i);
-            bool sign = sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+            unsigned int hashed_idx = hashedIndices[i];
+            bool sign = sign_bits[i][hashed_idx][sign_idx];
             int counter = tables[i][hashed_idx];
             int weight = spec.coeff * ((spec.width == 5) ?
                                        xlat4[counter] : xlat[counter]);
@@ -458,9 +472,6 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
             }
         }
     }
-    // if the branch was predicted incorrectly or the correct
-    // prediction was weak, update the weights
-    bool do_train = !correct || (abs_yout <= theta);
     if (!do_train) return;
 
     // adaptive theta training, adapted from O-GEHL
@@ -485,15 +496,15 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
     for (int i = 0; i < specs.size(); i += 1) {
         HistorySpec const &spec = *specs[i];
         // get the magnitude
-        unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+        unsigned int hashed_idx = hashedIndices[i];
         int counter = tables[i][hashed_idx];
         // get the sign
-        bool sign = sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+        bool sign = sign_bits[i][hashed_idx][sign_idx];
         // increment/decrement if taken/not taken
         satIncDec(taken, sign, counter, (1 << (spec.width - 1)) - 1);
         // update the magnitude and sign
         tables[i][hashed_idx] = counter;
-        sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits] = sign;
+        sign_bits[i][hashed_idx][sign_idx] = sign;
         int weight = ((spec.width == 5) ? xlat4[counter] : xlat[counter]);
         // update the new version of yout
         if (sign) {
@@ -519,10 +530,10 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
                 for (int j = 0; j < specs.size(); j += 1) {
                     int i = (nrand + j) % specs.size();
                     HistorySpec const &spec = *specs[i];
-                    unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+                    unsigned int hashed_idx = hashedIndices[i];
                     int counter = tables[i][hashed_idx];
                     bool sign =
-                        sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+                        sign_bits[i][hashed_idx][sign_idx];
                     int weight = ((spec.width == 5) ?
                             xlat4[counter] : xlat[counter]);
                     int signed_weight = sign ? -weight : weight;
@@ -537,10 +548,10 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
                 if (besti != -1) {
                     int i = besti;
                     HistorySpec const &spec = *specs[i];
-                    unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+                    unsigned int hashed_idx = hashedIndices[i];
                     int counter = tables[i][hashed_idx];
                     bool sign =
-                        sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+                        sign_bits[i][hashed_idx][sign_idx];
                     if (counter > 1) {
                         counter--;
                         tables[i][hashed_idx] = counter;
@@ -383,6 +383,8 @@ class MultiperspectivePerceptron : public BPredUnit
     int path_length;
     int thresholdCounter;
     int theta;
+    /** Table indices of the branch being trained */
+    std::vector<unsigned int> hashedIndices;
     int extrabits;
     std::vector<int> imli_counter_bits;
     std::vector<int> modhist_indices;
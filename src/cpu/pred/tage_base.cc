@@ -196,10 +196,8 @@ TAGEBase::btbUpdate(ThreadID tid, Addr branch_pc, BranchInfo* &bi)
             tHist.computeIndices[i].comp = bi->ci[i];
             tHist.computeTags[0][i].comp = bi->ct0[i];
             tHist.computeTags[1][i].comp = bi->ct1[i];
-            tHist.computeIndices[i].update(tHist.gHist);
-            tHist.computeTags[0][i].update(tHist.gHist);
-            tHist.computeTags[1][i].update(tHist.gHist);
         }
+        updateFoldedHistories(tHist);
     }
 }
 
@@ -336,6 +334,17 @@ TAGEBase::updateGHist(uint8_t * &h, bool dir, uint8_t * tab, int &pt)
     h[0] = (dir) ? 1 : 0;
 }
 
+void
+TAGEBase::updateFoldedHistories(ThreadHistory & tHist)
+{
+    for (int i = 1; i <= nHistoryTables; i++)
+        tHist.computeIndices[i].update(tHist.gHist);
+    for (int i = 1; i <= nHistoryTables; i++)
+        tHist.computeTags[0][i].update(tHist.gHist);
+    for (int i = 1; i <= nHistoryTables; i++)
+        tHist.computeTags[1][i].update(tHist.gHist);
+}
+
 void
 TAGEBase::calculateIndicesAndTags(ThreadID tid, Addr branch_pc,
                                   BranchInfo* bi)
@@ -607,17 +616,14 @@ TAGEBase::updateHistories(ThreadID tid, Addr branch_pc, bool taken,
     }
 
     //prepare next index and tag computations for user branchs
-    for (int i = 1; i <= nHistoryTables; i++)
-    {
-        if (speculative) {
+    if (speculative) {
+        for (int i = 1; i <= nHistoryTables; i++) {
             bi->ci[i]  = tHist.computeIndices[i].comp;
             bi->ct0[i] = tHist.computeTags[0][i].comp;
             bi->ct1[i] = tHist.computeTags[1][i].comp;
         }
-        tHist.computeIndices[i].update(tHist.gHist);
-        tHist.computeTags[0][i].update(tHist.gHist);
-        tHist.computeTags[1][i].update(tHist.gHist);
     }
+    updateFoldedHistories(tHist);
     DPRINTF(Tage, "Updating global histories with branch:%lx; taken?:%d, "
             "path Hist: %x; pointer:%d\n", branch_pc, taken, tHist.pathHist,
             tHist.ptGhist);
@@ -645,10 +651,8 @@ TAGEBase::squash(ThreadID tid, bool taken, TAGEBase::BranchInfo *bi,
         tHist.computeIndices[i].comp = bi->ci[i];
         tHist.computeTags[0][i].comp = bi->ct0[i];
         tHist.computeTags[1][i].comp = bi->ct1[i];
-        tHist.computeIndices[i].update(tHist.gHist);
-        tHist.computeTags[0][i].update(tHist.gHist);
-        tHist.computeTags[1][i].update(tHist.gHist);
     }
+    updateFoldedHistories(tHist);
 }
 
 void
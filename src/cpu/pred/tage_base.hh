@@ -71,13 +71,13 @@ class TAGEBase : public SimObject
   protected:
     // Prediction Structures
 
-    // Tage Entry
+    // Tage Entry, with the tag first so that it packs into 4 bytes
     struct TageEntry
     {
-        int8_t ctr;
         uint16_t tag;
+        int8_t ctr;
         uint8_t u;
-        TageEntry() : ctr(0), tag(0), u(0) { }
+        TageEntry() : tag(0), ctr(0), u(0) { }
     };
 
     // Folded History Table - compressed history
@@ -468,6 +468,14 @@ class TAGEBase : public SimObject
      */
     virtual void initFoldedHistories(ThreadHistory & history);
 
+    /**
+     * Shifts the most recent branch outcome into the folded histories
+     * of all the tagged tables. Each kind of folded history is updated
+     * in its own loop, as the tables do not depend on each other.
+     * @param tHist Thread history whose folded histories are updated
+     */
+    void updateFoldedHistories(ThreadHistory & tHist);
+
     int *histLengths;
     int *tableIndices;
     int *tableTags;
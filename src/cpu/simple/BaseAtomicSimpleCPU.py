@@ -61,6 +61,29 @@ class BaseAtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
+    fast_fetch = Param.Bool(
+        False,
+        "Fetch instructions through the backdoors handed out by the memory "
+        "instead of sending a packet per fetch, and reuse the instructions "
+        "decoded from them until their page is written. Instructions are "
+        "only reused for ISAs whose decoding only depends on the "
+        "instruction and the PC (e.g., RISC-V). Only use it when the "
+        "instructions cannot be cached between the CPU and the memory, "
+        "e.g., to fast-forward without caches. Stores other CPUs do "
+        "through backdoors (see fast_data_access) are not snooped, so "
+        "they are only seen when bypassing caches, where reused "
+        "instructions are checked against the memory.",
+    )
+    fast_data_access = Param.Bool(
+        False,
+        "Do loads and stores through the backdoors handed out by the memory "
+        "instead of sending a packet per access. Accesses with side effects, "
+        "like LLSC or uncacheable ones, still send a packet. Stores send a "
+        "packet too while any CPU waits on an address monitor (e.g., "
+        "MWAIT), so that the write wakes it up. Only use it when no cache "
+        "in the system can hold the accessed data, since the other "
+        "accesses are not snooped.",
+    )
 
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
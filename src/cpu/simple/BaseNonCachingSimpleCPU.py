@@ -52,6 +52,8 @@ class BaseNonCachingSimpleCPU(BaseAtomicSimpleCPU):
 
     numThreads = 1
 
+    fast_fetch = True
+
     @classmethod
     def memory_mode(cls):
         return "atomic_noncaching"
@@ -78,6 +78,10 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
       width(p.width), locked(false),
       simulate_data_stalls(p.simulate_data_stalls),
       simulate_inst_stalls(p.simulate_inst_stalls),
+      fastFetch(p.fast_fetch),
+      fastDataAccess(p.fast_data_access),
+      fetchedFromBackdoor(false), cacheDecode(false), instPaddr(0),
+      decodedInst(nullptr),
       icachePort(name() + ".icache_port"),
       dcachePort(name() + ".dcache_port", this),
       dcache_access(false), dcache_latency(0),
@@ -142,6 +146,11 @@ void
 AtomicSimpleCPU::drainResume()
 {
     assert(!tickEvent.scheduled());
+
+    // Memory may have changed while drained, e.g., by restoring a
+    // checkpoint or by running another CPU model.
+    decodedInsts.clear();
+
     if (switchedOut())
         return;
 
@@ -274,6 +283,51 @@ AtomicSimpleCPU::sendPacket(RequestPort &port, const PacketPtr &pkt)
     return port.sendAtomic(pkt);
 }
 
+Tick
+AtomicSimpleCPU::sendPacketForBackdoor(RequestPort &port,
+                                       const PacketPtr &pkt)
+{
+    MemBackdoorPtr bd = nullptr;
+    Tick latency = port.sendAtomicBackdoor(pkt, bd);
+
+    // If the target gave us a backdoor for next time, record it.
+    if (bd)
+        backdoors.record(bd);
+    return latency;
+}
+
+bool
+AtomicSimpleCPU::canUseDataBackdoor(const RequestPtr &req) const
+{
+    return fastDataAccess && !req->isLocalAccess() &&
+        !req->isUncacheable() && !req->isStrictlyOrdered() &&
+        !req->isLLSC() && !req->isSwap() && !req->isMasked() &&
+        !req->isPrefetch() && !req->isCacheMaintenance() &&
+        !req->isMemMgmt();
+}
+
+bool
+AtomicSimpleCPU::dataBackdoorAccess(const RequestPtr &req, uint8_t *data,
+                                    bool write)
+{
+    // A store through a backdoor is not snooped by the other CPUs, so
+    // it would not wake up any of them waiting on an address monitor.
+    if (!canUseDataBackdoor(req) || (write && AddressMonitor::anyWaiting()))
+        return false;
+
+    AddrRange range = RangeSize(req->getPaddr(), req->getSize());
+    MemBackdoorPtr bd = backdoors.find(BackdoorCache::Data, range);
+    if (!bd || (write ? !bd->writeable() : !bd->readable()))
+        return false;
+
+    uint8_t *host = bd->ptr() + (range.start() - bd->range().start());
+    if (write)
+        memcpy(host, data, req->getSize());
+    else
+        memcpy(data, host, req->getSize());
+    return true;
+}
+
 Tick
 AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
 {
@@ -298,6 +352,7 @@ AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
             t_info->thread->getIsaPtr()->handleLockedSnoop(pkt,
                     cacheBlockMask);
         }
+        cpu->snoopDecodedInsts(pkt);
     }
 
     return 0;
@@ -325,6 +380,29 @@ AtomicSimpleCPU::AtomicCPUDPort::recvFunctionalSnoop(PacketPtr pkt)
                     cacheBlockMask);
         }
     }
+
+    if (pkt->isInvalidate() || pkt->isWrite())
+        cpu->snoopDecodedInsts(pkt);
+}
+
+void
+AtomicSimpleCPU::snoopDecodedInsts(PacketPtr pkt)
+{
+    if (curEventQueue() == eventQueue())
+        decodedInsts.invalidate(pkt->getAddr(), pkt->getSize());
+    else
+        decodedInsts.requestClear();
+}
+
+void
+AtomicSimpleCPU::sendFunctional(PacketPtr pkt)
+{
+    BaseCPU::sendFunctional(pkt);
+
+    // Writes from system call emulation or loaders are not snooped
+    // back to this CPU.
+    if (pkt->isWrite())
+        decodedInsts.invalidate(pkt->getAddr(), pkt->getSize());
 }
 
 bool
@@ -391,12 +469,19 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t *data, unsigned size,
 
         // Now do the access.
         if (predicate && fault == NoFault &&
-            !req->getFlags().isSet(Request::NO_ACCESS)) {
+            !req->getFlags().isSet(Request::NO_ACCESS) &&
+            dataBackdoorAccess(req, data, false)) {
+            // Read straight from memory, there's no packet to send.
+            dcache_access = true;
+        } else if (predicate && fault == NoFault &&
+                   !req->getFlags().isSet(Request::NO_ACCESS)) {
             Packet pkt(req, Packet::makeReadCmd(req));
             pkt.dataStatic(data);
 
             if (req->isLocalAccess()) {
                 dcache_latency += req->localAccessor(thread->getTC(), &pkt);
+            } else if (canUseDataBackdoor(req)) {
+                dcache_latency += sendPacketForBackdoor(dcachePort, &pkt);
             } else {
                 dcache_latency += sendPacket(dcachePort, &pkt);
             }
@@ -491,7 +576,17 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
                 }
             }
 
-            if (do_access && !req->getFlags().isSet(Request::NO_ACCESS)) {
+            if (do_access && !req->getFlags().isSet(Request::NO_ACCESS) &&
+                dataBackdoorAccess(req, data, true)) {
+                // Other threads still need to see the write.
+                if (numThreads > 1) {
+                    Packet pkt(req, Packet::makeWriteCmd(req));
+                    pkt.dataStatic(data);
+                    threadSnoop(&pkt, curThread);
+                }
+                dcache_access = true;
+            } else if (do_access &&
+                       !req->getFlags().isSet(Request::NO_ACCESS)) {
                 Packet pkt(req, Packet::makeWriteCmd(req));
                 pkt.dataStatic(data);
 
@@ -499,7 +594,9 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
                     dcache_latency +=
                         req->localAccessor(thread->getTC(), &pkt);
                 } else {
-                    dcache_latency += sendPacket(dcachePort, &pkt);
+                    dcache_latency += canUseDataBackdoor(req) ?
+                        sendPacketForBackdoor(dcachePort, &pkt) :
+                        sendPacket(dcachePort, &pkt);
 
                     // Notify other threads on this CPU of write
                     threadSnoop(&pkt, curThread);
@@ -513,6 +610,13 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
                 }
             }
 
+            // Instructions decoded from the written memory are stale
+            // now. Other CPUs see the write through their snoops.
+            if (do_access && !req->getFlags().isSet(Request::NO_ACCESS) &&
+                !req->isLocalAccess()) {
+                decodedInsts.invalidate(req->getPaddr(), req->getSize());
+            }
+
             if (res && !req->isSwap()) {
                 *res = req->getExtraData();
             }
@@ -590,6 +694,7 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
             dcache_latency += req->localAccessor(thread->getTC(), &pkt);
         } else {
             dcache_latency += sendPacket(dcachePort, &pkt);
+            decodedInsts.invalidate(req->getPaddr(), req->getSize());
         }
 
         dcache_access = true;
@@ -665,6 +770,8 @@ AtomicSimpleCPU::tick()
             dcache_access = false; // assume no dcache access
 
             if (needToFetch) {
+                decodedInst = findDecodedInst();
+
                 // This is commented out because the decoder would act like
                 // a tiny cache otherwise. It wouldn't be flushed when needed
                 // like the I cache. It should be flushed, and when that works
@@ -672,9 +779,21 @@ AtomicSimpleCPU::tick()
                 //Fetch more instruction memory if necessary
                 //if (decoder.needMoreBytes())
                 //{
+                // Writes from devices are not snooped when bypassing
+                // caches, so instructions decoded before are fetched
+                // again to check they did not change.
+                if (!decodedInst || system->bypassCaches()) {
                     icache_access = true;
                     icache_latency = fetchInstMem();
+                }
                 //}
+
+                auto &decoder = thread->decoder;
+                if (decodedInst && icache_access &&
+                    !decodedInst->sameData(decoder->moreBytesPtr(),
+                                           decoder->moreBytesSize())) {
+                    decodedInst = nullptr;
+                }
             }
 
             preExecute();
@@ -743,19 +862,78 @@ AtomicSimpleCPU::fetchInstMem()
 {
     auto &decoder = threadInfo[curThread]->thread->decoder;
 
+    if (fastFetch) {
+        AddrRange range = RangeSize(ifetch_req->getPaddr(),
+                                    ifetch_req->getSize());
+        MemBackdoorPtr bd = backdoors.find(BackdoorCache::Fetch, range);
+        if (bd && bd->readable()) {
+            Addr offset = range.start() - bd->range().start();
+            memcpy(decoder->moreBytesPtr(), bd->ptr() + offset,
+                   ifetch_req->getSize());
+            fetchedFromBackdoor = true;
+            return 0;
+        }
+    }
+
+    fetchedFromBackdoor = false;
+
     Packet pkt = Packet(ifetch_req, MemCmd::ReadReq);
 
     // ifetch_req is initialized to read the instruction
     // directly into the CPU object's inst field.
     pkt.dataStatic(decoder->moreBytesPtr());
 
-    Tick latency = sendPacket(icachePort, &pkt);
+    Tick latency = fastFetch ? sendPacketForBackdoor(icachePort, &pkt) :
+        sendPacket(icachePort, &pkt);
     panic_if(pkt.isError(), "Instruction fetch (%s) failed: %s",
             pkt.getAddrRange().to_string(), pkt.print());
 
     return latency;
 }
 
+const DecodedInstCache::Entry *
+AtomicSimpleCPU::findDecodedInst()
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    auto &decoder = t_info.thread->decoder;
+    const PCStateBase &pc = t_info.thread->pcState();
+
+    // Only instructions decoded from a single fetch are kept.
+    cacheDecode = fastFetch && decoder->pureDecode() &&
+        t_info.fetchOffset == 0 && !ifetch_req->isUncacheable();
+    if (!cacheDecode)
+        return nullptr;
+
+    instPaddr = ifetch_req->getPaddr() + (pc.instAddr() & ~decoder->pcMask());
+    return decodedInsts.find(instPaddr, pc);
+}
+
+StaticInstPtr
+AtomicSimpleCPU::decodeFetched(PCStateBase &pc)
+{
+    if (!cacheDecode)
+        return BaseSimpleCPU::decodeFetched(pc);
+
+    if (decodedInst) {
+        pc.update(*decodedInst->nextPC);
+        return decodedInst->inst;
+    }
+
+    // Only keep instructions fetched from plain memory, which is what
+    // the memory hands out backdoors to.
+    if (!fetchedFromBackdoor)
+        return BaseSimpleCPU::decodeFetched(pc);
+
+    std::unique_ptr<PCStateBase> decode_pc(pc.clone());
+    StaticInstPtr inst = BaseSimpleCPU::decodeFetched(pc);
+    if (inst) {
+        auto &decoder = threadInfo[curThread]->thread->decoder;
+        decodedInsts.insert(instPaddr, decoder->moreBytesPtr(),
+                            decoder->moreBytesSize(), *decode_pc, pc, inst);
+    }
+    return inst;
+}
+
 void
 AtomicSimpleCPU::regProbePoints()
 {
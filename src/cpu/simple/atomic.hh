@@ -41,8 +41,11 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include "cpu/simple/backdoor_cache.hh"
 #include "cpu/simple/base.hh"
+#include "cpu/simple/decoded_inst_cache.hh"
 #include "cpu/simple/exec_context.hh"
+#include "mem/backdoor.hh"
 #include "mem/request.hh"
 #include "params/BaseAtomicSimpleCPU.hh"
 #include "sim/probe/probe.hh"
@@ -67,6 +70,18 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     const bool simulate_data_stalls;
     const bool simulate_inst_stalls;
 
+    /**
+     * Whether instructions are fetched straight from memory through the
+     * backdoors it hands out, instead of with a packet per fetch.
+     */
+    const bool fastFetch;
+
+    /**
+     * Whether loads and stores are done straight on memory through the
+     * backdoors it hands out, instead of with a packet per access.
+     */
+    const bool fastDataAccess;
+
     // main simulation loop (one cycle)
     void tick();
 
@@ -106,6 +121,70 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     virtual Tick sendPacket(RequestPort &port, const PacketPtr &pkt);
     virtual Tick fetchInstMem();
 
+    /** Backdoors to memory handed out while accessing it */
+    BackdoorCache backdoors;
+
+    /** Whether the last instruction fetch was done through a backdoor */
+    bool fetchedFromBackdoor;
+
+    /**
+     * Instructions decoded from memory fetched through backdoors, when
+     * fetching that way and the decoder allows reusing them.
+     */
+    DecodedInstCache decodedInsts;
+
+    /**
+     * Whether the instruction being fetched may be found in, or kept
+     * in, decodedInsts.
+     */
+    bool cacheDecode;
+
+    /** Physical PC of the instruction being fetched */
+    Addr instPaddr;
+
+    /** Decoded instruction found for the current fetch, if any */
+    const DecodedInstCache::Entry *decodedInst;
+
+    /**
+     * Look up the instruction being fetched in decodedInsts. Has to be
+     * called once the fetch request is translated.
+     *
+     * @return The instruction, or nullptr if it has to be decoded.
+     */
+    const DecodedInstCache::Entry *findDecodedInst();
+
+    /**
+     * Drop the decoded instructions a snooped write touched. Snoops
+     * from CPUs running on other event queues only ask for all of
+     * them to be dropped, since this CPU may be using them.
+     */
+    void snoopDecodedInsts(PacketPtr pkt);
+
+    StaticInstPtr decodeFetched(PCStateBase &pc) override;
+
+    /**
+     * Send a packet, asking the memory for a backdoor that covers its
+     * address, and keep the backdoor if the memory hands one out.
+     */
+    Tick sendPacketForBackdoor(RequestPort &port, const PacketPtr &pkt);
+
+    /**
+     * Check if a data access may be done through a backdoor. Accesses
+     * with side effects beyond reading or writing the data, like LLSC,
+     * swaps or uncacheable accesses, always get a packet.
+     */
+    bool canUseDataBackdoor(const RequestPtr &req) const;
+
+    /**
+     * Do a data access through a backdoor if there is one covering it.
+     *
+     * @param req Translated request of the access.
+     * @param data Buffer to read into or write from.
+     * @param write Whether the access is a write.
+     * @return Whether the access was done.
+     */
+    bool dataBackdoorAccess(const RequestPtr &req, uint8_t *data, bool write);
+
     /**
      * An AtomicCPUPort overrides the default behaviour of the
      * recvAtomicSnoop and ignores the packet instead of panicking. It
@@ -141,7 +220,7 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     {
 
       public:
-        AtomicCPUDPort(const std::string &_name, BaseSimpleCPU *_cpu)
+        AtomicCPUDPort(const std::string &_name, AtomicSimpleCPU *_cpu)
             : AtomicCPUPort(_name), cpu(_cpu)
         {
             cacheBlockMask = ~(cpu->cacheLineSize() - 1);
@@ -151,7 +230,7 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
         Addr cacheBlockMask;
       protected:
-        BaseSimpleCPU *cpu;
+        AtomicSimpleCPU *cpu;
 
         virtual Tick recvAtomicSnoop(PacketPtr pkt);
         virtual void recvFunctionalSnoop(PacketPtr pkt);
@@ -181,6 +260,8 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     /** Return a reference to the instruction port. */
     Port &getInstPort() override { return icachePort; }
 
+    void sendFunctional(PacketPtr pkt) override;
+
     /** Perform snoop for other cpu-local thread contexts. */
     void threadSnoop(PacketPtr pkt, ThreadID sender);
 
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/backdoor_cache.hh"
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+void
+BackdoorCache::record(MemBackdoorPtr backdoor)
+{
+    // Nothing to do if we already have it.
+    if (backdoors.insert(backdoor->range(), backdoor) == backdoors.end())
+        return;
+
+    backdoor->addInvalidationCallback(
+        [this](const MemBackdoor &bd) { invalidate(bd); });
+}
+
+void
+BackdoorCache::invalidate(const MemBackdoor &backdoor)
+{
+    for (auto &bd: last) {
+        if (bd == &backdoor)
+            bd = nullptr;
+    }
+    for (auto it = backdoors.begin(); it != backdoors.end(); it++) {
+        if (it->second == &backdoor) {
+            backdoors.erase(it);
+            return;
+        }
+    }
+    panic("Got invalidation for unknown memory backdoor.");
+}
+
+} // namespace gem5
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_BACKDOOR_CACHE_HH__
+#define __CPU_SIMPLE_BACKDOOR_CACHE_HH__
+
+#include <array>
+
+#include "base/addr_range.hh"
+#include "base/addr_range_map.hh"
+#include "mem/backdoor.hh"
+
+namespace gem5
+{
+
+/**
+ * The backdoors to memory a CPU was handed out, with the one each kind
+ * of access used last. Consecutive accesses of a kind are likely to use
+ * the same backdoor, so checking it first saves looking up the map.
+ * Backdoors are forgotten as soon as the memory invalidates them.
+ */
+class BackdoorCache
+{
+  public:
+    /** Kinds of accesses that remember their last backdoor */
+    enum Use
+    {
+        Fetch,
+        Data,
+        NumUses
+    };
+
+    BackdoorCache() : last{} {}
+
+    /**
+     * Keep a backdoor to access memory directly from now on, and forget
+     * it when it is invalidated.
+     */
+    void record(MemBackdoorPtr backdoor);
+
+    /**
+     * Find a backdoor that covers a whole range.
+     *
+     * @param use Kind of the access.
+     * @param range Range of the access.
+     * @return The backdoor, or nullptr if none covers the range.
+     */
+    MemBackdoorPtr
+    find(Use use, const AddrRange &range)
+    {
+        MemBackdoorPtr &bd = last[use];
+        if (!bd || !range.isSubset(bd->range())) {
+            auto it = backdoors.contains(range);
+            bd = it == backdoors.end() ? nullptr : it->second;
+        }
+        return bd;
+    }
+
+    /** Number of backdoors kept */
+    size_t size() const { return backdoors.size(); }
+
+  private:
+    /** Forget a backdoor the memory invalidated */
+    void invalidate(const MemBackdoor &backdoor);
+
+    AddrRangeMap<MemBackdoorPtr, 1> backdoors;
+
+    /** Backdoor each kind of access used last, nullptr if none */
+    std::array<MemBackdoorPtr, NumUses> last;
+};
+
+} // namespace gem5
+
+#endif // __CPU_SIMPLE_BACKDOOR_CACHE_HH__
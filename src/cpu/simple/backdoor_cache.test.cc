@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "base/addr_range.hh"
+#include "cpu/simple/backdoor_cache.hh"
+#include "mem/backdoor.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+const auto ReadWrite = (MemBackdoor::Flags)(MemBackdoor::Readable |
+                                            MemBackdoor::Writeable);
+
+} // anonymous namespace
+
+TEST(BackdoorCacheTest, FindsCoveringBackdoor)
+{
+    uint8_t mem[0x2000];
+    MemBackdoor low(AddrRange(0x0, 0x1000), mem, ReadWrite);
+    MemBackdoor high(AddrRange(0x1000, 0x2000), mem + 0x1000, ReadWrite);
+    BackdoorCache cache;
+
+    EXPECT_EQ(cache.find(BackdoorCache::Data, RangeSize(0x10, 8)), nullptr);
+
+    cache.record(&low);
+    cache.record(&high);
+    // Recording a backdoor twice keeps a single copy.
+    cache.record(&low);
+    EXPECT_EQ(cache.size(), 2);
+
+    EXPECT_EQ(cache.find(BackdoorCache::Data, RangeSize(0x10, 8)), &low);
+    EXPECT_EQ(cache.find(BackdoorCache::Fetch, RangeSize(0x1ff8, 8)), &high);
+    EXPECT_EQ(cache.find(BackdoorCache::Data, RangeSize(0x1000, 4)), &high);
+
+    // Accesses straddling two backdoors are not covered by either.
+    EXPECT_EQ(cache.find(BackdoorCache::Data, RangeSize(0xffc, 8)), nullptr);
+    EXPECT_EQ(cache.find(BackdoorCache::Data, RangeSize(0x2000, 4)), nullptr);
+}
+
+TEST(BackdoorCacheTest, ForgetsRevokedBackdoor)
+{
+    uint8_t mem[0x2000];
+    MemBackdoor low(AddrRange(0x0, 0x1000), mem, ReadWrite);
+    MemBackdoor high(AddrRange(0x1000, 0x2000), mem + 0x1000, ReadWrite);
+    BackdoorCache cache;
+
+    cache.record(&low);
+    cache.record(&high);
+
+    // Make the revoked backdoor the last one used by both kinds of
+    // accesses, so that a stale cached pointer would be found first.
+    ASSERT_EQ(cache.find(BackdoorCache::Fetch, RangeSize(0x100, 4)), &low);
+    ASSERT_EQ(cache.find(BackdoorCache::Data, RangeSize(0x200, 8)), &low);
+
+    low.invalidate();
+
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.find(BackdoorCache::Fetch, RangeSize(0x100, 4)), nullptr);
+    EXPECT_EQ(cache.find(BackdoorCache::Data, RangeSize(0x200, 8)), nullptr);
+    EXPECT_EQ(cache.find(BackdoorCache::Data, RangeSize(0x1200, 8)), &high);
+
+    // The memory may hand the backdoor out again once it is valid.
+    cache.record(&low);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.find(BackdoorCache::Fetch, RangeSize(0x100, 4)), &low);
+
+    low.invalidate();
+    high.invalidate();
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(cache.find(BackdoorCache::Data, RangeSize(0x1200, 8)), nullptr);
+}
+
+TEST(BackdoorCacheTest, RevokedBackdoorIsReplaced)
+{
+    uint8_t mem[0x1000];
+    uint8_t moved[0x1000];
+    MemBackdoor old_bd(AddrRange(0x0, 0x1000), mem, ReadWrite);
+    MemBackdoor new_bd(AddrRange(0x0, 0x1000), moved, MemBackdoor::Readable);
+    BackdoorCache cache;
+
+    cache.record(&old_bd);
+    ASSERT_EQ(cache.find(BackdoorCache::Data, RangeSize(0x10, 8)), &old_bd);
+
+    // A backdoor over the same range cannot be kept while the old one is.
+    cache.record(&new_bd);
+    EXPECT_EQ(cache.find(BackdoorCache::Data, RangeSize(0x10, 8)), &old_bd);
+
+    old_bd.invalidate();
+    cache.record(&new_bd);
+    EXPECT_EQ(cache.find(BackdoorCache::Data, RangeSize(0x10, 8)), &new_bd);
+}
@@ -132,6 +132,15 @@ class BaseSimpleCPU : public BaseCPU
 
     std::unique_ptr<PCStateBase> preExecuteTempPC;
 
+    /**
+     * Decode the instruction at the PC from the data fetched for it.
+     *
+     * @param pc PC state to decode with, updated by the decoder.
+     * @return The instruction, or nullptr if the decoder needs more
+     *         data.
+     */
+    virtual StaticInstPtr decodeFetched(PCStateBase &pc);
+
   public:
     void checkForInterrupts();
     void setupFetchRequest(const RequestPtr &req);
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/decoded_inst_cache.hh"
+
+#include <cstring>
+
+#include "base/logging.hh"
+#include "cpu/static_inst.hh"
+
+namespace gem5
+{
+
+DecodedInstCache::DecodedInstCache()
+    : lastPage(nullptr), lastPageNum(0), clearRequested(false)
+{
+}
+
+void
+DecodedInstCache::insert(Addr paddr, const void *bytes, size_t size,
+                         const PCStateBase &pc, const PCStateBase &next_pc,
+                         const StaticInstPtr &inst)
+{
+    panic_if(size > sizeof(Entry::data),
+             "Cannot keep %d bytes of instruction data.", size);
+
+    Addr page_num = paddr / PageBytes;
+    Entry &entry = pages[page_num][paddr];
+    entry.data = 0;
+    std::memcpy(&entry.data, bytes, size);
+    entry.pc.reset(pc.clone());
+    entry.nextPC.reset(next_pc.clone());
+    entry.inst = inst;
+
+    pageFilter.set(page_num % pageFilter.size());
+}
+
+void
+DecodedInstCache::invalidate(Addr paddr, Addr size)
+{
+    if (pages.empty() || size == 0)
+        return;
+
+    for (Addr page_num = paddr / PageBytes;
+         page_num <= (paddr + size - 1) / PageBytes; page_num++) {
+        if (!pageFilter.test(page_num % pageFilter.size()))
+            continue;
+        auto it = pages.find(page_num);
+        if (it == pages.end())
+            continue;
+        if (lastPage == &it->second)
+            lastPage = nullptr;
+        pages.erase(it);
+    }
+
+    if (pages.empty())
+        pageFilter.reset();
+}
+
+void
+DecodedInstCache::clear()
+{
+    pages.clear();
+    lastPage = nullptr;
+    pageFilter.reset();
+    clearRequested.store(false, std::memory_order_relaxed);
+}
+
+size_t
+DecodedInstCache::size() const
+{
+    size_t num = 0;
+    for (const auto &page: pages)
+        num += page.second.size();
+    return num;
+}
+
+} // namespace gem5
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_DECODED_INST_CACHE_HH__
+#define __CPU_SIMPLE_DECODED_INST_CACHE_HH__
+
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+
+#include "arch/generic/pcstate.hh"
+#include "base/types.hh"
+#include "cpu/static_inst_fwd.hh"
+
+namespace gem5
+{
+
+/**
+ * Instructions a CPU decoded, keyed by their physical PC. They are
+ * grouped by the page they were fetched from, so that a write to a
+ * page drops all the instructions decoded from it at once.
+ *
+ * An instruction is only reused when the PC state it is decoded with
+ * equals the one it was first decoded with, so this is only correct
+ * for decoders that only depend on the instruction data and the PC
+ * state (see InstDecoder::pureDecode()).
+ *
+ * Each CPU keeps a cache of its own. Every write the CPU does and
+ * every write it snoops must be passed to invalidate(), since the
+ * cache cannot tell when the instructions it keeps become stale.
+ * Writes snooped while running on the event queue of another CPU
+ * must only call requestClear(), since the CPU may be looking up
+ * the cache at the same time.
+ */
+class DecodedInstCache
+{
+  public:
+    /** A decoded instruction */
+    struct Entry
+    {
+        /** Instruction data it was decoded from */
+        uint64_t data;
+        /** PC state it was decoded with */
+        std::unique_ptr<PCStateBase> pc;
+        /** PC state decoding it left */
+        std::unique_ptr<PCStateBase> nextPC;
+        StaticInstPtr inst;
+
+        /** Whether the instruction data is still the same */
+        bool
+        sameData(const void *bytes, size_t size) const
+        {
+            return std::memcmp(&data, bytes, size) == 0;
+        }
+    };
+
+    /** Size of the pages instructions are grouped by */
+    static constexpr Addr PageBytes = 4096;
+
+    DecodedInstCache();
+
+    DecodedInstCache(const DecodedInstCache &) = delete;
+    DecodedInstCache &operator=(const DecodedInstCache &) = delete;
+
+    /**
+     * Find a decoded instruction.
+     *
+     * @param paddr Physical address of the instruction.
+     * @param pc PC state to decode it with.
+     * @return The instruction, or nullptr if it is not cached or was
+     *         decoded with a different PC state.
+     */
+    const Entry *
+    find(Addr paddr, const PCStateBase &pc)
+    {
+        if (clearRequested.load(std::memory_order_acquire))
+            clear();
+        Page *page = findPage(paddr / PageBytes);
+        if (!page)
+            return nullptr;
+        auto it = page->find(paddr);
+        if (it == page->end() || !it->second.pc->equals(pc))
+            return nullptr;
+        return &it->second;
+    }
+
+    /**
+     * Keep a decoded instruction, replacing any other instruction
+     * decoded at the same address.
+     *
+     * @param paddr Physical address of the instruction.
+     * @param bytes Instruction data it was decoded from.
+     * @param size Size of the instruction data, at most 8 bytes.
+     * @param pc PC state it was decoded with.
+     * @param next_pc PC state decoding it left.
+     * @param inst The decoded instruction.
+     */
+    void insert(Addr paddr, const void *bytes, size_t size,
+                const PCStateBase &pc, const PCStateBase &next_pc,
+                const StaticInstPtr &inst);
+
+    /** Drop the instructions decoded from pages a write touched */
+    void invalidate(Addr paddr, Addr size);
+
+    /** Drop all instructions */
+    void clear();
+
+    /**
+     * Drop all instructions on the next lookup. Unlike the other
+     * methods, this can be called from any thread.
+     */
+    void
+    requestClear()
+    {
+        clearRequested.store(true, std::memory_order_release);
+    }
+
+    /** Number of instructions kept */
+    size_t size() const;
+
+  private:
+    /** Instructions decoded from a page, by physical address */
+    using Page = std::unordered_map<Addr, Entry>;
+
+    Page *
+    findPage(Addr page_num)
+    {
+        if (lastPage && lastPageNum == page_num)
+            return lastPage;
+        auto it = pages.find(page_num);
+        if (it == pages.end())
+            return nullptr;
+        lastPageNum = page_num;
+        lastPage = &it->second;
+        return lastPage;
+    }
+
+    std::unordered_map<Addr, Page> pages;
+
+    /** Page looked up last, nullptr if none */
+    Page *lastPage;
+    Addr lastPageNum;
+
+    /**
+     * Pages that may hold instructions, hashed by page number, so that
+     * most writes do not need to look up the pages at all.
+     */
+    std::bitset<1024> pageFilter;
+
+    /** Whether requestClear() was called since the last lookup */
+    std::atomic<bool> clearRequested;
+};
+
+} // namespace gem5
+
+#endif // __CPU_SIMPLE_DECODED_INST_CACHE_HH__
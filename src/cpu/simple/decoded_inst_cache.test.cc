@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+
+#include "arch/generic/pcstate.hh"
+#include "cpu/simple/decoded_inst_cache.hh"
+#include "cpu/static_inst.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+using PCState = GenericISA::SimplePCState<4>;
+
+const uint32_t Data = 0x00a00513;
+
+} // anonymous namespace
+
+TEST(DecodedInstCacheTest, FindsByPhysicalPCAndPCState)
+{
+    DecodedInstCache cache;
+    PCState pc(0x400000);
+    PCState next_pc(0x400000);
+    next_pc.npc(0x400010);
+
+    EXPECT_EQ(cache.find(0x1000, pc), nullptr);
+
+    cache.insert(0x1000, &Data, sizeof(Data), pc, next_pc, nullptr);
+    EXPECT_EQ(cache.size(), 1);
+
+    auto *entry = cache.find(0x1000, pc);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_TRUE(entry->nextPC->equals(next_pc));
+    EXPECT_TRUE(entry->sameData(&Data, sizeof(Data)));
+    const uint32_t other_data = Data + 1;
+    EXPECT_FALSE(entry->sameData(&other_data, sizeof(other_data)));
+
+    // Other addresses and other PC states miss.
+    EXPECT_EQ(cache.find(0x1004, pc), nullptr);
+    EXPECT_EQ(cache.find(0x2000, pc), nullptr);
+    PCState other_pc(0x400000);
+    other_pc.npc(0x400008);
+    EXPECT_EQ(cache.find(0x1000, other_pc), nullptr);
+}
+
+TEST(DecodedInstCacheTest, InsertReplaces)
+{
+    DecodedInstCache cache;
+    PCState pc(0x400000);
+    PCState other_pc(0x400000);
+    other_pc.npc(0x400008);
+
+    cache.insert(0x1000, &Data, sizeof(Data), pc, pc, nullptr);
+    cache.insert(0x1000, &Data, sizeof(Data), other_pc, other_pc, nullptr);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.find(0x1000, pc), nullptr);
+    EXPECT_NE(cache.find(0x1000, other_pc), nullptr);
+}
+
+TEST(DecodedInstCacheTest, WritesDropWholePages)
+{
+    DecodedInstCache cache;
+    PCState pc(0x400000);
+
+    cache.insert(0x1000, &Data, sizeof(Data), pc, pc, nullptr);
+    cache.insert(0x1ffc, &Data, sizeof(Data), pc, pc, nullptr);
+    cache.insert(0x2000, &Data, sizeof(Data), pc, pc, nullptr);
+    ASSERT_NE(cache.find(0x1000, pc), nullptr);
+
+    // Writes to pages without instructions change nothing.
+    cache.invalidate(0x3000, 8);
+    cache.invalidate(0x0, 0x1000);
+    EXPECT_EQ(cache.size(), 3);
+
+    cache.invalidate(0x1800, 4);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.find(0x1000, pc), nullptr);
+    EXPECT_EQ(cache.find(0x1ffc, pc), nullptr);
+    EXPECT_NE(cache.find(0x2000, pc), nullptr);
+
+    // Writes straddling two pages drop both.
+    cache.insert(0x1ffc, &Data, sizeof(Data), pc, pc, nullptr);
+    cache.invalidate(0x1ffe, 4);
+    EXPECT_EQ(cache.size(), 0);
+
+    // The cache still works once empty.
+    cache.insert(0x2000, &Data, sizeof(Data), pc, pc, nullptr);
+    EXPECT_NE(cache.find(0x2000, pc), nullptr);
+}
+
+TEST(DecodedInstCacheTest, WritesOnlyReachTheirCache)
+{
+    DecodedInstCache cache;
+    DecodedInstCache other;
+    PCState pc(0x400000);
+    cache.insert(0x1000, &Data, sizeof(Data), pc, pc, nullptr);
+    other.insert(0x1000, &Data, sizeof(Data), pc, pc, nullptr);
+
+    cache.invalidate(0x1010, 8);
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(other.size(), 1);
+}
+
+TEST(DecodedInstCacheTest, RequestClearFromOtherThread)
+{
+    DecodedInstCache cache;
+    PCState pc(0x400000);
+    cache.insert(0x1000, &Data, sizeof(Data), pc, pc, nullptr);
+    cache.insert(0x2000, &Data, sizeof(Data), pc, pc, nullptr);
+    ASSERT_NE(cache.find(0x1000, pc), nullptr);
+
+    std::thread other([&cache]() { cache.requestClear(); });
+    other.join();
+
+    // The instructions are dropped on the next lookup.
+    EXPECT_EQ(cache.find(0x2000, pc), nullptr);
+    EXPECT_EQ(cache.size(), 0);
+
+    // Only once.
+    cache.insert(0x1000, &Data, sizeof(Data), pc, pc, nullptr);
+    EXPECT_NE(cache.find(0x1000, pc), nullptr);
+}
+
+TEST(DecodedInstCacheTest, Clear)
+{
+    DecodedInstCache cache;
+    PCState pc(0x400000);
+    cache.insert(0x1000, &Data, sizeof(Data), pc, pc, nullptr);
+    cache.insert(0x2000, &Data, sizeof(Data), pc, pc, nullptr);
+    ASSERT_NE(cache.find(0x1000, pc), nullptr);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(cache.find(0x1000, pc), nullptr);
+}
@@ -65,10 +65,13 @@ class PyTrafficGen(BaseTrafficGen):
     ]
 
     @cxxMethod(override=True)
-    def createTrace(self, duration, trace_file, addr_offset=0):
+    def createTrace(self, duration, trace_file, addr_offset=0, skip_pkts=0):
         if buildEnv["HAVE_PROTOBUF"]:
             return self.getCCObject().createTrace(
-                duration, trace_file, addr_offset=addr_offset
+                duration,
+                trace_file,
+                addr_offset=addr_offset,
+                skip_pkts=skip_pkts,
             )
         else:
             raise NotImplementedError(
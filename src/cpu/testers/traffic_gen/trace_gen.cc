@@ -49,8 +49,9 @@
 namespace gem5
 {
 
-TraceGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
+TraceGen::InputStream::InputStream(const std::string& filename,
+                                   uint64_t skip_pkts)
+    : trace(filename), skipPkts(skip_pkts)
 {
     init();
 }
@@ -66,6 +67,13 @@ TraceGen::InputStream::init()
         panic("Trace was recorded with a different tick frequency %d\n",
               header_msg.tick_freq());
     }
+
+    // Skip packets without parsing them, the trace simply ends if it
+    // has fewer packets than that
+    uint64_t skipped = trace.skip(skipPkts);
+    if (skipped < skipPkts)
+        warn("Trace only has %d packets, cannot skip %d\n", skipped,
+             skipPkts);
 }
 
 void
@@ -126,6 +134,14 @@ TraceGen::enter()
 
     // read the first element in the file and set the complete flag
     traceComplete = !trace.read(nextElement);
+
+    // when starting part way through the trace, play the first packet
+    // right away rather than waiting for the time it was recorded at
+    startTick = 0;
+    if (skipPkts && !traceComplete) {
+        startTick = nextElement.tick;
+        nextElement.tick = 0;
+    }
 }
 
 PacketPtr
@@ -137,6 +153,8 @@ TraceGen::getNextPacket()
 
     // read the next element and set the complete flag
     traceComplete = !trace.read(nextElement);
+    if (!traceComplete)
+        nextElement.tick -= startTick;
 
     // it is the responsibility of the traceComplete flag to ensure we
     // always have a valid element here
@@ -114,14 +114,18 @@ class TraceGen : public BaseGen
         /// Input file stream for the protobuf trace
         ProtoInputStream trace;
 
+        /// Number of packets to skip after the header
+        const uint64_t skipPkts;
+
       public:
 
         /**
          * Create a trace input stream for a given file name.
          *
          * @param filename Path to the file to read from
+         * @param skip_pkts Number of packets to skip at the start
          */
-        InputStream(const std::string& filename);
+        InputStream(const std::string& filename, uint64_t skip_pkts);
 
         /**
          * Reset the stream such that it can be played once
@@ -131,7 +135,7 @@ class TraceGen : public BaseGen
 
         /**
          * Check the trace header to make sure that it is of the right
-         * format.
+         * format, and skip the packets that are not to be played.
          */
         void init();
 
@@ -156,13 +160,19 @@ class TraceGen : public BaseGen
      * @param _duration duration of this state before transitioning
      * @param trace_file File to read the transactions from
      * @param addr_offset Positive offset to add to trace address
+     * @param skip_pkts Number of packets to skip at the start of the
+     *                  trace, which is then played as if it started
+     *                  with the first packet not skipped
      */
     TraceGen(SimObject &obj, RequestorID requestor_id, Tick _duration,
-             const std::string& trace_file, Addr addr_offset)
+             const std::string& trace_file, Addr addr_offset,
+             uint64_t skip_pkts = 0)
         : BaseGen(obj, requestor_id, _duration),
-          trace(trace_file),
+          trace(trace_file, skip_pkts),
           tickOffset(0),
+          startTick(0),
           addrOffset(addr_offset),
+          skipPkts(skip_pkts),
           traceComplete(false)
     {
     }
@@ -196,12 +206,21 @@ class TraceGen : public BaseGen
      */
     mutable Tick tickOffset;
 
+    /**
+     * Time of the first packet played when skipping the start of the
+     * trace, which is subtracted from the times stored in the file.
+     */
+    Tick startTick;
+
     /**
      * Offset for memory requests. Used to shift the trace
      * away from the CPU address space.
      */
     Addr addrOffset;
 
+    /** Number of packets skipped at the start of the trace */
+    const uint64_t skipPkts;
+
     /**
      * Set to true when the trace replay for one instance of
      * state is complete.
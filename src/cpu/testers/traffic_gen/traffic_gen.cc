@@ -165,11 +165,16 @@ TrafficGen::parseConfig()
                 if (mode == "TRACE") {
                     std::string traceFile;
                     Addr addrOffset;
+                    uint64_t skipPkts = 0;
 
                     is >> traceFile >> addrOffset;
+                    // optionally skip the start of the trace
+                    if (!(is >> skipPkts))
+                        skipPkts = 0;
                     traceFile = resolveFile(traceFile);
 
-                    states[id] = createTrace(duration, traceFile, addrOffset);
+                    states[id] = createTrace(duration, traceFile, addrOffset,
+                                             skipPkts);
                     DPRINTF(TrafficGen, "State: %d TraceGen\n", id);
                 } else if (mode == "IDLE") {
                     states[id] = createIdle(duration);
@@ -157,10 +157,7 @@ ThreadContext::compare(ThreadContext *one, ThreadContext *two)
 void
 ThreadContext::sendFunctional(PacketPtr pkt)
 {
-    const auto *port =
-        dynamic_cast<const RequestPort *>(&getCpuPtr()->getDataPort());
-    assert(port);
-    port->sendFunctional(pkt);
+    getCpuPtr()->sendFunctional(pkt);
 }
 
 void
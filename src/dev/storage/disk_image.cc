@@ -32,15 +32,20 @@
 
 #include "dev/storage/disk_image.hh"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/uio.h>
 #include <unistd.h>
 
 #include <cerrno>
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <string>
 
+#include "base/bitfield.hh"
 #include "base/callback.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
@@ -53,12 +58,40 @@
 namespace gem5
 {
 
+std::streampos
+DiskImage::read(uint8_t *data, std::streampos offset, unsigned count) const
+{
+    std::streampos bytes = 0;
+    for (unsigned i = 0; i < count; i++) {
+        std::streampos n =
+            read(data + i * SectorSize, offset + std::streamoff(i));
+        bytes += n;
+        if (n != SectorSize)
+            break;
+    }
+    return bytes;
+}
+
+std::streampos
+DiskImage::write(const uint8_t *data, std::streampos offset, unsigned count)
+{
+    std::streampos bytes = 0;
+    for (unsigned i = 0; i < count; i++) {
+        std::streampos n =
+            write(data + i * SectorSize, offset + std::streamoff(i));
+        bytes += n;
+        if (n != SectorSize)
+            break;
+    }
+    return bytes;
+}
+
 ////////////////////////////////////////////////////////////////////////
 //
 // Raw Disk image
 //
 RawDiskImage::RawDiskImage(const Params &p)
-    : DiskImage(p), disk_size(0)
+    : DiskImage(p), disk_size(0), mapping(nullptr), mappingSize(0)
 {
     open(p.image_file, p.read_only);
 }
@@ -93,15 +126,55 @@ RawDiskImage::open(const std::string &filename, bool rd_only)
         stream.open(file.c_str(), mode);
         if (!stream.is_open())
             panic("Error opening %s", filename);
+
+        map();
     }
 }
 
 void
 RawDiskImage::close()
 {
+    unmap();
     stream.close();
 }
 
+void
+RawDiskImage::map()
+{
+    int fd = ::open(file.c_str(), readonly ? O_RDONLY : O_RDWR);
+    if (fd < 0)
+        return;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        int prot = PROT_READ | (readonly ? 0 : PROT_WRITE);
+        void *addr = mmap(nullptr, st.st_size, prot, MAP_SHARED, fd, 0);
+        if (addr != MAP_FAILED) {
+            mapping = (uint8_t *)addr;
+            mappingSize = st.st_size;
+        } else {
+            warn("Could not map %s, falling back to file I/O: %s",
+                 file, strerror(errno));
+        }
+    }
+
+    // The mapping outlives the descriptor.
+    ::close(fd);
+}
+
+void
+RawDiskImage::unmap()
+{
+    if (!mapping)
+        return;
+
+    if (!readonly)
+        msync(mapping, mappingSize, MS_SYNC);
+    munmap(mapping, mappingSize);
+    mapping = nullptr;
+    mappingSize = 0;
+}
+
 std::streampos
 RawDiskImage::size() const
 {
@@ -117,6 +190,19 @@ RawDiskImage::size() const
 
 std::streampos
 RawDiskImage::read(uint8_t *data, std::streampos offset) const
+{
+    return read(data, offset, 1);
+}
+
+std::streampos
+RawDiskImage::write(const uint8_t *data, std::streampos offset)
+{
+    return write(data, offset, 1);
+}
+
+std::streampos
+RawDiskImage::read(uint8_t *data, std::streampos offset,
+                   unsigned count) const
 {
     if (!initialized)
         panic("RawDiskImage not initialized");
@@ -124,21 +210,34 @@ RawDiskImage::read(uint8_t *data, std::streampos offset) const
     if (!stream.is_open())
         panic("file not open!\n");
 
+    DPRINTF(DiskImageRead, "read: offset=%d count=%d\n",
+            (uint64_t)offset, count);
+
+    if (mapped(offset, count)) {
+        memcpy(data, mapping + (uint64_t)offset * SectorSize,
+               count * SectorSize);
+        DDUMP(DiskImageRead, data, count * SectorSize);
+        return count * SectorSize;
+    }
+
     stream.seekg(offset * SectorSize, std::ios::beg);
     if (!stream.good())
         panic("Could not seek to location in file");
 
-    std::streampos pos = stream.tellg();
-    stream.read((char *)data, SectorSize);
+    stream.read((char *)data, count * SectorSize);
+
+    // A short read at the end of the image leaves the stream failed.
+    std::streampos bytes = stream.gcount();
+    stream.clear();
 
-    DPRINTF(DiskImageRead, "read: offset=%d\n", (uint64_t)offset);
-    DDUMP(DiskImageRead, data, SectorSize);
+    DDUMP(DiskImageRead, data, bytes);
 
-    return stream.tellg() - pos;
+    return bytes;
 }
 
 std::streampos
-RawDiskImage::write(const uint8_t *data, std::streampos offset)
+RawDiskImage::write(const uint8_t *data, std::streampos offset,
+                    unsigned count)
 {
     if (!initialized)
         panic("RawDiskImage not initialized");
@@ -149,15 +248,24 @@ RawDiskImage::write(const uint8_t *data, std::streampos offset)
     if (!stream.is_open())
         panic("file not open!\n");
 
+    DPRINTF(DiskImageWrite, "write: offset=%d count=%d\n",
+            (uint64_t)offset, count);
+    DDUMP(DiskImageWrite, data, count * SectorSize);
+
+    if (mapped(offset, count)) {
+        memcpy(mapping + (uint64_t)offset * SectorSize, data,
+               count * SectorSize);
+        return count * SectorSize;
+    }
+
     stream.seekp(offset * SectorSize, std::ios::beg);
     if (!stream.good())
         panic("Could not seek to location in file");
 
-    DPRINTF(DiskImageWrite, "write: offset=%d\n", (uint64_t)offset);
-    DDUMP(DiskImageWrite, data, SectorSize);
-
     std::streampos pos = stream.tellp();
-    stream.write((const char *)data, SectorSize);
+    stream.write((const char *)data, count * SectorSize);
+    // Make the data visible through the mapping as well.
+    stream.flush();
     return stream.tellp() - pos;
 }
 
@@ -169,7 +277,7 @@ const uint32_t CowDiskImage::VersionMajor = 1;
 const uint32_t CowDiskImage::VersionMinor = 0;
 
 CowDiskImage::CowDiskImage(const Params &p)
-    : DiskImage(p), filename(p.image_file), child(p.child), table(NULL)
+    : DiskImage(p), filename(p.image_file), child(p.child)
 {
     if (filename.empty()) {
         initSectorTable(p.table_size);
@@ -187,13 +295,7 @@ CowDiskImage::CowDiskImage(const Params &p)
 
 CowDiskImage::~CowDiskImage()
 {
-    SectorTable::iterator i = table->begin();
-    SectorTable::iterator end = table->end();
-
-    while (i != end) {
-        delete (*i).second;
-        ++i;
-    }
+    clearChunks();
 }
 
 void
@@ -261,18 +363,18 @@ CowDiskImage::open(const std::string &file)
 
     uint64_t sector_count;
     SafeReadSwap(stream, sector_count);
-    table = new SectorTable(sector_count);
-
+    clearChunks();
 
     for (uint64_t i = 0; i < sector_count; i++) {
         uint64_t offset;
         SafeReadSwap(stream, offset);
 
-        Sector *sector = new Sector;
-        SafeRead(stream, sector, sizeof(Sector));
+        Chunk *chunk = getChunk(offset / ChunkSectors);
+        unsigned idx = offset % ChunkSectors;
+        SafeRead(stream, chunk->data + idx * SectorSize, SectorSize);
 
-        assert(table->find(offset) == table->end());
-        (*table)[offset] = sector;
+        assert(!(chunk->present & (1ULL << idx)));
+        chunk->present |= 1ULL << idx;
     }
 
     stream.close();
@@ -284,11 +386,44 @@ CowDiskImage::open(const std::string &file)
 void
 CowDiskImage::initSectorTable(int hash_size)
 {
-    table = new SectorTable(hash_size);
+    clearChunks();
+    // The table size is a hint of the number of sectors to be written.
+    chunks.reserve(hash_size / ChunkSectors);
 
     initialized = true;
 }
 
+void
+CowDiskImage::clearChunks()
+{
+    for (Chunk *chunk : chunks)
+        delete chunk;
+    chunks.clear();
+}
+
+CowDiskImage::Chunk *
+CowDiskImage::getChunk(uint64_t chunk_num)
+{
+    if (chunk_num >= chunks.size())
+        chunks.resize(chunk_num + 1, nullptr);
+
+    Chunk *&chunk = chunks[chunk_num];
+    if (!chunk)
+        chunk = new Chunk;
+    return chunk;
+}
+
+uint64_t
+CowDiskImage::sectorCount() const
+{
+    uint64_t count = 0;
+    for (const Chunk *chunk : chunks) {
+        if (chunk)
+            count += popCount(chunk->present);
+    }
+    return count;
+}
+
 void
 SafeWrite(std::ofstream &stream, const void *data, int count)
 {
@@ -343,19 +478,22 @@ CowDiskImage::save(const std::string &file) const
 
     SafeWriteSwap(stream, (uint32_t)VersionMajor);
     SafeWriteSwap(stream, (uint32_t)VersionMinor);
-    SafeWriteSwap(stream, (uint64_t)table->size());
+    SafeWriteSwap(stream, sectorCount());
 
-    uint64_t size = table->size();
-    SectorTable::iterator iter = table->begin();
-    SectorTable::iterator end = table->end();
+    // The file keeps the per-sector format, so that images saved with
+    // the chunked table can still be read by older versions.
+    for (uint64_t c = 0; c < chunks.size(); c++) {
+        const Chunk *chunk = chunks[c];
+        if (!chunk)
+            continue;
 
-    for (uint64_t i = 0; i < size; i++) {
-        if (iter == end)
-            panic("Incorrect Table Size during save of COW disk image");
+        for (unsigned idx = 0; idx < ChunkSectors; idx++) {
+            if (!(chunk->present & (1ULL << idx)))
+                continue;
 
-        SafeWriteSwap(stream, (uint64_t)(*iter).first);
-        SafeWrite(stream, (*iter).second->data, sizeof(Sector));
-        ++iter;
+            SafeWriteSwap(stream, (uint64_t)(c * ChunkSectors + idx));
+            SafeWrite(stream, chunk->data + idx * SectorSize, SectorSize);
+        }
     }
 
     stream.close();
@@ -364,12 +502,24 @@ CowDiskImage::save(const std::string &file) const
 void
 CowDiskImage::writeback()
 {
-    SectorTable::iterator i = table->begin();
-    SectorTable::iterator end = table->end();
-
-    while (i != end) {
-        child->write((*i).second->data, (*i).first);
-        ++i;
+    for (uint64_t c = 0; c < chunks.size(); c++) {
+        const Chunk *chunk = chunks[c];
+        if (!chunk)
+            continue;
+
+        // Write each run of written sectors with a single access.
+        unsigned idx = 0;
+        while (idx < ChunkSectors) {
+            if (!(chunk->present & (1ULL << idx))) {
+                idx++;
+                continue;
+            }
+            unsigned first = idx;
+            while (idx < ChunkSectors && (chunk->present & (1ULL << idx)))
+                idx++;
+            child->write(chunk->data + first * SectorSize,
+                         c * ChunkSectors + first, idx - first);
+        }
     }
 }
 
@@ -379,46 +529,99 @@ CowDiskImage::size() const
 
 std::streampos
 CowDiskImage::read(uint8_t *data, std::streampos offset) const
+{
+    return read(data, offset, 1);
+}
+
+std::streampos
+CowDiskImage::write(const uint8_t *data, std::streampos offset)
+{
+    return write(data, offset, 1);
+}
+
+std::streampos
+CowDiskImage::read(uint8_t *data, std::streampos offset,
+                   unsigned count) const
 {
     if (!initialized)
         panic("CowDiskImage not initialized");
 
-    if (offset > size())
+    if ((uint64_t)offset + count > (uint64_t)size())
         panic("access out of bounds");
 
-    SectorTable::const_iterator i = table->find(offset);
-    if (i == table->end())
-        return child->read(data, offset);
-    else {
-        memcpy(data, (*i).second->data, SectorSize);
-        DPRINTF(DiskImageRead, "read: offset=%d\n", (uint64_t)offset);
-        DDUMP(DiskImageRead, data, SectorSize);
-        return SectorSize;
+    std::streampos bytes = 0;
+    uint64_t sector = offset;
+    unsigned done = 0;
+    while (done < count) {
+        uint64_t chunk_num = sector / ChunkSectors;
+        unsigned idx = sector % ChunkSectors;
+        const Chunk *chunk =
+            chunk_num < chunks.size() ? chunks[chunk_num] : nullptr;
+
+        if (chunk && (chunk->present & (1ULL << idx))) {
+            memcpy(data + done * SectorSize, chunk->data + idx * SectorSize,
+                   SectorSize);
+            DPRINTF(DiskImageRead, "read: offset=%d\n", sector);
+            DDUMP(DiskImageRead, data + done * SectorSize, SectorSize);
+            bytes += SectorSize;
+            sector++;
+            done++;
+            continue;
+        }
+
+        // Gather the run of sectors that have not been written, which
+        // may span several chunks, and read it from the child at once.
+        unsigned run = 0;
+        while (done + run < count) {
+            uint64_t s = sector + run;
+            const Chunk *c = s / ChunkSectors < chunks.size() ?
+                chunks[s / ChunkSectors] : nullptr;
+            if (c && (c->present & (1ULL << (s % ChunkSectors))))
+                break;
+            run++;
+        }
+
+        std::streampos n = child->read(data + done * SectorSize, sector, run);
+        bytes += n;
+        if (n != run * SectorSize)
+            break;
+        sector += run;
+        done += run;
     }
+
+    return bytes;
 }
 
 std::streampos
-CowDiskImage::write(const uint8_t *data, std::streampos offset)
+CowDiskImage::write(const uint8_t *data, std::streampos offset,
+                    unsigned count)
 {
     if (!initialized)
         panic("RawDiskImage not initialized");
 
-    if (offset > size())
+    if ((uint64_t)offset + count > (uint64_t)size())
         panic("access out of bounds");
 
-    SectorTable::iterator i = table->find(offset);
-    if (i == table->end()) {
-        Sector *sector = new Sector;
-        memcpy(sector, data, SectorSize);
-        table->insert(make_pair(offset, sector));
-    } else {
-        memcpy((*i).second->data, data, SectorSize);
-    }
+    DPRINTF(DiskImageWrite, "write: offset=%d count=%d\n",
+            (uint64_t)offset, count);
+    DDUMP(DiskImageWrite, data, count * SectorSize);
+
+    uint64_t sector = offset;
+    unsigned done = 0;
+    while (done < count) {
+        Chunk *chunk = getChunk(sector / ChunkSectors);
+        unsigned idx = sector % ChunkSectors;
+        unsigned n = std::min(count - done, ChunkSectors - idx);
 
-    DPRINTF(DiskImageWrite, "write: offset=%d\n", (uint64_t)offset);
-    DDUMP(DiskImageWrite, data, SectorSize);
+        memcpy(chunk->data + idx * SectorSize, data + done * SectorSize,
+               n * SectorSize);
+        chunk->present |= mask(idx + n - 1, idx);
+
+        sector += n;
+        done += n;
+    }
 
-    return SectorSize;
+    return count * SectorSize;
 }
 
 void
@@ -33,8 +33,9 @@
 #ifndef __DEV_STORAGE_DISK_IMAGE_HH__
 #define __DEV_STORAGE_DISK_IMAGE_HH__
 
+#include <cstdint>
 #include <fstream>
-#include <unordered_map>
+#include <vector>
 
 #include "params/CowDiskImage.hh"
 #include "params/DiskImage.hh"
@@ -65,10 +66,39 @@ class DiskImage : public SimObject
                                 std::streampos offset) const = 0;
     virtual std::streampos write(const uint8_t *data,
                                  std::streampos offset) = 0;
+
+    /**
+     * Read a run of consecutive sectors into a single buffer. The
+     * default implementation reads the sectors one at a time; images
+     * that can do better override it.
+     *
+     * @param data Buffer of at least count * SectorSize bytes
+     * @param offset First sector to read
+     * @param count Number of sectors to read
+     * @return Number of bytes read, which is less than
+     *         count * SectorSize if any of the sectors fails
+     */
+    virtual std::streampos read(uint8_t *data, std::streampos offset,
+                                unsigned count) const;
+
+    /**
+     * Write a run of consecutive sectors from a single buffer.
+     *
+     * @param data Buffer of at least count * SectorSize bytes
+     * @param offset First sector to write
+     * @param count Number of sectors to write
+     * @return Number of bytes written
+     */
+    virtual std::streampos write(const uint8_t *data, std::streampos offset,
+                                 unsigned count);
 };
 
 /**
- * Specialization for accessing a raw disk image
+ * Specialization for accessing a raw disk image. The image file is
+ * mapped into memory when possible, so that accesses are plain copies
+ * and the kernel takes care of reading ahead and writing back the
+ * image in the background. Accesses beyond the mapping, or to files
+ * that cannot be mapped, go through a regular file stream.
  */
 class RawDiskImage : public DiskImage
 {
@@ -78,6 +108,22 @@ class RawDiskImage : public DiskImage
     bool readonly;
     mutable std::streampos disk_size;
 
+    /** Memory mapping of the image file, or nullptr if not mapped */
+    uint8_t *mapping;
+    /** Size of the mapping in bytes */
+    size_t mappingSize;
+
+    void map();
+    void unmap();
+
+    /** Whether a run of sectors lies entirely within the mapping */
+    bool
+    mapped(std::streampos offset, unsigned count) const
+    {
+        return mapping &&
+            ((uint64_t)offset + count) * SectorSize <= mappingSize;
+    }
+
   public:
     typedef RawDiskImageParams Params;
     RawDiskImage(const Params &p);
@@ -92,6 +138,10 @@ class RawDiskImage : public DiskImage
 
     std::streampos read(uint8_t *data, std::streampos offset) const override;
     std::streampos write(const uint8_t *data, std::streampos offset) override;
+    std::streampos read(uint8_t *data, std::streampos offset,
+                        unsigned count) const override;
+    std::streampos write(const uint8_t *data, std::streampos offset,
+                         unsigned count) override;
 };
 
 /**
@@ -103,6 +153,11 @@ class RawDiskImage : public DiskImage
  * This object is designed to provide a mechanism for persistant
  * changes to a main disk image, or to provide a place for temporary
  * changes to the image to take place that later may be thrown away.
+ *
+ * Written sectors are kept in chunks of consecutive sectors, found
+ * through a flat index by chunk number, with a bitmap telling which
+ * sectors of each chunk have been written. Runs of sectors that have
+ * not been written are read from the child in a single access.
  */
 class CowDiskImage : public DiskImage
 {
@@ -111,16 +166,25 @@ class CowDiskImage : public DiskImage
     static const uint32_t VersionMinor;
 
   protected:
-    struct Sector
+    /** Number of sectors in a chunk, one per bit of the bitmap */
+    static const unsigned ChunkSectors = 64;
+
+    struct Chunk
     {
-        uint8_t data[SectorSize];
+        uint8_t data[ChunkSectors * SectorSize];
+        /** Bitmap of the sectors in the chunk that have been written */
+        uint64_t present = 0;
     };
-    typedef std::unordered_map<uint64_t, Sector *> SectorTable;
 
   protected:
     std::string filename;
     DiskImage *child;
-    SectorTable *table;
+    /** Written chunks indexed by chunk number, nullptr if none */
+    std::vector<Chunk *> chunks;
+
+    void clearChunks();
+    Chunk *getChunk(uint64_t chunk_num);
+    uint64_t sectorCount() const;
 
   public:
     typedef CowDiskImageParams Params;
@@ -142,6 +206,10 @@ class CowDiskImage : public DiskImage
 
     std::streampos read(uint8_t *data, std::streampos offset) const override;
     std::streampos write(const uint8_t *data, std::streampos offset) override;
+    std::streampos read(uint8_t *data, std::streampos offset,
+                        unsigned count) const override;
+    std::streampos write(const uint8_t *data, std::streampos offset,
+                         unsigned count) override;
 };
 
 void SafeRead(std::ifstream &stream, void *data, int count);
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/gtest/logging.hh"
+#include "dev/storage/disk_image.hh"
+
+using namespace gem5;
+
+namespace gem5
+{
+
+// The images of these tests are never saved at exit.
+void registerExitCallback(const std::function<void()> &callback) {}
+
+} // namespace gem5
+
+namespace
+{
+
+const unsigned NumSectors = 256;
+
+/** Byte j of sector s of the child image */
+uint8_t
+childByte(uint64_t s, unsigned j)
+{
+    return (s * 7 + j) & 0xff;
+}
+
+/** Byte j of sector s as written to the copy-on-write layer */
+uint8_t
+cowByte(uint64_t s, unsigned j)
+{
+    return (s * 13 + j + 0x80) & 0xff;
+}
+
+std::vector<uint8_t>
+sectors(uint64_t first, unsigned count, uint8_t (*byte)(uint64_t, unsigned))
+{
+    std::vector<uint8_t> data(count * SectorSize);
+    for (unsigned i = 0; i < count; i++) {
+        for (unsigned j = 0; j < SectorSize; j++)
+            data[i * SectorSize + j] = byte(first + i, j);
+    }
+    return data;
+}
+
+std::vector<uint8_t>
+readFile(const std::string &file)
+{
+    std::ifstream stream(file, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(stream),
+                                std::istreambuf_iterator<char>());
+}
+
+template <class T>
+void
+append(std::vector<uint8_t> &data, const T &value)
+{
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(value));
+}
+
+/**
+ * A copy-on-write layer on top of a raw image of NumSectors sectors,
+ * which holds a different pattern in every sector.
+ */
+class CowDiskImageTest : public testing::Test
+{
+  protected:
+    char rawFile[32] = "raw-image-XXXXXX";
+    char cowFile[32] = "cow-image-XXXXXX";
+
+    RawDiskImageParams rawParams;
+    CowDiskImageParams cowParams;
+    std::unique_ptr<RawDiskImage> raw;
+    std::unique_ptr<CowDiskImage> cow;
+
+    void
+    SetUp() override
+    {
+        int fd = mkstemp(rawFile);
+        ASSERT_NE(fd, -1);
+        auto data = sectors(0, NumSectors, childByte);
+        ASSERT_EQ(::write(fd, data.data(), data.size()), data.size());
+        ::close(fd);
+
+        fd = mkstemp(cowFile);
+        ASSERT_NE(fd, -1);
+        ::close(fd);
+
+        rawParams.name = "raw";
+        rawParams.image_file = rawFile;
+        rawParams.read_only = false;
+        raw.reset(new RawDiskImage(rawParams));
+
+        cow.reset(new CowDiskImage(cowLayerParams("")));
+    }
+
+    void
+    TearDown() override
+    {
+        cow.reset();
+        raw.reset();
+        unlink(rawFile);
+        unlink(cowFile);
+    }
+
+    /** Parameters of a layer on top of the raw image */
+    const CowDiskImageParams &
+    cowLayerParams(const std::string &file)
+    {
+        cowParams.name = "cow";
+        cowParams.image_file = file;
+        // Not saved on exit
+        cowParams.read_only = true;
+        cowParams.child = raw.get();
+        cowParams.table_size = 65536;
+        return cowParams;
+    }
+
+    void
+    write(uint64_t first, unsigned count)
+    {
+        auto data = sectors(first, count, cowByte);
+        EXPECT_EQ(cow->write(data.data(), first, count), count * SectorSize);
+    }
+
+    /** Contents of the image, with the given sectors written */
+    std::vector<uint8_t>
+    expected(const std::vector<std::pair<uint64_t, unsigned>> &runs)
+    {
+        auto data = sectors(0, NumSectors, childByte);
+        for (const auto &run : runs) {
+            auto written = sectors(run.first, run.second, cowByte);
+            std::copy(written.begin(), written.end(),
+                      data.begin() + run.first * SectorSize);
+        }
+        return data;
+    }
+
+    std::vector<uint8_t>
+    readAll(const DiskImage &image)
+    {
+        std::vector<uint8_t> data(NumSectors * SectorSize);
+        EXPECT_EQ(image.read(data.data(), 0, NumSectors), data.size());
+        return data;
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(CowDiskImageTest, RunsCrossChunkBoundaries)
+{
+    // Across the end of the first chunk, and over a whole chunk
+    write(60, 8);
+    write(100, 100);
+    // A single sector in a chunk of its own
+    write(255, 1);
+
+    auto data = expected({{60, 8}, {100, 100}, {255, 1}});
+    EXPECT_EQ(readAll(*cow), data);
+
+    // Runs starting and ending anywhere mix both images
+    for (uint64_t first : {0, 59, 63, 64, 67, 99, 127, 199}) {
+        unsigned count = NumSectors - first;
+        std::vector<uint8_t> run(count * SectorSize);
+        EXPECT_EQ(cow->read(run.data(), first, count), run.size());
+        EXPECT_TRUE(std::equal(run.begin(), run.end(),
+                               data.begin() + first * SectorSize));
+    }
+
+    // Single sectors too
+    for (uint64_t s = 0; s < NumSectors; s++) {
+        uint8_t sector[SectorSize];
+        EXPECT_EQ(cow->read(sector, s), SectorSize);
+        EXPECT_EQ(std::memcmp(sector, data.data() + s * SectorSize,
+                              SectorSize), 0);
+    }
+
+    // The child is left alone
+    EXPECT_EQ(readAll(*raw), sectors(0, NumSectors, childByte));
+}
+
+TEST_F(CowDiskImageTest, Overwrite)
+{
+    write(10, 100);
+    auto data = sectors(50, 4, childByte);
+    EXPECT_EQ(cow->write(data.data(), 50, 4), data.size());
+
+    auto all = expected({{10, 100}});
+    std::copy(data.begin(), data.end(), all.begin() + 50 * SectorSize);
+    EXPECT_EQ(readAll(*cow), all);
+}
+
+TEST_F(CowDiskImageTest, SaveOpenRoundTrip)
+{
+    write(62, 3);
+    write(200, 1);
+    cow->save(cowFile);
+
+    // The file keeps the per-sector format, with the sectors in order
+    std::vector<uint8_t> file;
+    file.insert(file.end(), "COWDISK!", "COWDISK!" + 8);
+    append(file, (uint32_t)1);
+    append(file, (uint32_t)0);
+    append(file, (uint64_t)4);
+    for (uint64_t s : {62, 63, 64, 200}) {
+        append(file, s);
+        auto data = sectors(s, 1, cowByte);
+        file.insert(file.end(), data.begin(), data.end());
+    }
+    EXPECT_EQ(readFile(cowFile), file);
+
+    // Opening it gives back the same image
+    CowDiskImage opened(cowLayerParams(cowFile));
+    EXPECT_EQ(readAll(opened), expected({{62, 3}, {200, 1}}));
+
+    // And saving it again gives back the same file
+    opened.save(cowFile);
+    EXPECT_EQ(readFile(cowFile), file);
+}
+
+TEST_F(CowDiskImageTest, Writeback)
+{
+    write(0, 1);
+    write(63, 66);
+    write(250, 6);
+    cow->writeback();
+
+    auto data = expected({{0, 1}, {63, 66}, {250, 6}});
+    EXPECT_EQ(readAll(*raw), data);
+    EXPECT_EQ(readAll(*cow), data);
+
+    // Reopening the raw image reads from the file
+    raw.reset();
+    raw.reset(new RawDiskImage(rawParams));
+    EXPECT_EQ(readAll(*raw), data);
+}
+
+TEST_F(CowDiskImageTest, OutOfBounds)
+{
+    auto data = sectors(0, 2, cowByte);
+    EXPECT_ANY_THROW(cow->write(data.data(), NumSectors - 1, 2));
+    EXPECT_ANY_THROW(cow->write(data.data(), NumSectors));
+    EXPECT_ANY_THROW(cow->read(data.data(), NumSectors - 1, 2));
+
+    // Nothing was written
+    EXPECT_EQ(readAll(*cow), sectors(0, NumSectors, childByte));
+
+    // Up to the last sector is fine
+    EXPECT_EQ(cow->write(data.data(), NumSectors - 2, 2), data.size());
+}
@@ -53,6 +53,7 @@
 #include "base/chunk_generator.hh"
 #include "base/compiler.hh"
 #include "base/cprintf.hh" // csprintf
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/IdeDisk.hh"
 #include "dev/storage/disk_image.hh"
@@ -449,15 +450,11 @@ IdeDisk::doDmaRead()
 void
 IdeDisk::dmaReadDone()
 {
-    uint32_t bytesWritten = 0;
-
-    // write the data to the disk image
-    for (bytesWritten = 0; bytesWritten < curPrd.getByteCount();
-         bytesWritten += SectorSize) {
-
-        cmdBytesLeft -= SectorSize;
-        writeDisk(curSector++, (uint8_t *)(dataBuffer + bytesWritten));
-    }
+    // write the data to the disk image in a single transfer
+    unsigned sectors = divCeil(curPrd.getByteCount(), SectorSize);
+    cmdBytesLeft -= sectors * SectorSize;
+    writeDisk(curSector, (uint8_t *)dataBuffer, sectors);
+    curSector += sectors;
 
     // check for the EOT
     if (curPrd.getEOT()) {
@@ -474,18 +471,17 @@ IdeDisk::doDmaDataWrite()
 {
     /** @todo we need to figure out what the delay actually will be */
     Tick totalDiskDelay = diskDelay + (curPrd.getByteCount() / SectorSize);
-    uint32_t bytesRead = 0;
+    unsigned sectors = divCeil(curPrd.getByteCount(), SectorSize);
+    uint32_t bytesRead = sectors * SectorSize;
 
     DPRINTF(IdeDisk, "doDmaWrite, diskDelay: %d totalDiskDelay: %d\n",
             diskDelay, totalDiskDelay);
 
     memset(dataBuffer, 0, MAX_DMA_SIZE);
     assert(cmdBytesLeft <= MAX_DMA_SIZE);
-    while (bytesRead < curPrd.getByteCount()) {
-        readDisk(curSector++, (uint8_t *)(dataBuffer + bytesRead));
-        bytesRead += SectorSize;
-        cmdBytesLeft -= SectorSize;
-    }
+    readDisk(curSector, (uint8_t *)dataBuffer, sectors);
+    curSector += sectors;
+    cmdBytesLeft -= bytesRead;
     DPRINTF(IdeDisk, "doDmaWrite, bytesRead: %d cmdBytesLeft: %d\n",
             bytesRead, cmdBytesLeft);
 
@@ -554,23 +550,23 @@ IdeDisk::dmaWriteDone()
 ///
 
 void
-IdeDisk::readDisk(uint32_t sector, uint8_t *data)
+IdeDisk::readDisk(uint32_t sector, uint8_t *data, unsigned count)
 {
-    uint32_t bytesRead = image->read(data, sector);
+    uint32_t bytesRead = image->read(data, sector, count);
 
-    panic_if(bytesRead != SectorSize,
+    panic_if(bytesRead != count * SectorSize,
             "Can't read from %s. Only %d of %d read. errno=%d",
-            name(), bytesRead, SectorSize, errno);
+            name(), bytesRead, count * SectorSize, errno);
 }
 
 void
-IdeDisk::writeDisk(uint32_t sector, uint8_t *data)
+IdeDisk::writeDisk(uint32_t sector, uint8_t *data, unsigned count)
 {
-    uint32_t bytesWritten = image->write(data, sector);
+    uint32_t bytesWritten = image->write(data, sector, count);
 
-    panic_if(bytesWritten != SectorSize,
+    panic_if(bytesWritten != count * SectorSize,
             "Can't write to %s. Only %d of %d written. errno=%d",
-            name(), bytesWritten, SectorSize, errno);
+            name(), bytesWritten, count * SectorSize, errno);
 }
 
 ////
@@ -0,0 +1,55 @@
+# Copyright (c) 2026 University of Murcia
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.ClockedObject import ClockedObject
+from m5.params import *
+from m5.proxy import *
+
+
+class GpuTraceReplayer(ClockedObject):
+    type = "GpuTraceReplayer"
+    cxx_class = "gem5::GpuTraceReplayer"
+    cxx_header = "gpu-compute/gpu_trace_replayer.hh"
+
+    # Connect the ports in place of the ones of a ComputeUnit. The
+    # coalescer must have using_ruby_tester set, as there are no dynamic
+    # instructions behind the replayed packets, and must be a
+    # VIPERCoalescer, which acknowledges writes with a WriteCompleteResp.
+    port = RequestPort("Port to the GPU coalescer")
+    token_port = RequestPort("Port to the GPU coalescer for sharing tokens")
+
+    system = Param.System(Parent.any, "System the replayer is part of")
+
+    trace_file = Param.String("Trace file written by GpuMemTrace")
+    read_ahead = Param.Unsigned(
+        4096,
+        "Number of instructions read from the trace ahead of their issue",
+    )
+    max_tokens = Param.Int(
+        256,
+        "Maximum number of tokens, i.e., the number of packets that can "
+        "be sent to the coalescer before back-pressure occurs",
+    )
@@ -819,6 +819,19 @@ ComputeUnit::init()
     gmTokenPort.setTokenManager(memPortTokens);
 }
 
+void
+ComputeUnit::regProbePoints()
+{
+    ClockedObject::regProbePoints();
+
+    ppGlobalMemIssue = new ProbePointArg<GPUDynInstPtr>(
+            getProbeManager(), "GlobalMemIssue");
+    ppGlobalMemRequest = new ProbePointArg<PacketPtr>(
+            getProbeManager(), "GlobalMemRequest");
+    ppGlobalMemComplete = new ProbePointArg<GPUDynInstPtr>(
+            getProbeManager(), "GlobalMemComplete");
+}
+
 bool
 ComputeUnit::DataPort::recvTimingResp(PacketPtr pkt)
 {
@@ -1647,6 +1660,10 @@ ComputeUnit::DataPort::processMemReqEvent(PacketPtr pkt)
     GPUDynInstPtr gpuDynInst = sender_state->_gpuDynInst;
     [[maybe_unused]] ComputeUnit *compute_unit = computeUnit;
 
+    if (!pkt->req->systemReq()) {
+        compute_unit->ppGlobalMemRequest->notify(pkt);
+    }
+
     if (pkt->req->systemReq()) {
         assert(compute_unit->shader->systemHub);
         SystemHubEvent *resp_event = new SystemHubEvent(pkt, this);
@@ -57,6 +57,7 @@
 #include "mem/port.hh"
 #include "mem/token_port.hh"
 #include "sim/clocked_object.hh"
+#include "sim/probe/probe.hh"
 
 namespace gem5
 {
@@ -455,6 +456,7 @@ class ComputeUnit : public ClockedObject
     void doSmReturn(GPUDynInstPtr gpuDynInst);
 
     virtual void init() override;
+    void regProbePoints() override;
     void sendRequest(GPUDynInstPtr gpuDynInst, PortID index, PacketPtr pkt);
     void sendScalarRequest(GPUDynInstPtr gpuDynInst, PacketPtr pkt);
     void injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
@@ -473,6 +475,17 @@ class ComputeUnit : public ClockedObject
 
     void handleSQCReturn(PacketPtr pkt);
 
+    /**
+     * Probe points for the vector global memory instructions, notified
+     * when an instruction initiates its access, for every packet it
+     * sends to the memory system, and when its access completes.
+     * @{
+     */
+    ProbePointArg<GPUDynInstPtr> *ppGlobalMemIssue = nullptr;
+    ProbePointArg<PacketPtr> *ppGlobalMemRequest = nullptr;
+    ProbePointArg<GPUDynInstPtr> *ppGlobalMemComplete = nullptr;
+    /** @} */
+
   protected:
     RequestorID _requestorId;
 
@@ -135,6 +135,7 @@ GlobalMemPipeline::exec()
         DPRINTF(GPUMem, "CU%d: WF[%d][%d]: Completing global mem instr %s\n",
                 m->cu_id, m->simdId, m->wfSlotId, m->disassemble());
         m->completeAcc(m);
+        computeUnit.ppGlobalMemComplete->notify(m);
         if (m->isFlat()) {
             w->decLGKMInstsIssued();
         }
@@ -200,6 +201,7 @@ GlobalMemPipeline::exec()
 
         DPRINTF(GPUCoalescer, "initiateAcc for %s seqNum %d\n",
                 mp->disassemble(), mp->seqNum());
+        computeUnit.ppGlobalMemIssue->notify(mp);
         mp->initiateAcc(mp);
 
         if (mp->isStore() && mp->isGlobalSeg()) {
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gpu-compute/gpu_mem_trace.hh"
+
+#include <algorithm>
+#include <string>
+
+#include "base/cast.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/trace.hh"
+#include "debug/GPUMemTrace.hh"
+#include "gpu-compute/compute_unit.hh"
+#include "gpu-compute/gpu_dyn_inst.hh"
+#include "sim/core.hh"
+#include "sim/cur_tick.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+GpuMemTrace::GpuMemTrace(const Params &params)
+    : ProbeListenerObject(params), traceStart(0), traceStream(nullptr)
+{
+    fatal_if(!dynamic_cast<ComputeUnit *>(params.manager),
+             "Manager of %s is not a ComputeUnit.\n", name());
+    fatal_if(params.trace_file == "",
+             "Assign a trace file name to %s.\n", name());
+
+    // Prefix the file name with the listener name, to tell apart the
+    // traces of the compute units
+    const std::string &file = params.trace_file;
+    const size_t base = file.rfind('/') + 1;
+    traceStream = new ProtoOutputStream(simout.resolve(
+        file.substr(0, base) + name() + "." + file.substr(base)));
+
+    ProtoMessage::GpuMemTraceHeader header;
+    header.set_obj_id(name());
+    header.set_tick_freq(sim_clock::Frequency);
+    traceStream->write(header);
+
+    // Write out the instructions still in flight at the end
+    registerExitCallback([this]() { flushTrace(); });
+}
+
+void
+GpuMemTrace::regProbeListeners()
+{
+    traceStart = curTick();
+
+    listeners.push_back(new ProbeListenerArg<GpuMemTrace, GPUDynInstPtr>(
+        this, "GlobalMemIssue", &GpuMemTrace::issue));
+    listeners.push_back(new ProbeListenerArg<GpuMemTrace, PacketPtr>(
+        this, "GlobalMemRequest", &GpuMemTrace::request));
+    listeners.push_back(new ProbeListenerArg<GpuMemTrace, GPUDynInstPtr>(
+        this, "GlobalMemComplete", &GpuMemTrace::complete));
+}
+
+void
+GpuMemTrace::issue(const GPUDynInstPtr &gpu_dyn_inst)
+{
+    // The kernel end release is not executed by the wavefront
+    if (gpu_dyn_inst->isEndOfKernel())
+        return;
+
+    WavefrontState &wf = wavefronts[gpu_dyn_inst->wfDynId];
+    Tick base = std::max({traceStart, wf.lastIssue, wf.lastComplete});
+
+    InstRecord *rec = new InstRecord;
+    rec->msg.set_seq_num(gpu_dyn_inst->seqNum());
+    rec->msg.set_wf_id(gpu_dyn_inst->wfDynId);
+    rec->msg.set_issue_delay(curTick() - base);
+    rec->msg.set_max_pending(wf.numPending);
+    rec->msg.set_mem_sync(gpu_dyn_inst->isMemSync());
+
+    DPRINTF(GPUMemTrace, "Issue seqNum %d wf %d, delay %d, pending %d\n",
+            gpu_dyn_inst->seqNum(), gpu_dyn_inst->wfDynId,
+            rec->msg.issue_delay(), wf.numPending);
+
+    // Memory syncs do not return through the global memory pipeline
+    if (!gpu_dyn_inst->isMemSync())
+        wf.numPending++;
+    wf.lastIssue = curTick();
+    wf.insts.push_back(rec);
+    inflight[gpu_dyn_inst->seqNum()] = rec;
+}
+
+void
+GpuMemTrace::request(const PacketPtr &pkt)
+{
+    auto sender_state =
+        safe_cast<ComputeUnit::DataPort::SenderState *>(pkt->senderState);
+    auto it = inflight.find(sender_state->_gpuDynInst->seqNum());
+    if (it == inflight.end())
+        return;
+
+    InstRecord *rec = it->second;
+    ProtoMessage::GpuMemInst::Access *access = rec->msg.add_access();
+    access->set_cmd(pkt->cmd.toInt());
+    access->set_addr(pkt->getAddr());
+    access->set_size(pkt->getSize());
+    access->set_flags(pkt->req->getFlags());
+    access->set_cc_flags(pkt->req->getCacheCoherenceFlags());
+
+    // A memory sync sends a single packet and is not waited for
+    if (rec->msg.mem_sync()) {
+        rec->done = true;
+        inflight.erase(it);
+        writeDone(wavefronts[rec->msg.wf_id()]);
+    }
+}
+
+void
+GpuMemTrace::complete(const GPUDynInstPtr &gpu_dyn_inst)
+{
+    auto it = inflight.find(gpu_dyn_inst->seqNum());
+    if (it == inflight.end())
+        return;
+
+    InstRecord *rec = it->second;
+    inflight.erase(it);
+    rec->done = true;
+
+    WavefrontState &wf = wavefronts[rec->msg.wf_id()];
+    assert(wf.numPending > 0);
+    wf.numPending--;
+    wf.lastComplete = curTick();
+
+    // Older memory syncs that did not send a packet, e.g., because the
+    // protocol needs none, will not be heard of again
+    for (InstRecord *older : wf.insts) {
+        if (older == rec)
+            break;
+        if (older->msg.mem_sync() && !older->done) {
+            older->done = true;
+            inflight.erase(older->msg.seq_num());
+        }
+    }
+
+    writeDone(wf);
+}
+
+void
+GpuMemTrace::writeDone(WavefrontState &wf)
+{
+    while (!wf.insts.empty() && wf.insts.front()->done) {
+        traceStream->write(wf.insts.front()->msg);
+        delete wf.insts.front();
+        wf.insts.pop_front();
+    }
+}
+
+void
+GpuMemTrace::flushTrace()
+{
+    if (!traceStream)
+        return;
+
+    for (auto &wf : wavefronts) {
+        for (InstRecord *rec : wf.second.insts) {
+            traceStream->write(rec->msg);
+            delete rec;
+        }
+        wf.second.insts.clear();
+    }
+    inflight.clear();
+
+    delete traceStream;
+    traceStream = nullptr;
+}
+
+} // namespace gem5
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a probe listener that captures the global memory
+ * instructions of the wavefronts in a compute unit as a trace that can
+ * be replayed elastically by the GpuTraceReplayer.
+ */
+
+#ifndef __GPU_COMPUTE_GPU_MEM_TRACE_HH__
+#define __GPU_COMPUTE_GPU_MEM_TRACE_HH__
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+
+#include "base/types.hh"
+#include "cpu/inst_seq.hh"
+#include "gpu-compute/misc.hh"
+#include "mem/packet.hh"
+#include "params/GpuMemTrace.hh"
+#include "proto/gpu_mem_trace.pb.h"
+#include "proto/protoio.hh"
+#include "sim/probe/probe.hh"
+
+namespace gem5
+{
+
+/**
+ * The GpuMemTrace listens to the global memory probe points of a
+ * compute unit. For every vector memory instruction it records the
+ * packets the instruction sends to the memory system, how many older
+ * memory instructions of the same wavefront were still in flight when
+ * it issued, and the time it took to issue since the wavefront was
+ * last able to make progress. The records are written out per
+ * wavefront in issue order, once all the older instructions of the
+ * wavefront have been recorded completely.
+ */
+class GpuMemTrace : public ProbeListenerObject
+{
+  public:
+    typedef GpuMemTraceParams Params;
+
+    GpuMemTrace(const Params &params);
+
+    void regProbeListeners() override;
+
+    /** Write out the records that are pending and close the trace. */
+    void flushTrace();
+
+  private:
+    /** A memory instruction that has not been written out yet. */
+    struct InstRecord
+    {
+        ProtoMessage::GpuMemInst msg;
+
+        /** Whether the instruction completed and can be written out */
+        bool done = false;
+    };
+
+    /** Per-wavefront tracing state. */
+    struct WavefrontState
+    {
+        /** Instructions not written out yet, in issue order */
+        std::deque<InstRecord *> insts;
+
+        /** Number of issued instructions still waiting for data */
+        uint32_t numPending = 0;
+
+        /** Tick of the last issue and the last completion */
+        Tick lastIssue = 0;
+        Tick lastComplete = 0;
+    };
+
+    /** Listener for the ComputeUnit GlobalMemIssue probe point. */
+    void issue(const GPUDynInstPtr &gpu_dyn_inst);
+
+    /** Listener for the ComputeUnit GlobalMemRequest probe point. */
+    void request(const PacketPtr &pkt);
+
+    /** Listener for the ComputeUnit GlobalMemComplete probe point. */
+    void complete(const GPUDynInstPtr &gpu_dyn_inst);
+
+    /**
+     * Write out the instructions at the front of a wavefront that are
+     * done, keeping the issue order of the wavefront in the trace.
+     */
+    void writeDone(WavefrontState &wf);
+
+    /** Tracing state of every wavefront seen so far */
+    std::unordered_map<uint64_t, WavefrontState> wavefronts;
+
+    /** Instructions in flight, indexed by sequence number */
+    std::unordered_map<InstSeqNum, InstRecord *> inflight;
+
+    /** Tick tracing started at, the origin of the first delays */
+    Tick traceStart;
+
+    /** Protobuf output stream for the trace */
+    ProtoOutputStream *traceStream;
+};
+
+} // namespace gem5
+
+#endif // __GPU_COMPUTE_GPU_MEM_TRACE_HH__
@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gpu-compute/gpu_trace_replayer.hh"
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "base/amo.hh"
+#include "base/cast.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/GPUMemTrace.hh"
+#include "mem/request.hh"
+#include "sim/core.hh"
+#include "sim/sim_exit.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+GpuTraceReplayer::GpuTraceReplayer(const Params &params)
+    : ClockedObject(params),
+      port(name() + ".port", *this),
+      tokenPort(name() + ".token_port", this),
+      tokenManager(new TokenManager(params.max_tokens)),
+      requestorId(params.system->getRequestorId(this)),
+      lineSize(params.system->cacheLineSize()),
+      readAhead(params.read_ahead),
+      maxTokens(params.max_tokens),
+      traceStream(params.trace_file),
+      traceDone(false),
+      startTick(0),
+      numBuffered(0),
+      numInflight(0),
+      nextSeqNum(1),
+      waitingForTokens(false),
+      tickEvent([this]{ tick(); }, name()),
+      stats(this)
+{
+    fatal_if(readAhead == 0, "%s needs a non-zero read ahead.\n", name());
+
+    ProtoMessage::GpuMemTraceHeader header;
+    fatal_if(!traceStream.read(header),
+             "Could not read the header of trace %s.\n", params.trace_file);
+    fatal_if(header.tick_freq() != sim_clock::Frequency,
+             "Trace %s was recorded with a different tick frequency.\n",
+             params.trace_file);
+
+    tokenPort.setTokenManager(tokenManager);
+}
+
+GpuTraceReplayer::~GpuTraceReplayer()
+{
+    delete tokenManager;
+}
+
+void
+GpuTraceReplayer::init()
+{
+    ClockedObject::init();
+
+    fatal_if(!port.isConnected(), "%s port is not connected.\n", name());
+}
+
+void
+GpuTraceReplayer::startup()
+{
+    startTick = curTick();
+    readTrace();
+    scheduleTick(clockEdge());
+}
+
+Port &
+GpuTraceReplayer::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "port") {
+        return port;
+    } else if (if_name == "token_port") {
+        return tokenPort;
+    } else {
+        return ClockedObject::getPort(if_name, idx);
+    }
+}
+
+bool
+GpuTraceReplayer::readTrace()
+{
+    unsigned buffered = numBuffered;
+
+    while (!traceDone && numBuffered < readAhead) {
+        ProtoMessage::GpuMemInst msg;
+        if (!traceStream.read(msg)) {
+            traceDone = true;
+            break;
+        }
+
+        wavefronts[msg.wf_id()].insts.push_back(msg);
+        activeWfs.insert(msg.wf_id());
+        numBuffered++;
+    }
+
+    return numBuffered != buffered;
+}
+
+void
+GpuTraceReplayer::tick()
+{
+    Tick next_ready = MaxTick;
+    waitingForTokens = false;
+
+    for (auto it = activeWfs.begin(); it != activeWfs.end(); ) {
+        WavefrontState &wf = wavefronts[*it];
+        const ProtoMessage::GpuMemInst &head = wf.insts.front();
+
+        // Wait for older instructions as the traced wavefront did
+        if (!wf.armed && wf.numPending <= head.max_pending()) {
+            wf.armed = true;
+            wf.readyTick = std::max({startTick, wf.lastIssue,
+                                     wf.lastComplete}) + head.issue_delay();
+        }
+
+        if (wf.armed && wf.readyTick <= curTick()) {
+            if (!issue(*it, wf)) {
+                waitingForTokens = true;
+                ++it;
+                continue;
+            }
+            wf.armed = false;
+            wf.insts.pop_front();
+            numBuffered--;
+            // Otherwise look at the next instruction of the wavefront
+            if (wf.insts.empty())
+                it = activeWfs.erase(it);
+            continue;
+        }
+
+        if (wf.armed)
+            next_ready = std::min(next_ready, wf.readyTick);
+        ++it;
+    }
+
+    // Wavefronts that got new instructions are looked at next cycle.
+    // The ones waiting for tokens are looked at when tokens come back.
+    if (readTrace()) {
+        scheduleTick(clockEdge(Cycles(1)));
+    } else if (next_ready != MaxTick) {
+        scheduleTick(std::max(clockEdge(Cycles(1)),
+                              clockEdge(ticksToCycles(
+                                  next_ready - curTick()))));
+    }
+
+    checkDone();
+}
+
+void
+GpuTraceReplayer::scheduleTick(Tick when)
+{
+    if (!tickEvent.scheduled()) {
+        schedule(tickEvent, when);
+    } else if (when < tickEvent.when()) {
+        reschedule(tickEvent, when);
+    }
+}
+
+bool
+GpuTraceReplayer::issue(uint64_t wf_id, WavefrontState &wf)
+{
+    const ProtoMessage::GpuMemInst &msg = wf.insts.front();
+
+    // Merge the plain reads and writes to the same cache line, as the
+    // coalescer sees every packet as an instruction of its own
+    typedef std::tuple<uint32_t, Addr, uint64_t, uint64_t> MergeKey;
+    std::map<MergeKey, std::pair<Addr, Addr>> merged;
+    std::vector<PacketPtr> pkts;
+    int tokens = 0;
+
+    for (const auto &access : msg.access()) {
+        MemCmd cmd(static_cast<MemCmd::Command>(access.cmd()));
+        if (cmd == MemCmd::ReadReq || cmd == MemCmd::WriteReq) {
+            MergeKey key(access.cmd(), roundDown(access.addr(), lineSize),
+                         access.flags(), access.cc_flags());
+            Addr end = access.addr() + access.size();
+            auto it = merged.find(key);
+            if (it == merged.end()) {
+                merged.emplace(key, std::make_pair(access.addr(), end));
+            } else {
+                it->second.first = std::min(it->second.first, access.addr());
+                it->second.second = std::max(it->second.second, end);
+            }
+            continue;
+        }
+
+        Request::Flags flags = access.flags();
+        AtomicOpFunctorPtr amo_op;
+        if (flags.isSet(Request::ATOMIC_RETURN_OP |
+                        Request::ATOMIC_NO_RETURN_OP)) {
+            // Replay atomics as adding zero, the data is not traced
+            amo_op = AtomicOpFunctorPtr(new AtomicOpAdd<uint8_t>(0));
+        }
+
+        auto req = std::make_shared<Request>(access.addr(), access.size(),
+                                             flags, requestorId,
+                                             0, 0, std::move(amo_op));
+        req->setPaddr(access.addr());
+        req->setCacheCoherenceFlags(access.cc_flags());
+
+        PacketPtr pkt = new Packet(req, cmd);
+        if (pkt->hasData())
+            pkt->allocate();
+        pkts.push_back(pkt);
+
+        if (cmd != MemCmd::MemSyncReq && cmd != MemCmd::FlushReq)
+            tokens++;
+    }
+
+    for (const auto &m : merged) {
+        Addr addr = m.second.first;
+        unsigned size = m.second.second - addr;
+        auto req = std::make_shared<Request>(addr, size,
+                                             std::get<2>(m.first),
+                                             requestorId);
+        req->setPaddr(addr);
+        req->setCacheCoherenceFlags(std::get<3>(m.first));
+
+        PacketPtr pkt = new Packet(req, MemCmd(static_cast<MemCmd::Command>(
+                                                   std::get<0>(m.first))));
+        pkt->allocate();
+        pkts.push_back(pkt);
+        tokens++;
+    }
+
+    fatal_if(tokens > maxTokens, "%s needs %d tokens for seqNum %d, more "
+             "than max_tokens.\n", name(), tokens, msg.seq_num());
+
+    if (!tokenPort.haveTokens(tokens)) {
+        for (PacketPtr pkt : pkts)
+            delete pkt;
+        stats.tokenStalls++;
+        return false;
+    }
+    tokenPort.acquireTokens(tokens);
+
+    DPRINTF(GPUMemTrace, "Issue seqNum %d wf %d, %d packets\n",
+            msg.seq_num(), wf_id, pkts.size());
+
+    InflightInst *inst = new InflightInst{wf_id, msg.mem_sync(), curTick(),
+                                          (int)pkts.size()};
+    if (!msg.mem_sync())
+        wf.numPending++;
+    wf.lastIssue = curTick();
+    numInflight++;
+    stats.numInsts++;
+
+    if (pkts.empty()) {
+        completeInst(inst);
+        return true;
+    }
+
+    for (PacketPtr pkt : pkts) {
+        pkt->req->setReqInstSeqNum(nextSeqNum++);
+        pkt->senderState = new SenderState(inst);
+        sendPacket(pkt);
+    }
+    stats.numPackets += pkts.size();
+
+    return true;
+}
+
+void
+GpuTraceReplayer::sendPacket(PacketPtr pkt)
+{
+    if (!blockedPkts.empty() || !port.sendTimingReq(pkt)) {
+        blockedPkts.push_back(pkt);
+    }
+}
+
+void
+GpuTraceReplayer::recvReqRetry()
+{
+    stats.numRetries++;
+
+    while (!blockedPkts.empty() && port.sendTimingReq(blockedPkts.front())) {
+        blockedPkts.pop_front();
+    }
+}
+
+void
+GpuTraceReplayer::recvTokens()
+{
+    if (waitingForTokens) {
+        waitingForTokens = false;
+        scheduleTick(clockEdge());
+    }
+}
+
+bool
+GpuTraceReplayer::recvTimingResp(PacketPtr pkt)
+{
+    // Writes complete with the WriteCompleteResp that follows, which
+    // carries the same sender state
+    if (pkt->cmd == MemCmd::WriteResp) {
+        delete pkt;
+        return true;
+    }
+
+    SenderState *sender_state = safe_cast<SenderState *>(pkt->senderState);
+    InflightInst *inst = sender_state->inst;
+    delete sender_state;
+    delete pkt;
+
+    if (--inst->remaining == 0)
+        completeInst(inst);
+
+    return true;
+}
+
+void
+GpuTraceReplayer::completeInst(InflightInst *inst)
+{
+    WavefrontState &wf = wavefronts[inst->wfId];
+    if (!inst->memSync) {
+        assert(wf.numPending > 0);
+        wf.numPending--;
+        wf.lastComplete = curTick();
+    }
+
+    stats.instLatency.sample(curTick() - inst->issueTick);
+    numInflight--;
+    delete inst;
+
+    scheduleTick(clockEdge());
+}
+
+void
+GpuTraceReplayer::checkDone()
+{
+    if (traceDone && activeWfs.empty() && numInflight == 0) {
+        inform("%s: End of trace reached.\n", name());
+        exitSimLoop("End of GPU memory trace reached");
+    }
+}
+
+bool
+GpuTraceReplayer::ReplayPort::recvTimingResp(PacketPtr pkt)
+{
+    return replayer.recvTimingResp(pkt);
+}
+
+void
+GpuTraceReplayer::ReplayPort::recvReqRetry()
+{
+    replayer.recvReqRetry();
+}
+
+void
+GpuTraceReplayer::ReplayTokenPort::recvTokens(int num_tokens)
+{
+    TokenRequestPort::recvTokens(num_tokens);
+    replayer.recvTokens();
+}
+
+GpuTraceReplayer::GpuTraceReplayerStats::GpuTraceReplayerStats(
+    statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(numInsts, statistics::units::Count::get(),
+               "Number of memory instructions replayed"),
+      ADD_STAT(numPackets, statistics::units::Count::get(),
+               "Number of packets sent to the coalescer"),
+      ADD_STAT(numRetries, statistics::units::Count::get(),
+               "Number of retries from the coalescer"),
+      ADD_STAT(tokenStalls, statistics::units::Count::get(),
+               "Number of times an instruction waited for tokens"),
+      ADD_STAT(instLatency, statistics::units::Tick::get(),
+               "Ticks from the issue to the completion of an instruction")
+{
+    instLatency.init(16);
+}
+
+} // namespace gem5
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a requestor that replays the global memory traces
+ * captured by the GpuMemTrace probe listener through a GPU coalescer.
+ */
+
+#ifndef __GPU_COMPUTE_GPU_TRACE_REPLAYER_HH__
+#define __GPU_COMPUTE_GPU_TRACE_REPLAYER_HH__
+
+#include <cstdint>
+#include <deque>
+#include <set>
+#include <unordered_map>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "cpu/inst_seq.hh"
+#include "mem/packet.hh"
+#include "mem/port.hh"
+#include "mem/token_port.hh"
+#include "params/GpuTraceReplayer.hh"
+#include "proto/gpu_mem_trace.pb.h"
+#include "proto/protoio.hh"
+#include "sim/clocked_object.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+/**
+ * The GpuTraceReplayer reads a trace written by GpuMemTrace and sends
+ * the memory instructions of every wavefront to a GPU coalescer, in
+ * place of a compute unit. The replay is elastic: an instruction
+ * issues once no more older instructions of its wavefront are waiting
+ * for data than when it was traced, and then only after the recorded
+ * issue delay has elapsed since the wavefront was last able to make
+ * progress. The memory system under study hence determines when the
+ * wavefronts issue, rather than the timing of the traced run.
+ *
+ * The coalescer must be configured as if driven by the Ruby tester,
+ * as the replayer has no dynamic instructions to hand over. Each
+ * packet is then a separate instruction to the coalescer, so the
+ * replayer merges the accesses of a traced instruction to the same
+ * cache line into one packet.
+ */
+class GpuTraceReplayer : public ClockedObject
+{
+  public:
+    typedef GpuTraceReplayerParams Params;
+
+    GpuTraceReplayer(const Params &params);
+    ~GpuTraceReplayer();
+
+    void init() override;
+    void startup() override;
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+
+  private:
+    class ReplayPort : public RequestPort
+    {
+      public:
+        ReplayPort(const std::string &_name, GpuTraceReplayer &_replayer)
+            : RequestPort(_name), replayer(_replayer)
+        {}
+
+      protected:
+        bool recvTimingResp(PacketPtr pkt) override;
+        void recvReqRetry() override;
+
+      private:
+        GpuTraceReplayer &replayer;
+    };
+
+    class ReplayTokenPort : public TokenRequestPort
+    {
+      public:
+        ReplayTokenPort(const std::string &_name,
+                        GpuTraceReplayer *_replayer)
+            : TokenRequestPort(_name, _replayer), replayer(*_replayer)
+        {}
+
+        void recvTokens(int num_tokens) override;
+
+      protected:
+        bool recvTimingResp(PacketPtr) override { return false; }
+        void recvReqRetry() override {}
+
+      private:
+        GpuTraceReplayer &replayer;
+    };
+
+    /** A replayed instruction waiting for its packets to complete. */
+    struct InflightInst
+    {
+        uint64_t wfId;
+        bool memSync;
+        Tick issueTick;
+        int remaining;
+    };
+
+    struct SenderState : public Packet::SenderState
+    {
+        SenderState(InflightInst *_inst) : inst(_inst) {}
+        InflightInst *inst;
+    };
+
+    /** Per-wavefront replay state. */
+    struct WavefrontState
+    {
+        /** Instructions read from the trace and not issued yet */
+        std::deque<ProtoMessage::GpuMemInst> insts;
+
+        /** Number of issued instructions still waiting for data */
+        uint32_t numPending = 0;
+
+        /** Tick of the last issue and the last completion */
+        Tick lastIssue = 0;
+        Tick lastComplete = 0;
+
+        /**
+         * Whether the instruction at the front may issue once the
+         * ready tick is reached.
+         */
+        bool armed = false;
+        Tick readyTick = 0;
+    };
+
+    /**
+     * Read records until the read-ahead window is full.
+     *
+     * @return True if any record was read
+     */
+    bool readTrace();
+
+    /** Issue the instructions that are ready and plan the next tick. */
+    void tick();
+
+    /** Make sure the tick event happens no later than the given tick. */
+    void scheduleTick(Tick when);
+
+    /**
+     * Create the packets for the instruction at the front of a
+     * wavefront and send them, if the coalescer has room for them.
+     *
+     * @return True if the instruction was issued
+     */
+    bool issue(uint64_t wf_id, WavefrontState &wf);
+
+    /** Send a packet, or queue it until the coalescer asks for it. */
+    void sendPacket(PacketPtr pkt);
+
+    bool recvTimingResp(PacketPtr pkt);
+    void recvReqRetry();
+
+    /** Called when the coalescer returns tokens. */
+    void recvTokens();
+
+    /** Called once all the packets of an instruction completed. */
+    void completeInst(InflightInst *inst);
+
+    /** Exit the simulation loop if the whole trace was replayed. */
+    void checkDone();
+
+    ReplayPort port;
+    ReplayTokenPort tokenPort;
+    TokenManager *tokenManager;
+
+    const RequestorID requestorId;
+    const Addr lineSize;
+    const unsigned readAhead;
+    const int maxTokens;
+
+    ProtoInputStream traceStream;
+    bool traceDone;
+
+    /** Tick the replay started at, the origin of the first delays */
+    Tick startTick;
+
+    std::unordered_map<uint64_t, WavefrontState> wavefronts;
+
+    /** Wavefronts with instructions left to issue */
+    std::set<uint64_t> activeWfs;
+
+    /** Number of instructions read from the trace and not issued */
+    unsigned numBuffered;
+
+    /** Number of issued instructions that did not complete */
+    unsigned numInflight;
+
+    /** Sequence number of the next packet sent to the coalescer */
+    InstSeqNum nextSeqNum;
+
+    /**
+     * Whether a wavefront is waiting for tokens, to be looked at again
+     * once the coalescer returns some
+     */
+    bool waitingForTokens;
+
+    /** Packets the coalescer refused, in the order they were sent */
+    std::deque<PacketPtr> blockedPkts;
+
+    EventFunctionWrapper tickEvent;
+
+    struct GpuTraceReplayerStats : public statistics::Group
+    {
+        GpuTraceReplayerStats(statistics::Group *parent);
+
+        statistics::Scalar numInsts;
+        statistics::Scalar numPackets;
+        statistics::Scalar numRetries;
+        statistics::Scalar tokenStalls;
+        statistics::Histogram instLatency;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __GPU_COMPUTE_GPU_TRACE_REPLAYER_HH__
@@ -39,8 +39,13 @@ class ThreadBridge(SimObject):
     the issue. The receiver side is expected to use the same EventQueue that
     the ThreadBridge is using.
 
-    Given that this is only used for simulation speed accelerating, only the
-    atomic and functional access are supported.
+    Atomic and functional accesses migrate to the other EventQueue and are
+    carried out immediately. Functional accesses also check the timing
+    packets inside the bridge. Timing accesses are handed over to the other
+    EventQueue after a fixed delay, which must be at least the simulation
+    quantum (Root.sim_quantum) when the EventQueues run in parallel. Packets
+    are buffered on the receiving side until they can be sent, so the bridge
+    never refuses a request or a response.
 
     Example:
 
@@ -58,3 +63,9 @@ class ThreadBridge(SimObject):
 
     in_port = ResponsePort("Incoming port")
     out_port = RequestPort("Outgoing port")
+
+    delay = Param.Latency(
+        "0ns",
+        "Latency of a timing access crossing, or 0 for the minimum, i.e. "
+        "the simulation quantum when the EventQueues run in parallel",
+    )
@@ -36,8 +36,10 @@
 #include <climits>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <string>
 
+#include "base/bitfield.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/CacheComp.hh"
@@ -118,12 +120,17 @@ Base::toChunks(const uint64_t* data) const
         (sizeof(uint64_t) * CHAR_BIT) / chunkSizeBits;
 
     // Turn a 64-bit array into a chunkSizeBits-array
-    std::vector<Chunk> chunks((blkSize * CHAR_BIT) / chunkSizeBits, 0);
-    for (int i = 0; i < chunks.size(); i++) {
-        const int index_64 = std::floor(i / (double)num_chunks_per_64);
+    std::vector<Chunk> chunks((blkSize * CHAR_BIT) / chunkSizeBits);
+    if (num_chunks_per_64 == 1) {
+        std::copy(data, data + chunks.size(), chunks.begin());
+        return chunks;
+    }
+
+    const uint64_t chunk_mask = mask(chunkSizeBits);
+    for (std::size_t i = 0; i < chunks.size(); i++) {
         const unsigned start = i % num_chunks_per_64;
-        chunks[i] = bits(data[index_64],
-            (start + 1) * chunkSizeBits - 1, start * chunkSizeBits);
+        chunks[i] = (data[i / num_chunks_per_64] >> (start * chunkSizeBits)) &
+            chunk_mask;
     }
 
     return chunks;
@@ -137,12 +144,17 @@ Base::fromChunks(const std::vector<Chunk>& chunks, uint64_t* data) const
         (sizeof(uint64_t) * CHAR_BIT) / chunkSizeBits;
 
     // Turn a chunkSizeBits-array into a 64-bit array
+    if (num_chunks_per_64 == 1) {
+        std::copy(chunks.begin(), chunks.end(), data);
+        return;
+    }
+
+    const uint64_t chunk_mask = mask(chunkSizeBits);
     std::memset(data, 0, blkSize);
-    for (int i = 0; i < chunks.size(); i++) {
-        const int index_64 = std::floor(i / (double)num_chunks_per_64);
+    for (std::size_t i = 0; i < chunks.size(); i++) {
         const unsigned start = i % num_chunks_per_64;
-        replaceBits(data[index_64], (start + 1) * chunkSizeBits - 1,
-            start * chunkSizeBits, chunks[i]);
+        data[i / num_chunks_per_64] |=
+            (chunks[i] & chunk_mask) << (start * chunkSizeBits);
     }
 }
 
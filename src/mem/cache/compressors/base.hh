@@ -41,6 +41,7 @@
 #include "base/compiler.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
+#include "mem/cache/compressors/object_pool.hh"
 #include "sim/sim_object.hh"
 
 namespace gem5
@@ -261,6 +262,23 @@ class Base::CompressionData
      */
     virtual ~CompressionData();
 
+    /**
+     * A compression data object is created for every compressed line, and
+     * is discarded as soon as its size has been read, so it is recycled
+     * through the compressors' object pool.
+     */
+    static void*
+    operator new(std::size_t size)
+    {
+        return ObjectPool::allocate(size);
+    }
+
+    static void
+    operator delete(void* ptr, std::size_t size)
+    {
+        ObjectPool::deallocate(ptr, size);
+    }
+
     /**
      * Set compression size (in bits).
      *
@@ -106,6 +106,12 @@ class BaseDelta : public DictionaryCompressor<BaseType>
         return PatternFactory::getPattern(bytes, dict_bytes, match_location);
     }
 
+    std::size_t
+    getMinPatternSizeBits() const override
+    {
+        return PatternFactory::getMinSizeBits();
+    }
+
     std::string
     getName(int number) const override
     {
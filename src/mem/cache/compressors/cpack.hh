@@ -101,6 +101,12 @@ class CPack : public DictionaryCompressor<uint32_t>
         return PatternFactory::getPattern(bytes, dict_bytes, match_location);
     }
 
+    std::size_t
+    getMinPatternSizeBits() const override
+    {
+        return PatternFactory::getMinSizeBits();
+    }
+
     void addToDictionary(DictionaryEntry data) override;
 
   public:
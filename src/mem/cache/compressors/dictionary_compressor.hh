@@ -43,6 +43,7 @@
 #ifndef __MEM_CACHE_COMPRESSORS_DICTIONARY_COMPRESSOR_HH__
 #define __MEM_CACHE_COMPRESSORS_DICTIONARY_COMPRESSOR_HH__
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <map>
@@ -55,6 +56,7 @@
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "mem/cache/compressors/base.hh"
+#include "mem/cache/compressors/object_pool.hh"
 
 namespace gem5
 {
@@ -167,6 +169,22 @@ class DictionaryCompressor : public BaseDictionaryCompressor
                                                     match_location);
             }
         }
+
+        /**
+         * Get the smallest size any of the patterns can have. The size of a
+         * pattern does not depend on the data it encodes, so it is computed
+         * only once.
+         *
+         * @return The lower bound of the size of a pattern, in bits.
+         */
+        static std::size_t
+        getMinSizeBits()
+        {
+            static const std::size_t min_size_bits = std::min(
+                Head(DictionaryEntry(), 0).getSizeBits(),
+                Factory<Tail...>::getMinSizeBits());
+            return min_size_bits;
+        }
     };
 
     /**
@@ -188,6 +206,12 @@ class DictionaryCompressor : public BaseDictionaryCompressor
         {
             return std::unique_ptr<Pattern>(new Head(bytes, match_location));
         }
+
+        static std::size_t
+        getMinSizeBits()
+        {
+            return Head(DictionaryEntry(), 0).getSizeBits();
+        }
     };
 
     /** The dictionary. */
@@ -202,6 +226,14 @@ class DictionaryCompressor : public BaseDictionaryCompressor
     getPattern(const DictionaryEntry& bytes, const DictionaryEntry& dict_bytes,
         const int match_location) const = 0;
 
+    /**
+     * Get the smallest size a pattern of the sub-class' factory can have.
+     * Used to stop searching the dictionary once no better match can exist.
+     *
+     * @return The lower bound of the size of a pattern, in bits.
+     */
+    virtual std::size_t getMinPatternSizeBits() const = 0;
+
     /**
      * Compress data.
      *
@@ -325,6 +357,23 @@ class DictionaryCompressor<T>::Pattern
     /** Default destructor. */
     virtual ~Pattern() = default;
 
+    /**
+     * Patterns are created for every chunk, and for every dictionary entry
+     * probed while compressing it, so they are recycled through the object
+     * pool as well.
+     */
+    static void*
+    operator new(std::size_t size)
+    {
+        return ObjectPool::allocate(size);
+    }
+
+    static void
+    operator delete(void* ptr, std::size_t size)
+    {
+        ObjectPool::deallocate(ptr, size);
+    }
+
     /**
      * Get enum number associated to this pattern.
      *
@@ -34,6 +34,7 @@
 #define __MEM_CACHE_COMPRESSORS_DICTIONARY_COMPRESSOR_IMPL_HH__
 
 #include <algorithm>
+#include <cstring>
 
 #include "base/trace.hh"
 #include "debug/CacheComp.hh"
@@ -102,8 +103,12 @@ DictionaryCompressor<T>::compressValue(const T data)
     std::unique_ptr<Pattern> pattern =
         getPattern(bytes, toDictionaryEntry(0), -1);
 
-    // Search for word on dictionary
-    for (std::size_t i = 0; i < numEntries; i++) {
+    // Search for word on dictionary. A match is only taken if it is strictly
+    // smaller than the current one, so once the current pattern has the
+    // smallest possible size the remaining entries cannot improve it
+    const std::size_t min_size_bits = getMinPatternSizeBits();
+    for (std::size_t i = 0;
+         (i < numEntries) && (pattern->getSizeBits() > min_size_bits); i++) {
         // Try matching input with possible patterns
         std::unique_ptr<Pattern> temp_pattern =
             getPattern(bytes, dictionary[i], i);
@@ -137,6 +142,7 @@ DictionaryCompressor<T>::compress(const std::vector<Chunk>& chunks)
 
     // Compress every value sequentially
     CompData* const comp_data_ptr = static_cast<CompData*>(comp_data.get());
+    comp_data_ptr->entries.reserve(chunks.size());
     for (const auto& value : chunks) {
         std::unique_ptr<Pattern> pattern = compressValue(value);
         DPRINTF(CacheComp, "Compressed %016x to %s\n", value,
@@ -192,24 +198,18 @@ DictionaryCompressor<T>::decompress(const CompressionData* comp_data,
     // Reset dictionary
     resetDictionary();
 
-    // Decompress every entry sequentially
-    std::vector<T> decomp_values;
+    // Decompress every entry sequentially, concatenating the decompressed
+    // values to generate the original data
+    const std::size_t values_per_entry = sizeof(uint64_t)/sizeof(T);
+    std::memset(data, 0, blkSize);
+    std::size_t i = 0;
     for (const auto& entry : casted_comp_data->entries) {
         const T value = decompressValue(&*entry);
-        decomp_values.push_back(value);
+        data[i / values_per_entry] |= static_cast<uint64_t>(value) <<
+            ((i % values_per_entry) * 8 * sizeof(T));
+        i++;
         DPRINTF(CacheComp, "Decompressed %s to %x\n", entry->print(), value);
     }
-
-    // Concatenate the decompressed values to generate the original data
-    for (std::size_t i = 0; i < blkSize/8; i++) {
-        data[i] = 0;
-        const std::size_t values_per_entry = sizeof(uint64_t)/sizeof(T);
-        for (int j = values_per_entry - 1; j >= 0; j--) {
-            data[i] |=
-                static_cast<uint64_t>(decomp_values[values_per_entry*i+j]) <<
-                (j*8*sizeof(T));
-        }
-    }
 }
 
 template <class T>
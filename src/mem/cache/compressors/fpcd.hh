@@ -142,6 +142,12 @@ class FPCD : public DictionaryCompressor<uint32_t>
         return PatternFactory::getPattern(bytes, dict_bytes, match_location);
     }
 
+    std::size_t
+    getMinPatternSizeBits() const override
+    {
+        return PatternFactory::getMinSizeBits();
+    }
+
     void addToDictionary(DictionaryEntry data) override;
 
   public:
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/compressors/object_pool.hh"
+
+#include <new>
+
+namespace gem5
+{
+
+namespace compression
+{
+
+thread_local ObjectPool::FreeBlock*
+    ObjectPool::freeLists[MaxSize / Granularity] = {};
+
+void*
+ObjectPool::allocate(std::size_t size)
+{
+    if (size == 0 || size > MaxSize) {
+        return ::operator new(size);
+    }
+
+    const std::size_t size_class = sizeClass(size);
+    FreeBlock* block = freeLists[size_class];
+    if (block == nullptr) {
+        return ::operator new((size_class + 1) * Granularity);
+    }
+    freeLists[size_class] = block->next;
+    return block;
+}
+
+void
+ObjectPool::deallocate(void* ptr, std::size_t size)
+{
+    if (ptr == nullptr) {
+        return;
+    }
+    if (size == 0 || size > MaxSize) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    const std::size_t size_class = sizeClass(size);
+    block->next = freeLists[size_class];
+    freeLists[size_class] = block;
+}
+
+} // namespace compression
+} // namespace gem5
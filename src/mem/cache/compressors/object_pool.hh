@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ * Free lists for the short-lived objects created on every compression.
+ */
+
+#ifndef __MEM_CACHE_COMPRESSORS_OBJECT_POOL_HH__
+#define __MEM_CACHE_COMPRESSORS_OBJECT_POOL_HH__
+
+#include <cstddef>
+
+namespace gem5
+{
+
+namespace compression
+{
+
+/**
+ * Every compressed line creates a compression data object, and dictionary
+ * compressors also create a pattern for each chunk and each dictionary
+ * entry they probe. These objects only live until the compression size is
+ * known, so instead of going through the heap each time they are recycled
+ * through one free list per size class. Blocks are never given back to the
+ * heap, which bounds the memory used to the peak number of live objects.
+ *
+ * Classes opt in by forwarding their operator new and operator delete
+ * here. The free lists are per thread, so simulations with several event
+ * queues do not need any locking.
+ */
+class ObjectPool
+{
+  public:
+    /** Sizes are rounded up to a multiple of this, keeping alignment. */
+    static constexpr std::size_t Granularity = alignof(std::max_align_t);
+
+    /** Larger objects go straight to the heap. */
+    static constexpr std::size_t MaxSize = 256;
+
+    /**
+     * Get a block of at least the given size.
+     *
+     * @param size Size of the object, in bytes.
+     * @return The block.
+     */
+    static void* allocate(std::size_t size);
+
+    /**
+     * Give a block back to the pool.
+     *
+     * @param ptr The block, as returned by allocate().
+     * @param size The size that was passed to allocate() for it.
+     */
+    static void deallocate(void* ptr, std::size_t size);
+
+  private:
+    /** A free block links to the next free block of the same size class. */
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    /** The heads of the free lists, indexed by size class. */
+    static thread_local FreeBlock* freeLists[MaxSize / Granularity];
+
+    static std::size_t
+    sizeClass(std::size_t size)
+    {
+        return (size - 1) / Granularity;
+    }
+};
+
+} // namespace compression
+} // namespace gem5
+
+#endif //__MEM_CACHE_COMPRESSORS_OBJECT_POOL_HH__
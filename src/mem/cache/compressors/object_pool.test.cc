@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "mem/cache/compressors/object_pool.hh"
+
+using namespace gem5;
+using namespace gem5::compression;
+
+namespace
+{
+
+/** A polymorphic object that opts into the pool, as patterns do */
+struct PooledBase
+{
+    uint64_t value = 0;
+
+    virtual ~PooledBase() = default;
+
+    static void*
+    operator new(std::size_t size)
+    {
+        return ObjectPool::allocate(size);
+    }
+
+    static void
+    operator delete(void* ptr, std::size_t size)
+    {
+        ObjectPool::deallocate(ptr, size);
+    }
+};
+
+/** A derived object of a larger size class */
+struct PooledDerived : public PooledBase
+{
+    uint64_t extra[8] = {};
+};
+
+} // anonymous namespace
+
+/** Freed blocks are handed out again for objects of the same size class */
+TEST(ObjectPoolTest, ReusesFreedBlocks)
+{
+    void* first = ObjectPool::allocate(24);
+    void* second = ObjectPool::allocate(24);
+    ASSERT_NE(first, second);
+
+    ObjectPool::deallocate(first, 24);
+    ObjectPool::deallocate(second, 24);
+
+    // The free list is LIFO, and sizes round up to the same class
+    EXPECT_EQ(ObjectPool::allocate(20), second);
+    EXPECT_EQ(ObjectPool::allocate(17), first);
+    ObjectPool::deallocate(first, 17);
+    ObjectPool::deallocate(second, 20);
+}
+
+/** Blocks of different size classes are never mixed up */
+TEST(ObjectPoolTest, SizeClassesAreSeparate)
+{
+    void* small = ObjectPool::allocate(ObjectPool::Granularity);
+    ObjectPool::deallocate(small, ObjectPool::Granularity);
+
+    void* large = ObjectPool::allocate(2 * ObjectPool::Granularity);
+    EXPECT_NE(large, small);
+    ObjectPool::deallocate(large, 2 * ObjectPool::Granularity);
+}
+
+/** Objects above the maximum size bypass the pool */
+TEST(ObjectPoolTest, LargeObjectsUseTheHeap)
+{
+    const std::size_t size = ObjectPool::MaxSize + 1;
+    void* ptr = ObjectPool::allocate(size);
+    ASSERT_NE(ptr, nullptr);
+    ObjectPool::deallocate(ptr, size);
+}
+
+/** Blocks are aligned for any type */
+TEST(ObjectPoolTest, Alignment)
+{
+    std::vector<void*> blocks;
+    for (std::size_t size = 1; size <= ObjectPool::MaxSize; size++) {
+        void* ptr = ObjectPool::allocate(size);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) %
+            alignof(std::max_align_t), 0);
+        blocks.push_back(ptr);
+    }
+    for (std::size_t size = 1; size <= ObjectPool::MaxSize; size++) {
+        ObjectPool::deallocate(blocks[size - 1], size);
+    }
+}
+
+/**
+ * Deleting through a base pointer returns the block to the size class of
+ * the dynamic type, so live objects never share a block.
+ */
+TEST(ObjectPoolTest, DeleteThroughBase)
+{
+    std::vector<std::unique_ptr<PooledBase>> objects;
+    for (int round = 0; round < 4; round++) {
+        for (int i = 0; i < 16; i++) {
+            if (i % 2) {
+                objects.emplace_back(new PooledDerived());
+            } else {
+                objects.emplace_back(new PooledBase());
+            }
+            objects.back()->value = i;
+        }
+
+        std::set<PooledBase*> addresses;
+        for (const auto& object : objects) {
+            EXPECT_TRUE(addresses.insert(object.get()).second);
+        }
+        for (int i = 0; i < 16; i++) {
+            EXPECT_EQ(objects[i]->value, i);
+        }
+        objects.clear();
+    }
+}
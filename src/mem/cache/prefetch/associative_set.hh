@@ -40,6 +40,11 @@ namespace gem5
  * Associative container based on the previosuly defined Entry type
  * Each element is indexed by a key of type Addr, an additional
  * bool value is used as an additional tag data of the entry.
+ *
+ * The container keeps a compact copy of the tag, valid and secure bits of
+ * its entries, so lookups do not have to touch the (potentially large)
+ * entries nor go through their virtual accessors. Because of that, entries
+ * must only be inserted and invalidated through the container.
  */
 template<class Entry>
 class AssociativeSet
@@ -62,6 +67,69 @@ class AssociativeSet
     /** Vector containing the entries of the container */
     std::vector<Entry> entries;
 
+    /** Copy of the lookup information of an entry. */
+    struct EntryKey
+    {
+        Addr tag;
+        bool valid;
+        bool secure;
+    };
+
+    /**
+     * Lookup information of the entries, indexed like the entries vector.
+     * It is kept up to date by insertEntry() and invalidate().
+     */
+    std::vector<EntryKey> keys;
+
+    /**
+     * Candidate entries returned by the indexing policy, mapped to the
+     * entries of this container. Kept to avoid an allocation per victim
+     * search.
+     */
+    std::vector<ReplaceableEntry*> candidates;
+
+    /**
+     * Get the position of an entry in the entries vector, from the set and
+     * way the indexing policy assigned to it.
+     *
+     * The indexing policy may be shared by several containers with the same
+     * geometry (e.g., the per-context tables of the stride prefetcher), in
+     * which case the entries it returns belong to the container that was
+     * built last. Their position still tells which entry of this container
+     * they stand for.
+     *
+     * @param entry An entry of this or of an identical container
+     * @return The index of the entry
+     */
+    std::size_t
+    indexOf(const ReplaceableEntry* entry) const
+    {
+        return entry->getSet() * associativity + entry->getWay();
+    }
+
+    /**
+     * Get the entry of this container at the position of a candidate
+     * returned by the indexing policy.
+     * @param entry An entry of this or of an identical container
+     * @return The entry of this container at the same position
+     */
+    Entry*
+    ownEntry(const ReplaceableEntry* entry) const
+    {
+        return const_cast<Entry*>(&entries[indexOf(entry)]);
+    }
+
+    /**
+     * Refresh the lookup information of an entry after it has changed.
+     * @param entry An entry of this container
+     */
+    void
+    updateKey(const Entry* entry)
+    {
+        keys[indexOf(entry)] = {entry->getTag(), entry->isValid(),
+                                entry->isSecure()};
+    }
+
   public:
     /**
      * Public constructor
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <unordered_map>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "mem/cache/prefetch/associative_set_impl.hh"
+#include "mem/cache/replacement_policies/lru_rp.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
+#include "params/LRURP.hh"
+#include "params/SetAssociative.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** An entry like the ones of the stride prefetcher's PC tables */
+struct StrideEntry : public TaggedEntry
+{
+    int context = -1;
+    Addr lastAddr = 0;
+
+    void
+    invalidate() override
+    {
+        TaggedEntry::invalidate();
+        context = -1;
+        lastAddr = 0;
+    }
+};
+
+typedef AssociativeSet<StrideEntry> PCTable;
+
+const int Assoc = 4;
+const int NumEntries = 16;
+const int NumSets = NumEntries / Assoc;
+
+/**
+ * Per-context PC tables sharing a single indexing and replacement policy,
+ * built the way the stride prefetcher builds one table for each requestor
+ * it sees.
+ */
+class PCTablesTest : public testing::Test
+{
+  protected:
+    GTestTickHandler tickHandler;
+    Tick tick = 0;
+
+    SetAssociativeParams indexingParams;
+    LRURPParams replacementParams;
+    std::unique_ptr<SetAssociative> indexingPolicy;
+    std::unique_ptr<replacement_policy::LRU> replacementPolicy;
+
+    std::unordered_map<int, PCTable> pcTables;
+
+    void
+    SetUp() override
+    {
+        indexingParams.name = "indexing_policy";
+        indexingParams.size = NumEntries;
+        indexingParams.entry_size = 1;
+        indexingParams.assoc = Assoc;
+        indexingPolicy = std::make_unique<SetAssociative>(indexingParams);
+
+        replacementParams.name = "replacement_policy";
+        replacementPolicy =
+            std::make_unique<replacement_policy::LRU>(replacementParams);
+    }
+
+    PCTable &
+    findTable(int context)
+    {
+        auto it = pcTables.find(context);
+        if (it != pcTables.end())
+            return it->second;
+        return pcTables.insert(std::make_pair(context,
+            PCTable(Assoc, NumEntries, indexingPolicy.get(),
+                    replacementPolicy.get()))).first->second;
+    }
+
+    /** Train a table on an access, as the stride prefetcher does */
+    StrideEntry *
+    train(int context, Addr pc, Addr addr)
+    {
+        tickHandler.setCurTick(++tick);
+        PCTable &table = findTable(context);
+        StrideEntry *entry = table.findEntry(pc, false);
+        if (entry) {
+            table.accessEntry(entry);
+        } else {
+            entry = table.findVictim(pc);
+            table.insertEntry(pc, false, entry);
+            entry->context = context;
+        }
+        entry->lastAddr = addr;
+        return entry;
+    }
+
+    bool
+    owns(const PCTable &table, const StrideEntry *entry) const
+    {
+        return entry >= &*table.begin() && entry < &*table.end();
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(PCTablesTest, ContextsDoNotShareEntries)
+{
+    const int num_contexts = 3;
+    for (int context = 0; context < num_contexts; context++) {
+        for (Addr pc = 0; pc < NumSets; pc++)
+            train(context, pc, 0x1000 * context + pc);
+    }
+
+    for (int context = 0; context < num_contexts; context++) {
+        PCTable &table = findTable(context);
+        for (Addr pc = 0; pc < NumSets; pc++) {
+            StrideEntry *entry = table.findEntry(pc, false);
+            ASSERT_NE(entry, nullptr);
+            EXPECT_TRUE(owns(table, entry));
+            EXPECT_EQ(entry->context, context);
+            EXPECT_EQ(entry->lastAddr, 0x1000 * context + pc);
+
+            for (auto *candidate: table.getPossibleEntries(pc))
+                EXPECT_TRUE(owns(table, candidate));
+        }
+    }
+
+    // A PC only seen by one context is not found in the others.
+    train(1, 0x40, 0x40);
+    EXPECT_NE(findTable(1).findEntry(0x40, false), nullptr);
+    EXPECT_EQ(findTable(0).findEntry(0x40, false), nullptr);
+    EXPECT_EQ(findTable(2).findEntry(0x40, false), nullptr);
+}
+
+TEST_F(PCTablesTest, VictimsComeFromTheOwnTable)
+{
+    train(0, 0x0, 0x100);
+    train(1, 0x0, 0x200);
+
+    // Fill the set of PC 0 in the first table past its associativity, so
+    // that it has to evict its own least recently used entries.
+    for (Addr pc = NumSets; pc <= Assoc * NumSets; pc += NumSets) {
+        StrideEntry *entry = train(0, pc, 0x100 + pc);
+        EXPECT_TRUE(owns(findTable(0), entry));
+    }
+
+    EXPECT_EQ(findTable(0).findEntry(0x0, false), nullptr);
+    EXPECT_NE(findTable(0).findEntry(Assoc * NumSets, false), nullptr);
+
+    // The other table is left alone.
+    StrideEntry *entry = findTable(1).findEntry(0x0, false);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->lastAddr, 0x200);
+    for (Addr pc = NumSets; pc <= Assoc * NumSets; pc += NumSets)
+        EXPECT_EQ(findTable(1).findEntry(pc, false), nullptr);
+}
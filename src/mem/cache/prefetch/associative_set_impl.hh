@@ -40,7 +40,8 @@ AssociativeSet<Entry>::AssociativeSet(int assoc, int num_entries,
         BaseIndexingPolicy *idx_policy, replacement_policy::Base *rpl_policy,
         Entry const &init_value)
   : associativity(assoc), numEntries(num_entries), indexingPolicy(idx_policy),
-    replacementPolicy(rpl_policy), entries(numEntries, init_value)
+    replacementPolicy(rpl_policy), entries(numEntries, init_value),
+    keys(numEntries), candidates(assoc)
 {
     fatal_if(!isPowerOf2(num_entries), "The number of entries of an "
              "AssociativeSet<> must be a power of 2");
@@ -49,7 +50,11 @@ AssociativeSet<Entry>::AssociativeSet(int assoc, int num_entries,
     for (unsigned int entry_idx = 0; entry_idx < numEntries; entry_idx += 1) {
         Entry* entry = &entries[entry_idx];
         indexingPolicy->setEntry(entry, entry_idx);
+        fatal_if(indexOf(entry) != entry_idx, "The associativity of an "
+                 "AssociativeSet<> must match the one of its indexing "
+                 "policy");
         entry->replacementData = replacementPolicy->instantiateEntry();
+        updateKey(entry);
     }
 }
 
@@ -58,14 +63,13 @@ Entry*
 AssociativeSet<Entry>::findEntry(Addr addr, bool is_secure) const
 {
     Addr tag = indexingPolicy->extractTag(addr);
-    const std::vector<ReplaceableEntry*> selected_entries =
+    const std::vector<ReplaceableEntry*>& selected_entries =
         indexingPolicy->getPossibleEntries(addr);
 
     for (const auto& location : selected_entries) {
-        Entry* entry = static_cast<Entry *>(location);
-        if ((entry->getTag() == tag) && entry->isValid() &&
-            entry->isSecure() == is_secure) {
-            return entry;
+        const EntryKey& key = keys[indexOf(location)];
+        if ((key.tag == tag) && key.valid && (key.secure == is_secure)) {
+            return ownEntry(location);
         }
     }
     return nullptr;
@@ -83,10 +87,14 @@ Entry*
 AssociativeSet<Entry>::findVictim(Addr addr)
 {
     // Get possible entries to be victimized
-    const std::vector<ReplaceableEntry*> selected_entries =
+    const std::vector<ReplaceableEntry*>& selected_entries =
         indexingPolicy->getPossibleEntries(addr);
+    candidates.resize(selected_entries.size());
+    for (std::size_t i = 0; i < selected_entries.size(); i++) {
+        candidates[i] = ownEntry(selected_entries[i]);
+    }
     Entry* victim = static_cast<Entry*>(replacementPolicy->getVictim(
-                            selected_entries));
+                            candidates));
     // There is only one eviction for this replacement
     invalidate(victim);
     return victim;
@@ -97,13 +105,13 @@ template<class Entry>
 std::vector<Entry *>
 AssociativeSet<Entry>::getPossibleEntries(const Addr addr) const
 {
-    std::vector<ReplaceableEntry *> selected_entries =
+    const std::vector<ReplaceableEntry *>& selected_entries =
         indexingPolicy->getPossibleEntries(addr);
     std::vector<Entry *> entries(selected_entries.size(), nullptr);
 
     unsigned int idx = 0;
     for (auto &entry : selected_entries) {
-        entries[idx++] = static_cast<Entry *>(entry);
+        entries[idx++] = ownEntry(entry);
     }
     return entries;
 }
@@ -113,6 +121,7 @@ void
 AssociativeSet<Entry>::insertEntry(Addr addr, bool is_secure, Entry* entry)
 {
    entry->insert(indexingPolicy->extractTag(addr), is_secure);
+   updateKey(entry);
    replacementPolicy->reset(entry->replacementData);
 }
 
@@ -121,6 +130,7 @@ void
 AssociativeSet<Entry>::invalidate(Entry* entry)
 {
     entry->invalidate();
+    updateKey(entry);
     replacementPolicy->invalidate(entry->replacementData);
 }
 
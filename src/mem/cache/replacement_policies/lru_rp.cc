@@ -28,11 +28,9 @@
 
 #include "mem/cache/replacement_policies/lru_rp.hh"
 
-#include <cassert>
 #include <memory>
 
 #include "params/LRURP.hh"
-#include "sim/cur_tick.hh"
 
 namespace gem5
 {
@@ -49,45 +47,8 @@ void
 LRU::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
     // Reset last touch timestamp
-    std::static_pointer_cast<LRUReplData>(
-        replacement_data)->lastTouchTick = Tick(0);
-}
-
-void
-LRU::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
-{
-    // Update last touch timestamp
-    std::static_pointer_cast<LRUReplData>(
-        replacement_data)->lastTouchTick = curTick();
-}
-
-void
-LRU::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
-{
-    // Set last touch timestamp
-    std::static_pointer_cast<LRUReplData>(
-        replacement_data)->lastTouchTick = curTick();
-}
-
-ReplaceableEntry*
-LRU::getVictim(const ReplacementCandidates& candidates) const
-{
-    // There must be at least one replacement candidate
-    assert(candidates.size() > 0);
-
-    // Visit all candidates to find victim
-    ReplaceableEntry* victim = candidates[0];
-    for (const auto& candidate : candidates) {
-        // Update victim entry if necessary
-        if (std::static_pointer_cast<LRUReplData>(
-                    candidate->replacementData)->lastTouchTick <
-                std::static_pointer_cast<LRUReplData>(
-                    victim->replacementData)->lastTouchTick) {
-            victim = candidate;
-        }
-    }
-
-    return victim;
+    static_cast<LRUReplData*>(
+        replacement_data.get())->lastTouchTick = Tick(0);
 }
 
 std::shared_ptr<ReplacementData>
@@ -35,7 +35,11 @@
 #ifndef __MEM_CACHE_REPLACEMENT_POLICIES_LRU_RP_HH__
 #define __MEM_CACHE_REPLACEMENT_POLICIES_LRU_RP_HH__
 
+#include <cassert>
+#include <memory>
+
 #include "mem/cache/replacement_policies/base.hh"
+#include "sim/cur_tick.hh"
 
 namespace gem5
 {
@@ -109,6 +113,51 @@ class LRU : public Base
     std::shared_ptr<ReplacementData> instantiateEntry() override;
 };
 
+// The hot methods are defined inline so that callers that know the exact
+// policy type (see BaseSetAssoc) can call them without virtual dispatch.
+
+inline void
+LRU::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    // Update last touch timestamp
+    static_cast<LRUReplData*>(
+        replacement_data.get())->lastTouchTick = curTick();
+}
+
+inline void
+LRU::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    // Set last touch timestamp
+    static_cast<LRUReplData*>(
+        replacement_data.get())->lastTouchTick = curTick();
+}
+
+inline ReplaceableEntry*
+LRU::getVictim(const ReplacementCandidates& candidates) const
+{
+    // There must be at least one replacement candidate
+    assert(candidates.size() > 0);
+
+    // Visit all candidates to find victim. The replacement data is accessed
+    // through raw pointers, as casting the shared pointers would update
+    // their reference counts for every candidate of every replacement
+    ReplaceableEntry* victim = candidates[0];
+    Tick victim_tick = static_cast<const LRUReplData*>(
+        victim->replacementData.get())->lastTouchTick;
+    for (const auto& candidate : candidates) {
+        const Tick candidate_tick = static_cast<const LRUReplData*>(
+            candidate->replacementData.get())->lastTouchTick;
+
+        // Update victim entry if necessary
+        if (candidate_tick < victim_tick) {
+            victim = candidate;
+            victim_tick = candidate_tick;
+        }
+    }
+
+    return victim;
+}
+
 } // namespace replacement_policy
 } // namespace gem5
 
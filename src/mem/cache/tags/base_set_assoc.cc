@@ -46,6 +46,7 @@
 #include "mem/cache/tags/base_set_assoc.hh"
 
 #include <string>
+#include <typeinfo>
 
 #include "base/intmath.hh"
 
@@ -83,6 +84,17 @@ BaseSetAssoc::tagsInit()
         // Associate a replacement data entry to the block
         blk->replacementData = replacementPolicy->instantiateEntry();
     }
+
+    // Bypass the virtual policy interfaces for the default configuration.
+    // The types are compared exactly, as subclasses (e.g., BIP, or hashed
+    // set associative indexing) override the methods used by the fast path
+    if (typeid(*this) == typeid(BaseSetAssoc) &&
+        typeid(*indexingPolicy) == typeid(SetAssociative) &&
+        typeid(*replacementPolicy) == typeid(replacement_policy::LRU)) {
+        setAssocIndexing = static_cast<SetAssociative*>(indexingPolicy);
+        lruPolicy =
+            static_cast<replacement_policy::LRU*>(replacementPolicy);
+    }
 }
 
 void
@@ -56,9 +56,11 @@
 #include "mem/cache/base.hh"
 #include "mem/cache/cache_blk.hh"
 #include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/lru_rp.hh"
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/cache/tags/base.hh"
 #include "mem/cache/tags/indexing_policies/base.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
 #include "mem/packet.hh"
 #include "params/BaseSetAssoc.hh"
 
@@ -87,6 +89,35 @@ class BaseSetAssoc : public BaseTags
     /** Replacement policy */
     replacement_policy::Base *replacementPolicy;
 
+    /**
+     * The indexing and replacement policies, set only when they are
+     * exactly SetAssociative and LRU (the default configuration). Lookups,
+     * insertions and replacements then call them directly instead of
+     * through their virtual interfaces.
+     */
+    SetAssociative *setAssocIndexing = nullptr;
+    replacement_policy::LRU *lruPolicy = nullptr;
+
+    /**
+     * Find a block in a SetAssociative+LRU tag store without virtual calls.
+     *
+     * @param addr The address to find.
+     * @param is_secure True if the target memory space is secure.
+     * @return Pointer to the cache block if found.
+     */
+    CacheBlk*
+    findBlockSetAssocLRU(Addr addr, bool is_secure) const
+    {
+        const Addr tag = setAssocIndexing->tagOf(addr);
+        for (const auto& location : setAssocIndexing->setOf(addr)) {
+            CacheBlk* blk = static_cast<CacheBlk*>(location);
+            if (blk->matchTag(tag, is_secure)) {
+                return blk;
+            }
+        }
+        return nullptr;
+    }
+
   public:
     /** Convenience typedef. */
      typedef BaseSetAssocParams Params;
@@ -114,6 +145,15 @@ class BaseSetAssoc : public BaseTags
      */
     void invalidate(CacheBlk *blk) override;
 
+    CacheBlk*
+    findBlock(Addr addr, bool is_secure) const override
+    {
+        if (lruPolicy) {
+            return findBlockSetAssocLRU(addr, is_secure);
+        }
+        return BaseTags::findBlock(addr, is_secure);
+    }
+
     /**
      * Access block and update replacement data. May not succeed, in which case
      * nullptr is returned. This has all the implications of a cache access and
@@ -126,7 +166,9 @@ class BaseSetAssoc : public BaseTags
      */
     CacheBlk* accessBlock(const PacketPtr pkt, Cycles &lat) override
     {
-        CacheBlk *blk = findBlock(pkt->getAddr(), pkt->isSecure());
+        CacheBlk *blk = lruPolicy ?
+            findBlockSetAssocLRU(pkt->getAddr(), pkt->isSecure()) :
+            findBlock(pkt->getAddr(), pkt->isSecure());
 
         // Access all tags in parallel, hence one in each way.  The data side
         // either accesses all blocks in parallel, or one block sequentially on
@@ -146,7 +188,11 @@ class BaseSetAssoc : public BaseTags
             blk->increaseRefCount();
 
             // Update replacement data of accessed block
-            replacementPolicy->touch(blk->replacementData, pkt);
+            if (lruPolicy) {
+                lruPolicy->LRU::touch(blk->replacementData);
+            } else {
+                replacementPolicy->touch(blk->replacementData, pkt);
+            }
         }
 
         // The tag lookup latency is the same for a hit or a miss
@@ -169,13 +215,19 @@ class BaseSetAssoc : public BaseTags
                          const std::size_t size,
                          std::vector<CacheBlk*>& evict_blks) override
     {
-        // Get possible entries to be victimized
-        const std::vector<ReplaceableEntry*> entries =
-            indexingPolicy->getPossibleEntries(addr);
+        CacheBlk* victim;
+        if (lruPolicy) {
+            victim = static_cast<CacheBlk*>(lruPolicy->LRU::getVictim(
+                setAssocIndexing->setOf(addr)));
+        } else {
+            // Get possible entries to be victimized
+            const std::vector<ReplaceableEntry*>& entries =
+                indexingPolicy->getPossibleEntries(addr);
 
-        // Choose replacement victim from replacement candidates
-        CacheBlk* victim = static_cast<CacheBlk*>(replacementPolicy->getVictim(
-                                entries));
+            // Choose replacement victim from replacement candidates
+            victim = static_cast<CacheBlk*>(replacementPolicy->getVictim(
+                entries));
+        }
 
         // There is only one eviction for this replacement
         evict_blks.push_back(victim);
@@ -198,7 +250,11 @@ class BaseSetAssoc : public BaseTags
         stats.tagsInUse++;
 
         // Update replacement policy
-        replacementPolicy->reset(blk->replacementData, pkt);
+        if (lruPolicy) {
+            lruPolicy->LRU::reset(blk->replacementData);
+        } else {
+            replacementPolicy->reset(blk->replacementData, pkt);
+        }
     }
 
     void moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk) override;
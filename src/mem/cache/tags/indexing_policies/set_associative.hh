@@ -115,8 +115,8 @@ class SetAssociative : public BaseIndexingPolicy
      * @param addr The addr to a find possible entries for.
      * @return The possible entries.
      */
-    std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
-                                                                     override;
+    const std::vector<ReplaceableEntry*>&
+    getPossibleEntries(const Addr addr) const override;
 
     /**
      * Regenerate an entry's address from its tag and assigned set and way.
@@ -127,6 +127,19 @@ class SetAssociative : public BaseIndexingPolicy
      */
     Addr regenerateAddr(const Addr tag, const ReplaceableEntry* entry) const
                                                                    override;
+
+    /**
+     * Non-virtual versions of extractTag() and getPossibleEntries(), for
+     * callers that know this is exactly a SetAssociative policy.
+     *
+     * @param addr The address to get the tag or the set entries of.
+     */
+    Addr tagOf(const Addr addr) const { return addr >> tagShift; }
+    const std::vector<ReplaceableEntry*>&
+    setOf(const Addr addr) const
+    {
+        return sets[(addr >> setShift) & setMask];
+    }
 };
 
 } // namespace gem5
@@ -140,7 +140,8 @@ CoherentXBar::init()
         warn("CoherentXBar %s has no snooping ports attached!\n", name());
 
     // inform the snoop filter about the CPU-side ports so it can create
-    // its own internal representation
+    // its own internal representation, and check that its snoop masks
+    // can hold them; without a filter there is no limit
     if (snoopFilter)
         snoopFilter->setCPUSidePorts(cpuSidePorts);
 }
@@ -228,7 +229,7 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
             pkt->headerDelay += sf_res.second * clockPeriod();
             DPRINTF(CoherentXBar, "%s: src %s packet %s SF size: %i lat: %i\n",
                     __func__, src_port->name(), pkt->print(),
-                    sf_res.first.size(), sf_res.second);
+                    sf_res.first.count(), sf_res.second);
 
             if (pkt->isEviction()) {
                 // for block-evicting packets, i.e. writebacks and
@@ -236,10 +237,10 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
                 // all we do is determine if the block is cached or
                 // not, instead just set it here based on the snoop
                 // filter result
-                if (!sf_res.first.empty())
+                if (sf_res.first.any())
                     pkt->setBlockCached();
             } else {
-                forwardTiming(pkt, cpu_side_port_id, sf_res.first);
+                forwardTiming(pkt, cpu_side_port_id, &sf_res.first);
             }
         } else {
             forwardTiming(pkt, cpu_side_port_id);
@@ -540,10 +541,10 @@ CoherentXBar::recvTimingSnoopReq(PacketPtr pkt, PortID mem_side_port_id)
         pkt->headerDelay += sf_res.second * clockPeriod();
         DPRINTF(CoherentXBar, "%s: src %s packet %s SF size: %i lat: %i\n",
                 __func__, memSidePorts[mem_side_port_id]->name(),
-                pkt->print(), sf_res.first.size(), sf_res.second);
+                pkt->print(), sf_res.first.count(), sf_res.second);
 
         // forward to all snoopers
-        forwardTiming(pkt, InvalidPortID, sf_res.first);
+        forwardTiming(pkt, InvalidPortID, &sf_res.first);
     } else {
         forwardTiming(pkt, InvalidPortID);
     }
@@ -698,7 +699,7 @@ CoherentXBar::recvTimingSnoopResp(PacketPtr pkt, PortID cpu_side_port_id)
 
 void
 CoherentXBar::forwardTiming(PacketPtr pkt, PortID exclude_cpu_side_port_id,
-                           const std::vector<QueuedResponsePort*>& dests)
+                            const SnoopFilter::SnoopMask* dests)
 {
     DPRINTF(CoherentXBar, "%s for %s\n", __func__, pkt->print());
 
@@ -707,7 +708,12 @@ CoherentXBar::forwardTiming(PacketPtr pkt, PortID exclude_cpu_side_port_id,
 
     unsigned fanout = 0;
 
-    for (const auto& p: dests) {
+    for (size_t i = 0; i < snoopPorts.size(); ++i) {
+        if (dests && !(*dests)[i])
+            continue;
+
+        QueuedResponsePort* p = snoopPorts[i];
+
         // we could have gotten this request from a snooping requestor
         // (corresponding to our own CPU-side port that is also in
         // snoopPorts) and should not send it back to where it came
@@ -765,7 +771,7 @@ CoherentXBar::recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
             snoop_response_latency += sf_res.second * clockPeriod();
             DPRINTF(CoherentXBar, "%s: src %s packet %s SF size: %i lat: %i\n",
                     __func__, cpuSidePorts[cpu_side_port_id]->name(),
-                    pkt->print(), sf_res.first.size(), sf_res.second);
+                    pkt->print(), sf_res.first.count(), sf_res.second);
 
             // let the snoop filter know about the success of the send
             // operation, and do it even before sending it onwards to
@@ -779,11 +785,11 @@ CoherentXBar::recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
                 // all we do is determine if the block is cached or
                 // not, instead just set it here based on the snoop
                 // filter result
-                if (!sf_res.first.empty())
+                if (sf_res.first.any())
                     pkt->setBlockCached();
             } else {
                 snoop_result = forwardAtomic(pkt, cpu_side_port_id,
-                                            InvalidPortID, sf_res.first);
+                                            InvalidPortID, &sf_res.first);
             }
         } else {
             snoop_result = forwardAtomic(pkt, cpu_side_port_id);
@@ -904,9 +910,9 @@ CoherentXBar::recvAtomicSnoop(PacketPtr pkt, PortID mem_side_port_id)
         snoop_response_latency += sf_res.second * clockPeriod();
         DPRINTF(CoherentXBar, "%s: src %s packet %s SF size: %i lat: %i\n",
                 __func__, memSidePorts[mem_side_port_id]->name(),
-                pkt->print(), sf_res.first.size(), sf_res.second);
+                pkt->print(), sf_res.first.count(), sf_res.second);
         snoop_result = forwardAtomic(pkt, InvalidPortID, mem_side_port_id,
-                                     sf_res.first);
+                                     &sf_res.first);
     } else {
         snoop_result = forwardAtomic(pkt, InvalidPortID);
     }
@@ -929,7 +935,7 @@ CoherentXBar::recvAtomicSnoop(PacketPtr pkt, PortID mem_side_port_id)
 std::pair<MemCmd, Tick>
 CoherentXBar::forwardAtomic(PacketPtr pkt, PortID exclude_cpu_side_port_id,
                            PortID source_mem_side_port_id,
-                           const std::vector<QueuedResponsePort*>& dests)
+                           const SnoopFilter::SnoopMask* dests)
 {
     // the packet may be changed on snoops, record the original
     // command to enable us to restore it between snoops so that
@@ -943,7 +949,12 @@ CoherentXBar::forwardAtomic(PacketPtr pkt, PortID exclude_cpu_side_port_id,
 
     unsigned fanout = 0;
 
-    for (const auto& p: dests) {
+    for (size_t i = 0; i < snoopPorts.size(); ++i) {
+        if (dests && !(*dests)[i])
+            continue;
+
+        QueuedResponsePort* p = snoopPorts[i];
+
         // we could have gotten this request from a snooping memory-side port
         // (corresponding to our own CPU-side port that is also in
         // snoopPorts) and should not send it back to where it came
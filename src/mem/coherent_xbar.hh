@@ -322,7 +322,7 @@ class CoherentXBar : public BaseXBar
     void
     forwardTiming(PacketPtr pkt, PortID exclude_cpu_side_port_id)
     {
-        forwardTiming(pkt, exclude_cpu_side_port_id, snoopPorts);
+        forwardTiming(pkt, exclude_cpu_side_port_id, nullptr);
     }
 
     /**
@@ -332,10 +332,11 @@ class CoherentXBar : public BaseXBar
      *
      * @param pkt Packet to forward
      * @param exclude_cpu_side_port_id Id of CPU-side port to exclude
-     * @param dests Vector of destination ports for the forwarded pkt
+     * @param dests Mask of destination snoop ports for the forwarded
+     * pkt, where bit i refers to snoopPorts[i], or nullptr for all
      */
     void forwardTiming(PacketPtr pkt, PortID exclude_cpu_side_port_id,
-                       const std::vector<QueuedResponsePort*>& dests);
+                       const SnoopFilter::SnoopMask* dests);
 
     Tick recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
                             MemBackdoorPtr *backdoor=nullptr);
@@ -355,7 +356,7 @@ class CoherentXBar : public BaseXBar
     forwardAtomic(PacketPtr pkt, PortID exclude_cpu_side_port_id)
     {
         return forwardAtomic(pkt, exclude_cpu_side_port_id, InvalidPortID,
-                             snoopPorts);
+                             nullptr);
     }
 
     /**
@@ -367,14 +368,15 @@ class CoherentXBar : public BaseXBar
      * @param exclude_cpu_side_port_id Id of CPU-side port to exclude
      * @param source_mem_side_port_id Id of the memory-side port for
      * snoops from below
-     * @param dests Vector of destination ports for the forwarded pkt
+     * @param dests Mask of destination snoop ports for the forwarded
+     * pkt, where bit i refers to snoopPorts[i], or nullptr for all
      *
      * @return a pair containing the snoop response and snoop latency
      */
     std::pair<MemCmd, Tick> forwardAtomic(PacketPtr pkt,
                                           PortID exclude_cpu_side_port_id,
                                           PortID source_mem_side_port_id,
-                                          const std::vector<QueuedResponsePort*>&
+                                          const SnoopFilter::SnoopMask*
                                           dests);
 
     /** Function called by the port when the crossbar is receiving a Functional
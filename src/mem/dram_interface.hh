@@ -47,6 +47,7 @@
 #define __DRAM_INTERFACE_HH__
 
 #include "mem/drampower.hh"
+#include "mem/frfcfs_selector.hh"
 #include "mem/mem_interface.hh"
 #include "params/DRAMInterface.hh"
 
@@ -641,13 +642,39 @@ class DRAMInterface : public MemInterface
      * for the enqueued requests. Assumes maximum of 32 banks per rank
      * Also checks if the bank is already prepped.
      *
-     * @param queue Queued requests to consider
+     * @param got_waiting Banks, by bank id, with requests able to issue
      * @param min_col_at time of seamless burst command
-     * @return One-hot encoded mask of bank indices
+     * @param bank_mask One-hot encoded mask of bank indices, per rank
      * @return boolean indicating burst can issue seamlessly, with no gaps
      */
-    std::pair<std::vector<uint32_t>, bool>
-    minBankPrep(const MemPacketQueue& queue, Tick min_col_at) const;
+    bool minBankPrep(const std::vector<bool>& got_waiting, Tick min_col_at,
+                     std::vector<uint32_t>& bank_mask) const;
+
+    /**
+     * Check if a queued packet is for this interface, and its rank is
+     * available to take it.
+     */
+    bool canIssue(MemPacket* pkt) const;
+
+    /** Check if a packet targets the open row of its bank */
+    bool
+    rowHit(const MemPacket* pkt) const
+    {
+        return ranks[pkt->rank]->banks[pkt->bank].openRow == pkt->row;
+    }
+
+    /** Earliest column command to the bank of a packet */
+    Tick
+    colAllowedAt(const MemPacket* pkt) const
+    {
+        const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
+        return pkt->isRead() ? bank.rdAllowedAt : bank.wrAllowedAt;
+    }
+
+    friend class FRFCFSSelector<DRAMInterface>;
+
+    /** Packet selection of chooseNextFRFCFS */
+    mutable FRFCFSSelector<DRAMInterface> frfcfs;
 
     /*
      * @return time to send a burst of data without gaps
@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_FRFCFS_SELECTOR_HH__
+#define __MEM_FRFCFS_SELECTOR_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * A queue of packets waiting for a memory interface, indexed by bank.
+ * Besides the packets in arrival order, it keeps the packets of each
+ * bank in arrival order, so that the FR-FCFS selection only looks at
+ * the first packets of each bank rather than at the whole queue.
+ * Packets are only added at the back, so their arrival order is the
+ * queue order, and the queue can only be changed through the methods
+ * that keep the index up to date.
+ *
+ * The Packet type must have a bankId.
+ */
+template <class Packet>
+class FRFCFSQueue : private std::deque<Packet*>
+{
+  private:
+    typedef std::deque<Packet*> Base;
+
+  public:
+    /** A packet and its position in the arrival order */
+    struct Entry
+    {
+        uint64_t seq;
+        Packet *pkt;
+    };
+
+    typedef std::deque<Entry> BankEntries;
+
+    using typename Base::value_type;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::reverse_iterator;
+    using typename Base::const_reverse_iterator;
+
+    using Base::begin;
+    using Base::end;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::size;
+    using Base::empty;
+    using Base::front;
+    using Base::back;
+
+    void
+    push_back(Packet *pkt)
+    {
+        Base::push_back(pkt);
+        if (pkt->bankId >= banks.size())
+            banks.resize(pkt->bankId + 1);
+        banks[pkt->bankId].push_back({nextSeq++, pkt});
+    }
+
+    iterator
+    erase(const_iterator it)
+    {
+        unindex(*it);
+        return Base::erase(it);
+    }
+
+    void
+    pop_front()
+    {
+        unindex(Base::front());
+        Base::pop_front();
+    }
+
+    void
+    clear()
+    {
+        Base::clear();
+        for (auto &entries : banks)
+            entries.clear();
+    }
+
+    /** Number of bank ids that packets have been queued for */
+    size_t numBanks() const { return banks.size(); }
+
+    /** The queued packets of a bank, in arrival order */
+    const BankEntries &bankEntries(size_t bank_id) const
+    {
+        return banks[bank_id];
+    }
+
+  private:
+    void
+    unindex(const Packet *pkt)
+    {
+        // packets usually leave close to the front of their bank
+        auto &entries = banks[pkt->bankId];
+        auto it = std::find_if(entries.begin(), entries.end(),
+            [pkt](const Entry &entry) { return entry.pkt == pkt; });
+        assert(it != entries.end());
+        entries.erase(it);
+    }
+
+    /** Queued packets by bank id */
+    std::vector<BankEntries> banks;
+
+    /** Arrival order of the next packet */
+    uint64_t nextSeq = 0;
+};
+
+/**
+ * FR-FCFS packet selection of a DRAM interface. The packet selected
+ * follows a fixed order of preference:
+ * 1) the first seamless row hit in the queue;
+ * 2) the first packet to a closed row whose bank is amongst the
+ *    earliest available, if the PRE/ACT sequence can be hidden;
+ * 3) the first prepped (but not seamless) row hit;
+ * 4) the first packet to a closed row whose bank is amongst the
+ *    earliest available.
+ *
+ * The queue is walked bank by bank with the index of an FRFCFSQueue,
+ * and the walk of a bank stops as soon as its first row hit and its
+ * first packet to a closed row are known. All the packets of a queue go
+ * in the same direction, as the controller keeps reads and writes
+ * apart, so the first row hit of a bank tells whether any of its row
+ * hits is seamless. The decision thus looks at a few packets per bank
+ * instead of every queued packet, and compares packets of different
+ * banks by their arrival order. The bank timing is then evaluated once
+ * per bank. The state kept per bank is reused across decisions, so
+ * that they do not allocate.
+ *
+ * The selector is kept apart from the interface so that it can be
+ * checked on its own. The Dram type tells it about packets and banks:
+ * - bool canIssue(pkt): the packet is for this interface, and its rank
+ *   is available;
+ * - bool rowHit(pkt): the packet targets the open row of its bank;
+ * - Tick colAllowedAt(pkt): earliest column command to its bank;
+ * - bool minBankPrep(got_waiting, min_col_at, bank_mask): see
+ *   DRAMInterface::minBankPrep.
+ */
+template <class Dram>
+class FRFCFSSelector
+{
+  private:
+    /** Arrival order of no packet */
+    static constexpr uint64_t NoPacket = std::numeric_limits<uint64_t>::max();
+
+    const Dram &dram;
+    const unsigned ranksPerChannel;
+    const unsigned banksPerRank;
+
+    /** Banks, by bank id, with packets that can issue */
+    std::vector<bool> bankWaiting;
+
+    /** Arrival order of the first packet to a closed row, by bank id */
+    std::vector<uint64_t> firstBankMiss;
+
+    /** One-hot masks, per rank, of the earliest banks to activate */
+    std::vector<uint32_t> earliestBanks;
+
+  public:
+    FRFCFSSelector(const Dram &_dram, unsigned ranks, unsigned banks)
+        : dram(_dram), ranksPerChannel(ranks), banksPerRank(banks),
+          bankWaiting(ranks * banks), firstBankMiss(ranks * banks),
+          earliestBanks(ranks)
+    {}
+
+    /**
+     * Select the next packet to issue.
+     *
+     * @param queue Queued packets to choose from, an FRFCFSQueue
+     * @param min_col_at Time of seamless burst command
+     * @return Iterator to the packet selected, or the end of the queue
+     *         if none can issue, and the earliest time of its burst
+     */
+    template <class Queue>
+    std::pair<typename Queue::iterator, Tick>
+    select(Queue &queue, Tick min_col_at)
+    {
+        std::fill(bankWaiting.begin(), bankWaiting.end(), false);
+        std::fill(firstBankMiss.begin(), firstBankMiss.end(), NoPacket);
+
+        // remember if we found a packet to a closed row
+        bool found_miss_pkt = false;
+
+        // remember the first seamless row hit, and the first row hit,
+        // not seamless, but bank prepped and ready
+        uint64_t seamless_seq = NoPacket;
+        uint64_t prepped_seq = NoPacket;
+        typename Queue::value_type seamless_pkt = nullptr;
+        typename Queue::value_type prepped_pkt = nullptr;
+
+        for (size_t bank_id = 0; bank_id < queue.numBanks(); ++bank_id) {
+            bool found_hit = false;
+            bool found_miss = false;
+            for (const auto &entry : queue.bankEntries(bank_id)) {
+                // no packet further down this bank can be selected
+                // ahead of the ones already found
+                if (found_hit && found_miss)
+                    break;
+
+                const auto &pkt = entry.pkt;
+                if (!dram.canIssue(pkt))
+                    continue;
+
+                bankWaiting[pkt->bankId] = true;
+
+                if (dram.rowHit(pkt)) {
+                    if (found_hit)
+                        continue;
+                    found_hit = true;
+
+                    // no additional rank-to-rank or same bank-group
+                    // delays, or we switched read/write and might as
+                    // well go for the row hit; FCFS within the hits,
+                    // giving priority to commands that can issue
+                    // seamlessly
+                    if (dram.colAllowedAt(pkt) <= min_col_at) {
+                        if (entry.seq < seamless_seq) {
+                            seamless_seq = entry.seq;
+                            seamless_pkt = pkt;
+                        }
+                        // later packets of the bank cannot go first
+                        break;
+                    } else if (entry.seq < prepped_seq) {
+                        prepped_seq = entry.seq;
+                        prepped_pkt = pkt;
+                    }
+                } else if (!found_miss) {
+                    found_miss = true;
+                    firstBankMiss[pkt->bankId] = entry.seq;
+                    found_miss_pkt = true;
+                }
+            }
+        }
+
+        if (seamless_pkt) {
+            return std::make_pair(
+                std::find(queue.begin(), queue.end(), seamless_pkt),
+                dram.colAllowedAt(seamless_pkt));
+        }
+
+        auto selected_pkt = prepped_pkt;
+
+        if (found_miss_pkt) {
+            // determine the banks with the earliest activate; they give
+            // priority to banks that can issue seamlessly
+            const bool hidden_bank_prep =
+                dram.minBankPrep(bankWaiting, min_col_at, earliestBanks);
+
+            // find the first packet to a closed row in one of them
+            uint64_t earliest_seq = NoPacket;
+            size_t earliest_bank_id = 0;
+            for (unsigned i = 0; i < ranksPerChannel; i++) {
+                for (unsigned j = 0; j < banksPerRank; j++) {
+                    const size_t bank_id = i * banksPerRank + j;
+                    if (bits(earliestBanks[i], j, j) &&
+                        firstBankMiss[bank_id] < earliest_seq) {
+                        earliest_seq = firstBankMiss[bank_id];
+                        earliest_bank_id = bank_id;
+                    }
+                }
+            }
+
+            // give priority to packets that can issue bank commands
+            // 'behind the scenes', any additional delay if any will be
+            // due to col-to-col command requirements
+            if (earliest_seq != NoPacket &&
+                (hidden_bank_prep || !prepped_pkt)) {
+                for (const auto &entry :
+                         queue.bankEntries(earliest_bank_id)) {
+                    if (entry.seq == earliest_seq) {
+                        selected_pkt = entry.pkt;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (!selected_pkt)
+            return std::make_pair(queue.end(), MaxTick);
+        return std::make_pair(
+            std::find(queue.begin(), queue.end(), selected_pkt),
+            dram.colAllowedAt(selected_pkt));
+    }
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_FRFCFS_SELECTOR_HH__
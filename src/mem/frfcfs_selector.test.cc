@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/types.hh"
+#include "mem/frfcfs_selector.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+namespace
+{
+
+const uint32_t NoRow = -1;
+const Tick tRP = 15;
+const Tick tRCD = 15;
+
+struct FakePacket
+{
+    unsigned rank;
+    unsigned bank;
+    unsigned bankId;
+    uint32_t row;
+    bool read;
+    /** Whether the packet is for the interface making the decision */
+    bool mine;
+};
+
+typedef FRFCFSQueue<FakePacket> FakeQueue;
+
+struct FakeBank
+{
+    uint32_t openRow;
+    Tick rdAllowedAt;
+    Tick wrAllowedAt;
+    Tick actAllowedAt;
+    Tick preAllowedAt;
+};
+
+/**
+ * Bank state of a DRAM, with the same bank timing rules as the DRAM
+ * interface at tick 0.
+ */
+class FakeDram
+{
+  public:
+    unsigned ranksPerChannel;
+    unsigned banksPerRank;
+    std::vector<std::vector<FakeBank>> banks;
+    std::vector<bool> rankAvailable;
+    bool readBus;
+
+    bool
+    canIssue(const FakePacket *pkt) const
+    {
+        return pkt->mine && rankAvailable[pkt->rank];
+    }
+
+    bool
+    rowHit(const FakePacket *pkt) const
+    {
+        return banks[pkt->rank][pkt->bank].openRow == pkt->row;
+    }
+
+    Tick
+    colAllowedAt(const FakePacket *pkt) const
+    {
+        const FakeBank &bank = banks[pkt->rank][pkt->bank];
+        return pkt->read ? bank.rdAllowedAt : bank.wrAllowedAt;
+    }
+
+    bool
+    minBankPrep(const std::vector<bool> &got_waiting, Tick min_col_at,
+                std::vector<uint32_t> &bank_mask) const
+    {
+        Tick min_act_at = MaxTick;
+        std::fill(bank_mask.begin(), bank_mask.end(), 0);
+        bool found_seamless_bank = false;
+        bool hidden_bank_prep = false;
+
+        for (unsigned i = 0; i < ranksPerChannel; i++) {
+            for (unsigned j = 0; j < banksPerRank; j++) {
+                if (!got_waiting[i * banksPerRank + j])
+                    continue;
+
+                const FakeBank &bank = banks[i][j];
+                Tick act_at = bank.openRow == NoRow ?
+                    bank.actAllowedAt : bank.preAllowedAt + tRP;
+                const Tick hidden_act_max =
+                    min_col_at > tRCD ? min_col_at - tRCD : 0;
+                Tick col_at = std::max(
+                    readBus ? bank.rdAllowedAt : bank.wrAllowedAt,
+                    act_at + tRCD);
+                bool new_seamless_bank = col_at <= min_col_at;
+
+                if (new_seamless_bank ||
+                    (!found_seamless_bank && act_at <= min_act_at)) {
+                    if (!found_seamless_bank &&
+                        (new_seamless_bank || act_at < min_act_at)) {
+                        std::fill(bank_mask.begin(), bank_mask.end(), 0);
+                    }
+                    found_seamless_bank |= new_seamless_bank;
+                    hidden_bank_prep = act_at <= hidden_act_max;
+                    replaceBits(bank_mask[i], j, j, 1);
+                    min_act_at = act_at;
+                }
+            }
+        }
+        return hidden_bank_prep;
+    }
+
+    /**
+     * The FR-FCFS selection as the DRAM interface used to do it, which
+     * looked for the waiting banks in a separate pass over the queue.
+     */
+    std::pair<FakeQueue::iterator, Tick>
+    referenceSelect(FakeQueue &queue, Tick min_col_at) const
+    {
+        std::vector<uint32_t> earliest_banks(ranksPerChannel, 0);
+        bool filled_earliest_banks = false;
+        bool hidden_bank_prep = false;
+        bool found_hidden_bank = false;
+        bool found_prepped_pkt = false;
+        bool found_earliest_pkt = false;
+
+        Tick selected_col_at = MaxTick;
+        auto selected_pkt_it = queue.end();
+
+        for (auto i = queue.begin(); i != queue.end(); ++i) {
+            FakePacket *pkt = *i;
+            if (!pkt->mine || !rankAvailable[pkt->rank])
+                continue;
+
+            const Tick col_allowed_at = colAllowedAt(pkt);
+            if (rowHit(pkt)) {
+                if (col_allowed_at <= min_col_at) {
+                    selected_pkt_it = i;
+                    selected_col_at = col_allowed_at;
+                    break;
+                } else if (!found_hidden_bank && !found_prepped_pkt) {
+                    selected_pkt_it = i;
+                    selected_col_at = col_allowed_at;
+                    found_prepped_pkt = true;
+                }
+            } else if (!found_earliest_pkt) {
+                if (!filled_earliest_banks) {
+                    std::vector<bool> got_waiting(
+                        ranksPerChannel * banksPerRank, false);
+                    for (const auto &p : queue) {
+                        if (p->mine && rankAvailable[p->rank])
+                            got_waiting[p->bankId] = true;
+                    }
+                    hidden_bank_prep = minBankPrep(got_waiting, min_col_at,
+                                                   earliest_banks);
+                    filled_earliest_banks = true;
+                }
+
+                if (bits(earliest_banks[pkt->rank], pkt->bank, pkt->bank)) {
+                    found_earliest_pkt = true;
+                    found_hidden_bank = hidden_bank_prep;
+                    if (hidden_bank_prep || !found_prepped_pkt) {
+                        selected_pkt_it = i;
+                        selected_col_at = col_allowed_at;
+                    }
+                }
+            }
+        }
+
+        return std::make_pair(selected_pkt_it, selected_col_at);
+    }
+};
+
+/**
+ * Random bank and queue states. Times and rows are drawn from small
+ * ranges, so that ties and row hits are common.
+ */
+class FRFCFSSelectorTest : public ::testing::Test
+{
+  protected:
+    std::mt19937 rng;
+
+    unsigned
+    draw(unsigned n)
+    {
+        return std::uniform_int_distribution<unsigned>(0, n - 1)(rng);
+    }
+
+    void
+    randomDram(FakeDram &dram)
+    {
+        dram.ranksPerChannel = 1 << draw(3);
+        dram.banksPerRank = 1 + draw(16);
+        dram.banks.assign(dram.ranksPerChannel,
+                          std::vector<FakeBank>(dram.banksPerRank));
+        for (auto &rank : dram.banks) {
+            for (auto &bank : rank) {
+                bank.openRow = draw(4) == 0 ? NoRow : draw(4);
+                bank.rdAllowedAt = draw(8) * 5;
+                bank.wrAllowedAt = draw(8) * 5;
+                bank.actAllowedAt = draw(8) * 5;
+                bank.preAllowedAt = draw(8) * 5;
+            }
+        }
+        dram.rankAvailable.resize(dram.ranksPerChannel);
+        for (unsigned i = 0; i < dram.ranksPerChannel; i++)
+            dram.rankAvailable[i] = draw(8) != 0;
+        dram.readBus = draw(2);
+    }
+
+    /**
+     * Fill a queue of reads or writes, as the controller keeps them
+     * apart. Packets are also taken out of the queue at random, as they
+     * are when they issue, so that the queue order is not the order of
+     * the packets.
+     */
+    void
+    randomQueue(const FakeDram &dram, std::vector<FakePacket> &pkts,
+                FakeQueue &queue)
+    {
+        pkts.resize(48);
+        queue.clear();
+        const bool read = draw(2);
+        const unsigned num_pkts = draw(33);
+        for (auto &pkt : pkts) {
+            pkt.rank = draw(dram.ranksPerChannel);
+            pkt.bank = draw(dram.banksPerRank);
+            pkt.bankId = pkt.rank * dram.banksPerRank + pkt.bank;
+            pkt.row = draw(4);
+            pkt.read = read;
+            pkt.mine = draw(8) != 0;
+            queue.push_back(&pkt);
+            if (queue.size() > num_pkts ||
+                (!queue.empty() && draw(4) == 0)) {
+                auto it = queue.begin();
+                std::advance(it, draw(queue.size()));
+                queue.erase(it);
+            }
+        }
+        while (queue.size() > num_pkts)
+            queue.pop_front();
+    }
+};
+
+} // anonymous namespace
+
+/** The selection does not change with the per-bank bookkeeping. */
+TEST_F(FRFCFSSelectorTest, MatchesReference)
+{
+    for (int iter = 0; iter < 20000; iter++) {
+        FakeDram dram;
+        randomDram(dram);
+        FRFCFSSelector<FakeDram> selector(dram, dram.ranksPerChannel,
+                                          dram.banksPerRank);
+
+        // Reuse the selector for several decisions, as the interface
+        // does, so that stale per-bank state would show.
+        std::vector<FakePacket> pkts;
+        FakeQueue queue;
+        for (int decision = 0; decision < 8; decision++) {
+            randomQueue(dram, pkts, queue);
+            Tick min_col_at = draw(10) * 5;
+
+            auto expected = dram.referenceSelect(queue, min_col_at);
+            auto selected = selector.select(queue, min_col_at);
+
+            ASSERT_EQ(selected.first - queue.begin(),
+                      expected.first - queue.begin())
+                << "iteration " << iter << ", decision " << decision;
+            ASSERT_EQ(selected.second, expected.second)
+                << "iteration " << iter << ", decision " << decision;
+        }
+    }
+}
+
+/** The per-bank index follows the queue as packets come and go. */
+TEST_F(FRFCFSSelectorTest, QueueIndex)
+{
+    std::vector<FakePacket> pkts(6);
+    FakeQueue queue;
+    for (unsigned i = 0; i < pkts.size(); i++) {
+        pkts[i].bankId = i % 2;
+        queue.push_back(&pkts[i]);
+    }
+
+    queue.erase(queue.begin() + 2);
+    queue.pop_front();
+    queue.push_back(&pkts[0]);
+
+    ASSERT_EQ(queue.numBanks(), 2);
+    std::vector<FakePacket*> bank0;
+    uint64_t last_seq = 0;
+    for (const auto &entry : queue.bankEntries(0)) {
+        EXPECT_TRUE(bank0.empty() || entry.seq > last_seq);
+        last_seq = entry.seq;
+        bank0.push_back(entry.pkt);
+    }
+    EXPECT_EQ(bank0, std::vector<FakePacket*>({&pkts[4], &pkts[0]}));
+    EXPECT_EQ(queue.bankEntries(1).size(), 3);
+
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(queue.bankEntries(0).empty());
+    EXPECT_TRUE(queue.bankEntries(1).empty());
+}
+
+TEST_F(FRFCFSSelectorTest, EmptyQueue)
+{
+    FakeDram dram;
+    randomDram(dram);
+    FRFCFSSelector<FakeDram> selector(dram, dram.ranksPerChannel,
+                                      dram.banksPerRank);
+    FakeQueue queue;
+
+    auto selected = selector.select(queue, 0);
+    EXPECT_EQ(selected.first, queue.end());
+    EXPECT_EQ(selected.second, MaxTick);
+}
+
+TEST_F(FRFCFSSelectorTest, SeamlessHitFirst)
+{
+    FakeDram dram;
+    dram.ranksPerChannel = 1;
+    dram.banksPerRank = 2;
+    dram.banks.assign(1, std::vector<FakeBank>(2));
+    dram.banks[0][0] = {NoRow, 0, 0, 0, 0};
+    dram.banks[0][1] = {3, 10, 10, 0, 0};
+    dram.rankAvailable = {true};
+    dram.readBus = true;
+    FRFCFSSelector<FakeDram> selector(dram, 1, 2);
+
+    FakePacket miss = {0, 0, 0, 1, true, true};
+    FakePacket hit = {0, 1, 1, 3, true, true};
+    FakeQueue queue;
+    queue.push_back(&miss);
+    queue.push_back(&hit);
+
+    // The hit is seamless, so it goes ahead of the older miss.
+    auto selected = selector.select(queue, 10);
+    EXPECT_EQ(*selected.first, &hit);
+    EXPECT_EQ(selected.second, 10);
+
+    // Once it is not, the miss to the bank that can be activated
+    // behind the scenes goes first.
+    selected = selector.select(queue, 5);
+    EXPECT_EQ(*selected.first, &miss);
+    EXPECT_EQ(selected.second, 0);
+}
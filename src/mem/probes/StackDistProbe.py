@@ -58,6 +58,14 @@ class StackDistProbe(BaseMemProbe):
         False, "Verify behaviuor with reference implementation"
     )
 
+    # spatial sampling of the tracked addresses
+    sampling_shift = Param.Unsigned(
+        0,
+        "Only track the lines whose address hash falls in 1 of "
+        "2^sampling_shift buckets, scaling their stack distances and counts "
+        "by 2^sampling_shift to approximate the full distribution",
+    )
+
     # linear histogram bins and enable/disable
     linear_hist_bins = Param.Unsigned("16", "Bins in linear histograms")
     disable_linear_hists = Param.Bool(False, "Disable linear histograms")
@@ -37,6 +37,7 @@
 
 #include "mem/probes/stack_dist.hh"
 
+#include "base/bitfield.hh"
 #include "params/StackDistProbe.hh"
 #include "sim/system.hh"
 
@@ -48,12 +49,16 @@ StackDistProbe::StackDistProbe(const StackDistProbeParams &p)
       lineSize(p.line_size),
       disableLinearHists(p.disable_linear_hists),
       disableLogHists(p.disable_log_hists),
+      samplingShift(p.sampling_shift),
       calc(p.verify),
       stats(this)
 {
     fatal_if(p.system->cacheLineSize() > p.line_size,
              "The stack distance probe must use a cache line size that is "
              "larger or equal to the system's cahce line size.");
+    fatal_if(samplingShift > 30,
+             "The stack distance probe can't sample less than 1 in 2^30 "
+             "lines.");
 }
 
 StackDistProbe::StackDistProbeStats::StackDistProbeStats(
@@ -95,6 +100,24 @@ StackDistProbe::StackDistProbeStats::StackDistProbeStats(
         .flags(nozero);
 }
 
+bool
+StackDistProbe::isSampled(Addr line_addr) const
+{
+    if (!samplingShift)
+        return true;
+
+    // Mix all the bits of the line number, so that strided
+    // accesses are sampled like any others
+    uint64_t hash = line_addr / lineSize;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    return (hash & mask(samplingShift)) == 0;
+}
+
 void
 StackDistProbe::handleRequest(const probing::PacketInfo &pkt_info)
 {
@@ -106,19 +129,26 @@ StackDistProbe::handleRequest(const probing::PacketInfo &pkt_info)
     // Align the address to a cache line size
     const Addr aligned_addr(roundDown(pkt_info.addr, lineSize));
 
+    if (!isSampled(aligned_addr))
+        return;
+
+    // Each tracked access stands for 2^samplingShift accesses
+    const int weight = 1 << samplingShift;
+
     // Calculate the stack distance
-    const uint64_t sd(calc.calcStackDistAndUpdate(aligned_addr).first);
+    uint64_t sd(calc.calcStackDistAndUpdate(aligned_addr).first);
     if (sd == StackDistCalc::Infinity) {
-        stats.infiniteSD++;
+        stats.infiniteSD += weight;
         return;
     }
+    sd <<= samplingShift;
 
     // Sample the stack distance of the address in linear bins
     if (!disableLinearHists) {
         if (pkt_info.cmd.isRead())
-            stats.readLinearHist.sample(sd);
+            stats.readLinearHist.sample(sd, weight);
         else
-            stats.writeLinearHist.sample(sd);
+            stats.writeLinearHist.sample(sd, weight);
     }
 
     if (!disableLogHists) {
@@ -126,9 +156,9 @@ StackDistProbe::handleRequest(const probing::PacketInfo &pkt_info)
 
         // Sample the stack distance of the address in log bins
         if (pkt_info.cmd.isRead())
-            stats.readLogHist.sample(sd_lg2);
+            stats.readLogHist.sample(sd_lg2, weight);
         else
-            stats.writeLogHist.sample(sd_lg2);
+            stats.writeLogHist.sample(sd_lg2, weight);
     }
 }
 
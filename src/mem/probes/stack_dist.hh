@@ -66,6 +66,19 @@ class StackDistProbe : public BaseMemProbe
     // Disable the logarithmic histograms
     const bool disableLogHists;
 
+    // Log2 of the ratio of lines tracked when sampling
+    const unsigned samplingShift;
+
+    /**
+     * Check if a line is tracked. Lines are picked by hashing their
+     * address, so every access to a tracked line is seen and the stack
+     * distances among tracked lines scale with the sampling ratio.
+     *
+     * @param line_addr Address of the line
+     * @return Whether accesses to the line are tracked
+     */
+    bool isSampled(Addr line_addr) const;
+
   protected:
     StackDistCalc calc;
 
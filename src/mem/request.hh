@@ -830,6 +830,13 @@ class Request : public Extensible<Request>
         _cacheCoherenceFlags.clear(extraFlags);
     }
 
+    /** Accessor for cache coherence flags. */
+    CacheCoherenceFlags
+    getCacheCoherenceFlags() const
+    {
+        return _cacheCoherenceFlags;
+    }
+
     /** Accessor function for vaddr.*/
     bool
     hasVaddr() const
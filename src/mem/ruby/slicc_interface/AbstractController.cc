@@ -415,6 +415,20 @@ AbstractController::recvAtomic(PacketPtr pkt)
    return ticksToCycles(memoryPort.sendAtomic(pkt));
 }
 
+Tick
+AbstractController::recvAtomicBackdoor(PacketPtr pkt,
+                                       MemBackdoorPtr &backdoor)
+{
+    return ticksToCycles(memoryPort.sendAtomicBackdoor(pkt, backdoor));
+}
+
+void
+AbstractController::recvMemBackdoorReq(const MemBackdoorReq &req,
+                                       MemBackdoorPtr &backdoor)
+{
+    memoryPort.sendMemBackdoorReq(req, backdoor);
+}
+
 MachineID
 AbstractController::mapAddressToMachine(Addr addr, MachineType mtype) const
 {
@@ -176,6 +176,9 @@ class AbstractController : public ClockedObject, public Consumer
 
     bool recvTimingResp(PacketPtr pkt);
     Tick recvAtomic(PacketPtr pkt);
+    Tick recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &backdoor);
+    void recvMemBackdoorReq(const MemBackdoorReq &req,
+                            MemBackdoorPtr &backdoor);
 
     const AddrRangeList &getAddrRanges() const { return addrRanges; }
 
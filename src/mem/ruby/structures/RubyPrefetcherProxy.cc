@@ -185,6 +185,13 @@ RubyPrefetcherProxy::notifyPfMiss(const RequestPtr& req, bool is_read,
     scheduleNextPrefetch();
 }
 
+void
+RubyPrefetcherProxy::countDemandMiss()
+{
+    if (prefetcher)
+        prefetcher->incrDemandMhsrMisses();
+}
+
 void
 RubyPrefetcherProxy::notifyPfFill(const RequestPtr& req,
                                  const DataBlock& data_blk,
@@ -100,6 +100,13 @@ class RubyPrefetcherProxy : public CacheAccessor, public Named
     void notifyPfEvict(Addr blkAddr, bool hwPrefetched,
                        RequestorID requestorID);
 
+    /**
+     * Count a demand miss towards the prefetcher coverage. Classic caches
+     * count their MSHR misses, which Ruby controllers don't have, so the
+     * protocols that report coverage call this on demand misses.
+     */
+    void countDemandMiss();
+
     /** Registers probes. */
     void regProbePoints();
 
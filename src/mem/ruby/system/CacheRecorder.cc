@@ -29,10 +29,19 @@
 
 #include "mem/ruby/system/CacheRecorder.hh"
 
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
 #include "debug/RubyCacheTrace.hh"
 #include "mem/packet.hh"
 #include "mem/ruby/system/RubySystem.hh"
 #include "mem/ruby/system/Sequencer.hh"
+#include "sim/byteswap.hh"
 #include "sim/sim_exit.hh"
 
 namespace gem5
@@ -41,57 +50,323 @@ namespace gem5
 namespace ruby
 {
 
+namespace
+{
+
+/** Identifies a trace file in the current format ("RCTR") */
+constexpr uint32_t traceMagic = 0x52544352;
+
+/** Size of the chunks in which a trace is compressed and decompressed */
+constexpr size_t traceChunkSize = 64 * 1024;
+
+/**
+ * Maximum number of records read ahead on behalf of a port during a
+ * parallel warmup, bounding the memory used when the records of some
+ * port are far apart in the trace.
+ */
+constexpr size_t maxPendingRecords = 4096;
+
+static_assert(RubyRequestType_NUM <= 128,
+              "The request type must fit in 7 bits of a trace record");
+
+/**
+ * Layout of the records of the legacy trace format, which was a raw dump
+ * of the records as they were laid out in memory.
+ */
+struct LegacyTraceRecord
+{
+    int m_cntrl_id;
+    Tick m_time;
+    Addr m_data_address;
+    Addr m_pc_address;
+    RubyRequestType m_type;
+    uint8_t m_data[0];
+};
+
+template <typename T>
 void
-TraceRecord::print(std::ostream& out) const
+putFixed(std::vector<uint8_t> &buf, T value)
 {
-    out << "[TraceRecord: Node, " << m_cntrl_id << ", "
-        << m_data_address << ", " << m_pc_address << ", "
-        << m_type << ", Time: " << m_time << "]";
+    value = htole(value);
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+    buf.insert(buf.end(), bytes, bytes + sizeof(T));
+}
+
+void
+putVarint(std::vector<uint8_t> &buf, uint64_t value)
+{
+    while (value >= 0x80) {
+        buf.push_back(uint8_t(value) | 0x80);
+        value >>= 7;
+    }
+    buf.push_back(uint8_t(value));
 }
 
-CacheRecorder::CacheRecorder()
-    : m_uncompressed_trace(NULL),
-      m_uncompressed_trace_size(0),
-      m_block_size_bytes(RubySystem::getBlockSizeBytes())
+uint64_t
+zigzagEncode(int64_t value)
 {
+    return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
 }
 
-CacheRecorder::CacheRecorder(uint8_t* uncompressed_trace,
-                             uint64_t uncompressed_trace_size,
-                             std::vector<RubyPort*>& ruby_port_map,
-                             uint64_t block_size_bytes)
-    : m_uncompressed_trace(uncompressed_trace),
-      m_uncompressed_trace_size(uncompressed_trace_size),
-      m_ruby_port_map(ruby_port_map), m_bytes_read(0),
-      m_records_read(0), m_records_flushed(0),
-      m_block_size_bytes(block_size_bytes)
+int64_t
+zigzagDecode(uint64_t value)
+{
+    return int64_t(value >> 1) ^ -int64_t(value & 1);
+}
 
+void
+writeChunk(gzFile file, const std::string &filename,
+           std::vector<uint8_t> &buf)
 {
-    if (m_uncompressed_trace != NULL) {
-        if (m_block_size_bytes < RubySystem::getBlockSizeBytes()) {
-            // Block sizes larger than when the trace was recorded are not
-            // supported, as we cannot reliably turn accesses to smaller blocks
-            // into larger ones.
-            panic("Recorded cache block size (%d) < current block size (%d) !!",
-                    m_block_size_bytes, RubySystem::getBlockSizeBytes());
+    if (buf.empty())
+        return;
+    if (gzwrite(file, buf.data(), buf.size()) != buf.size()) {
+        fatal("Write failed on cache trace file '%s'\n", filename);
+    }
+    buf.clear();
+}
+
+} // anonymous namespace
+
+/**
+ * Incremental decoder of a trace in the current format. The trace is
+ * decompressed in chunks, so the memory needed to replay it does not
+ * depend on the size of the caches.
+ */
+class CacheRecorder::TraceReader
+{
+  public:
+    TraceReader(const std::string &filename)
+        : filename(filename), buffer(traceChunkSize), pos(0), end(0)
+    {
+        file = gzopen(filename.c_str(), "rb");
+        if (file == NULL) {
+            fatal("Unable to open cache trace file %s\n", filename);
+        }
+
+        uint32_t magic = readFixed<uint32_t>();
+        fatal_if(magic != traceMagic,
+                 "%s is not a Ruby cache trace\n", filename);
+        version = readFixed<uint32_t>();
+        blockSize = readFixed<uint64_t>();
+        numRecords = readFixed<uint64_t>();
+    }
+
+    ~TraceReader()
+    {
+        if (gzclose(file)) {
+            warn("Failed to close cache trace file '%s'\n", filename);
         }
     }
+
+    /**
+     * Decode the next record of the trace.
+     *
+     * @return false if all the records have been read
+     */
+    bool
+    read(TraceRecord &rec, uint8_t *data)
+    {
+        if (recordsRead == numRecords)
+            return false;
+
+        rec.m_cntrl_id = readVarint();
+        uint8_t type_flags = readByte();
+        rec.m_type = RubyRequestType(type_flags >> 1);
+
+        if (rec.m_cntrl_id >= lastBlock.size())
+            lastBlock.resize(rec.m_cntrl_id + 1, 0);
+        Addr &last_block = lastBlock[rec.m_cntrl_id];
+        last_block += zigzagDecode(readVarint());
+        rec.m_data_address = last_block * blockSize;
+        rec.m_pc_address = readVarint();
+        lastTime += zigzagDecode(readVarint());
+        rec.m_time = lastTime;
+        rec.m_data_offset = 0;
+
+        if (type_flags & 1) {
+            std::memset(data, 0, blockSize);
+        } else {
+            readBytes(data, blockSize);
+        }
+
+        recordsRead++;
+        return true;
+    }
+
+    uint32_t version;
+    uint64_t blockSize;
+    uint64_t numRecords;
+
+  private:
+    void
+    fill()
+    {
+        int bytes = gzread(file, buffer.data(), buffer.size());
+        if (bytes <= 0) {
+            fatal("Unexpected end of cache trace file %s\n", filename);
+        }
+        pos = 0;
+        end = bytes;
+    }
+
+    uint8_t
+    readByte()
+    {
+        if (pos == end)
+            fill();
+        return buffer[pos++];
+    }
+
+    void
+    readBytes(uint8_t *dst, size_t size)
+    {
+        while (size > 0) {
+            if (pos == end)
+                fill();
+            size_t bytes = std::min(size, end - pos);
+            std::memcpy(dst, &buffer[pos], bytes);
+            pos += bytes;
+            dst += bytes;
+            size -= bytes;
+        }
+    }
+
+    template <typename T>
+    T
+    readFixed()
+    {
+        T value;
+        readBytes(reinterpret_cast<uint8_t *>(&value), sizeof(T));
+        return letoh(value);
+    }
+
+    uint64_t
+    readVarint()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = readByte();
+            value |= uint64_t(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return value;
+        }
+        fatal("Corrupted record in cache trace file %s\n", filename);
+    }
+
+    const std::string filename;
+    gzFile file;
+    std::vector<uint8_t> buffer;
+    size_t pos;
+    size_t end;
+
+    uint64_t recordsRead = 0;
+    /** Last block number replayed by each controller */
+    std::vector<Addr> lastBlock;
+    Tick lastTime = 0;
+};
+
+void
+TraceRecord::print(std::ostream& out) const
+{
+    out << "[TraceRecord: Node, " << m_cntrl_id << ", "
+        << m_data_address << ", " << m_pc_address << ", "
+        << m_type << ", Time: " << m_time << "]";
 }
 
-CacheRecorder::~CacheRecorder()
+CacheRecorder::CacheRecorder(std::vector<RubyPort*>& ruby_port_map,
+                             uint64_t block_size_bytes,
+                             bool parallel_warmup)
+    : m_ruby_port_map(ruby_port_map), m_parallel_warmup(parallel_warmup),
+      m_warmup_done(false), m_full_slots(0), m_records_read(0),
+      m_records_flushed(0), m_block_size_bytes(block_size_bytes)
 {
-    if (m_uncompressed_trace != NULL) {
-        delete [] m_uncompressed_trace;
-        m_uncompressed_trace = NULL;
+    // Each port replays its own records when the warmup is parallel,
+    // otherwise all the records are replayed one after the other.
+    if (m_parallel_warmup) {
+        for (auto port : m_ruby_port_map) {
+            if (m_port_slot.emplace(port, m_slots.size()).second)
+                m_slots.emplace_back();
+        }
+    } else {
+        m_slots.resize(1);
     }
+    for (auto &slot : m_slots)
+        slot.data.resize(m_block_size_bytes);
+}
+
+CacheRecorder::~CacheRecorder()
+{
     m_ruby_port_map.clear();
 }
 
+void
+CacheRecorder::openTrace(const std::string &filename, int version,
+                         uint64_t legacy_trace_size)
+{
+    if (m_block_size_bytes < RubySystem::getBlockSizeBytes()) {
+        // Block sizes larger than when the trace was recorded are not
+        // supported, as we cannot reliably turn accesses to smaller blocks
+        // into larger ones.
+        panic("Recorded cache block size (%d) < current block size (%d) !!",
+                m_block_size_bytes, RubySystem::getBlockSizeBytes());
+    }
+
+    fatal_if(version > traceVersion,
+             "Unsupported cache trace version %d in %s\n", version, filename);
+
+    if (version > 0) {
+        m_reader.reset(new TraceReader(filename));
+        fatal_if(m_reader->version != version,
+                 "Cache trace %s has version %d, expected %d\n", filename,
+                 m_reader->version, version);
+        fatal_if(m_reader->blockSize != m_block_size_bytes,
+                 "Cache trace %s was recorded with %d-byte blocks, "
+                 "expected %d\n", filename, m_reader->blockSize,
+                 m_block_size_bytes);
+        return;
+    }
+
+    // The legacy format has to be read at once, since it was a raw dump
+    // of the trace.
+    gzFile file = gzopen(filename.c_str(), "rb");
+    if (file == NULL) {
+        fatal("Unable to open trace file %s\n", filename);
+    }
+
+    std::vector<uint8_t> raw_data(legacy_trace_size);
+    if (gzread(file, raw_data.data(), legacy_trace_size) <
+            legacy_trace_size) {
+        fatal("Unable to read complete trace from file %s\n", filename);
+    }
+
+    if (gzclose(file)) {
+        fatal("Failed to close cache trace file '%s'\n", filename);
+    }
+
+    uint64_t record_size = sizeof(LegacyTraceRecord) + m_block_size_bytes;
+    for (uint64_t offset = 0; offset + record_size <= legacy_trace_size;
+            offset += record_size) {
+        const LegacyTraceRecord *legacy =
+            (const LegacyTraceRecord *)&raw_data[offset];
+        TraceRecord rec;
+        rec.m_cntrl_id = legacy->m_cntrl_id;
+        rec.m_time = legacy->m_time;
+        rec.m_data_address = legacy->m_data_address;
+        rec.m_pc_address = legacy->m_pc_address;
+        rec.m_type = legacy->m_type;
+        rec.m_data_offset = m_data.size();
+        m_data.insert(m_data.end(), legacy->m_data,
+                      legacy->m_data + m_block_size_bytes);
+        m_records.push_back(rec);
+    }
+}
+
 void
 CacheRecorder::enqueueNextFlushRequest()
 {
     if (m_records_flushed < m_records.size()) {
-        TraceRecord* rec = m_records[m_records_flushed];
+        TraceRecord* rec = &m_records[m_records_flushed];
         m_records_flushed++;
         auto req = std::make_shared<Request>(rec->m_data_address,
                                              m_block_size_bytes, 0,
@@ -115,72 +390,179 @@ CacheRecorder::enqueueNextFlushRequest()
     }
 }
 
+bool
+CacheRecorder::readRecord(TraceRecord &rec, uint8_t *data)
+{
+    if (m_reader) {
+        if (!m_reader->read(rec, data))
+            return false;
+    } else {
+        if (m_records_read == m_records.size())
+            return false;
+        rec = m_records[m_records_read];
+        std::memcpy(data, &m_data[rec.m_data_offset], m_block_size_bytes);
+    }
+    m_records_read++;
+    return true;
+}
+
+int
+CacheRecorder::slotOf(int cntrl) const
+{
+    return m_parallel_warmup ? m_port_slot.at(m_ruby_port_map[cntrl]) : 0;
+}
+
+bool
+CacheRecorder::nextRecordFor(int slot, TraceRecord &rec)
+{
+    ReplaySlot &replay = m_slots[slot];
+    replay.stalled = false;
+    if (!replay.pending.empty()) {
+        if (replay.pending.size() == maxPendingRecords)
+            m_full_slots--;
+        rec = replay.pending.front().record;
+        replay.data.swap(replay.pending.front().data);
+        replay.pending.pop_front();
+        return true;
+    }
+
+    // The slot has nothing in flight, so its buffer can hold the records
+    // read on behalf of the other slots until one of its own shows up.
+    // The trace is not read any further while a slot has a full queue,
+    // and this slot then waits for that queue to drain.
+    while (m_full_slots == 0 && readRecord(rec, replay.data.data())) {
+        int owner = slotOf(rec.m_cntrl_id);
+        if (owner == slot)
+            return true;
+        auto &pending = m_slots[owner].pending;
+        pending.push_back({rec, replay.data});
+        if (pending.size() == maxPendingRecords)
+            m_full_slots++;
+    }
+    replay.stalled = m_full_slots > 0;
+    return false;
+}
+
 void
-CacheRecorder::enqueueNextFetchRequest()
-{
-    if (m_bytes_read < m_uncompressed_trace_size) {
-        TraceRecord* traceRecord = (TraceRecord*) (m_uncompressed_trace +
-                                                                m_bytes_read);
-
-        DPRINTF(RubyCacheTrace, "Issuing %s\n", *traceRecord);
-
-        for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
-                rec_bytes_read += RubySystem::getBlockSizeBytes()) {
-            RequestPtr req;
-            MemCmd::Command requestType;
-
-            if (traceRecord->m_type == RubyRequestType_LD) {
-                requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
-                    traceRecord->m_data_address + rec_bytes_read,
-                    RubySystem::getBlockSizeBytes(), 0,
-                                    Request::funcRequestorId);
-            }   else if (traceRecord->m_type == RubyRequestType_IFETCH) {
-                requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
-                        traceRecord->m_data_address + rec_bytes_read,
-                        RubySystem::getBlockSizeBytes(),
-                        Request::INST_FETCH, Request::funcRequestorId);
-            }   else {
-                requestType = MemCmd::WriteReq;
-                req = std::make_shared<Request>(
-                    traceRecord->m_data_address + rec_bytes_read,
-                    RubySystem::getBlockSizeBytes(), 0,
-                                Request::funcRequestorId);
+CacheRecorder::resumeStalledSlots()
+{
+    // Issuing a record may drain a full queue or fill the queue of
+    // another stalled slot, so keep going until nothing changes
+    TraceRecord rec;
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (int slot = 0; slot < m_slots.size(); slot++) {
+            if (m_slots[slot].stalled && nextRecordFor(slot, rec)) {
+                issueRecord(slot, rec);
+                progress = true;
             }
+        }
+    }
+}
 
-            Packet *pkt = new Packet(req, requestType);
-            pkt->dataStatic(traceRecord->m_data + rec_bytes_read);
-            pkt->req->setReqInstSeqNum(m_records_read);
+void
+CacheRecorder::issueRecord(int slot, const TraceRecord &rec)
+{
+    ReplaySlot &replay = m_slots[slot];
+    DPRINTF(RubyCacheTrace, "Issuing %s\n", rec);
+
+    replay.outstanding = m_block_size_bytes / RubySystem::getBlockSizeBytes();
+    for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
+            rec_bytes_read += RubySystem::getBlockSizeBytes()) {
+        RequestPtr req;
+        MemCmd::Command requestType;
+
+        if (rec.m_type == RubyRequestType_LD) {
+            requestType = MemCmd::ReadReq;
+            req = std::make_shared<Request>(
+                rec.m_data_address + rec_bytes_read,
+                RubySystem::getBlockSizeBytes(), 0,
+                                Request::funcRequestorId);
+        }   else if (rec.m_type == RubyRequestType_IFETCH) {
+            requestType = MemCmd::ReadReq;
+            req = std::make_shared<Request>(
+                    rec.m_data_address + rec_bytes_read,
+                    RubySystem::getBlockSizeBytes(),
+                    Request::INST_FETCH, Request::funcRequestorId);
+        }   else {
+            requestType = MemCmd::WriteReq;
+            req = std::make_shared<Request>(
+                rec.m_data_address + rec_bytes_read,
+                RubySystem::getBlockSizeBytes(), 0,
+                            Request::funcRequestorId);
+        }
 
+        Packet *pkt = new Packet(req, requestType);
+        pkt->dataStatic(replay.data.data() + rec_bytes_read);
+        pkt->req->setReqInstSeqNum(m_records_read);
 
-            RubyPort* m_ruby_port_ptr =
-                m_ruby_port_map[traceRecord->m_cntrl_id];
-            assert(m_ruby_port_ptr != NULL);
-            m_ruby_port_ptr->makeRequest(pkt);
-        }
 
-        m_bytes_read += (sizeof(TraceRecord) + m_block_size_bytes);
-        m_records_read++;
-    } else {
-        exitSimLoop("Finished Warmup", 0);
-        DPRINTF(RubyCacheTrace, "Fetched all %d records\n", m_records_read);
+        RubyPort* m_ruby_port_ptr = m_ruby_port_map[rec.m_cntrl_id];
+        assert(m_ruby_port_ptr != NULL);
+        m_ruby_port_ptr->makeRequest(pkt);
+    }
+}
+
+void
+CacheRecorder::finishWarmupIfDone()
+{
+    if (m_warmup_done)
+        return;
+
+    // A slot only becomes idle once the trace has no records left for it
+    for (const auto &slot : m_slots) {
+        if (slot.outstanding > 0 || slot.stalled)
+            return;
     }
+
+    m_warmup_done = true;
+    m_reader.reset();
+    exitSimLoop("Finished Warmup", 0);
+    DPRINTF(RubyCacheTrace, "Fetched all %d records\n", m_records_read);
+}
+
+void
+CacheRecorder::startWarmup()
+{
+    TraceRecord rec;
+    for (int slot = 0; slot < m_slots.size(); slot++) {
+        if (nextRecordFor(slot, rec))
+            issueRecord(slot, rec);
+    }
+    resumeStalledSlots();
+    finishWarmupIfDone();
+}
+
+void
+CacheRecorder::enqueueNextFetchRequest(RubyPort *port)
+{
+    int slot = m_parallel_warmup ? m_port_slot.at(port) : 0;
+    ReplaySlot &replay = m_slots[slot];
+    assert(replay.outstanding > 0);
+    if (--replay.outstanding > 0)
+        return;
+
+    TraceRecord rec;
+    if (nextRecordFor(slot, rec))
+        issueRecord(slot, rec);
+    resumeStalledSlots();
+    finishWarmupIfDone();
 }
 
 void
 CacheRecorder::addRecord(int cntrl, Addr data_addr, Addr pc_addr,
                          RubyRequestType type, Tick time, DataBlock& data)
 {
-    TraceRecord* rec = (TraceRecord*)malloc(sizeof(TraceRecord) +
-                                            m_block_size_bytes);
-    rec->m_cntrl_id     = cntrl;
-    rec->m_time         = time;
-    rec->m_data_address = data_addr;
-    rec->m_pc_address   = pc_addr;
-    rec->m_type         = type;
-    memcpy(rec->m_data, data.getData(0, m_block_size_bytes),
-           m_block_size_bytes);
+    TraceRecord rec;
+    rec.m_cntrl_id     = cntrl;
+    rec.m_time         = time;
+    rec.m_data_address = data_addr;
+    rec.m_pc_address   = pc_addr;
+    rec.m_type         = type;
+    rec.m_data_offset  = m_data.size();
+    const uint8_t *block = data.getData(0, m_block_size_bytes);
+    m_data.insert(m_data.end(), block, block + m_block_size_bytes);
 
     DPRINTF(RubyCacheTrace, "Inside addRecord with cntrl id %d and type %d\n",
             cntrl, type);
@@ -188,39 +570,56 @@ CacheRecorder::addRecord(int cntrl, Addr data_addr, Addr pc_addr,
 }
 
 uint64_t
-CacheRecorder::aggregateRecords(uint8_t **buf, uint64_t total_size)
+CacheRecorder::writeTrace(const std::string &filename)
 {
-    std::sort(m_records.begin(), m_records.end(), compareTraceRecords);
-
-    int size = m_records.size();
-    uint64_t current_size = 0;
-    int record_size = sizeof(TraceRecord) + m_block_size_bytes;
-
-    for (int i = 0; i < size; ++i) {
-        // Determine if we need to expand the buffer size
-        if (current_size + record_size > total_size) {
-            uint8_t* new_buf = new (std::nothrow) uint8_t[total_size * 2];
-            if (new_buf == NULL) {
-                fatal("Unable to allocate buffer of size %s\n",
-                      total_size * 2);
-            }
-            total_size = total_size * 2;
-            uint8_t* old_buf = *buf;
-            memcpy(new_buf, old_buf, current_size);
-            *buf = new_buf;
-            delete [] old_buf;
-        }
+    std::stable_sort(m_records.begin(), m_records.end(),
+                     compareTraceRecords);
 
-        // Copy the current record into the buffer
-        memcpy(&((*buf)[current_size]), m_records[i], record_size);
-        current_size += record_size;
+    gzFile file = gzopen(filename.c_str(), "wb");
+    if (file == NULL) {
+        fatal("Can't open cache trace file '%s'\n", filename);
+    }
 
-        free(m_records[i]);
-        m_records[i] = NULL;
+    std::vector<uint8_t> buf;
+    buf.reserve(traceChunkSize + m_block_size_bytes + 64);
+    putFixed<uint32_t>(buf, traceMagic);
+    putFixed<uint32_t>(buf, traceVersion);
+    putFixed<uint64_t>(buf, m_block_size_bytes);
+    putFixed<uint64_t>(buf, m_records.size());
+
+    unsigned block_bits = floorLog2(m_block_size_bytes);
+    std::vector<Addr> last_block;
+    Tick last_time = 0;
+    for (const auto &rec : m_records) {
+        assert((rec.m_data_address & (m_block_size_bytes - 1)) == 0);
+        const uint8_t *data = &m_data[rec.m_data_offset];
+        bool zero = std::all_of(data, data + m_block_size_bytes,
+                                [](uint8_t byte) { return byte == 0; });
+
+        if (rec.m_cntrl_id >= last_block.size())
+            last_block.resize(rec.m_cntrl_id + 1, 0);
+        Addr block = rec.m_data_address >> block_bits;
+
+        putVarint(buf, rec.m_cntrl_id);
+        buf.push_back((uint8_t(rec.m_type) << 1) | (zero ? 1 : 0));
+        putVarint(buf, zigzagEncode(block - last_block[rec.m_cntrl_id]));
+        putVarint(buf, rec.m_pc_address);
+        putVarint(buf, zigzagEncode(rec.m_time - last_time));
+        if (!zero)
+            buf.insert(buf.end(), data, data + m_block_size_bytes);
+
+        last_block[rec.m_cntrl_id] = block;
+        last_time = rec.m_time;
+
+        if (buf.size() >= traceChunkSize)
+            writeChunk(file, filename, buf);
     }
+    writeChunk(file, filename, buf);
 
-    m_records.clear();
-    return current_size;
+    if (gzclose(file)) {
+        fatal("Close failed on cache trace file '%s'\n", filename);
+    }
+    return m_records.size();
 }
 
 uint64_t
@@ -35,6 +35,10 @@
 #ifndef __MEM_RUBY_SYSTEM_CACHERECORDER_HH__
 #define __MEM_RUBY_SYSTEM_CACHERECORDER_HH__
 
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "base/types.hh"
@@ -51,11 +55,12 @@ namespace ruby
 
 class Sequencer;
 class RubyPort;
+
 /*!
- * Class for recording cache contents. Note that the last element of the
- * class is an array of length zero. It is used for creating variable
- * length object, so that while writing the data to a file one does not
- * need to copy the meta data and the actual data separately.
+ * Class for recording cache contents. The block data of a record is not
+ * kept in the record itself, but in a buffer shared by all the records of
+ * a recorder, so that recording a cache does not need an allocation per
+ * block.
  */
 class TraceRecord
 {
@@ -65,7 +70,8 @@ class TraceRecord
     Addr m_data_address;
     Addr m_pc_address;
     RubyRequestType m_type;
-    uint8_t m_data[0];
+    /** Offset of the block data in the data buffer of the recorder */
+    uint64_t m_data_offset;
 
     void print(std::ostream& out) const;
 };
@@ -73,20 +79,45 @@ class TraceRecord
 class CacheRecorder
 {
   public:
-    CacheRecorder();
+    /**
+     * Version of the checkpointed trace format. Version 0 is the legacy
+     * format, which was a raw dump of the trace records.
+     */
+    static constexpr int traceVersion = 1;
+
+    CacheRecorder(std::vector<RubyPort*>& ruby_port_map,
+                  uint64_t block_size_bytes, bool parallel_warmup);
     ~CacheRecorder();
 
-    CacheRecorder(uint8_t* uncompressed_trace,
-                  uint64_t uncompressed_trace_size,
-                  std::vector<RubyPort*>& ruby_port_map,
-                  uint64_t block_size_bytes);
     void addRecord(int cntrl, Addr data_addr, Addr pc_addr,
                    RubyRequestType type, Tick time, DataBlock& data);
 
-    uint64_t aggregateRecords(uint8_t **data, uint64_t size);
-
     uint64_t getNumRecords() const;
 
+    /**
+     * Write the recorded contents of the caches to a compressed trace file.
+     * The records are sorted so that the most recently accessed blocks are
+     * replayed first, and are streamed to the file as they are encoded:
+     * the addresses are delta-encoded against the previous block of the
+     * same controller, and blocks full of zeros carry no data.
+     *
+     * @param filename Path of the trace file
+     * @return The number of records written
+     */
+    uint64_t writeTrace(const std::string &filename);
+
+    /**
+     * Open a checkpointed trace to warm up the caches. Traces in the
+     * current format are decoded incrementally during the warmup, so
+     * they never need to be fully loaded in memory.
+     *
+     * @param filename Path of the trace file
+     * @param version Format version of the trace
+     * @param legacy_trace_size Uncompressed size of a legacy trace
+     */
+    void openTrace(const std::string &filename, int version,
+                   uint64_t legacy_trace_size);
+
     /*!
      * Function for flushing the memory contents of the caches to the
      * main memory. It goes through the recorded contents of the caches,
@@ -103,28 +134,94 @@ class CacheRecorder
      * checkpoint and issues fetch requests. Except for the first one, a
      * fetch request is issued only after the previous one has completed.
      * It should be possible to use this with any protocol.
+     *
+     * When the warmup is parallel, each port replays its own records in
+     * order and only waits for its own previous request to complete.
+     *
+     * @param port The port whose warmup request completed
      */
-    void enqueueNextFetchRequest();
+    void enqueueNextFetchRequest(RubyPort *port);
+
+    /** Issue the first warmup requests. */
+    void startWarmup();
 
   private:
     // Private copy constructor and assignment operator
     CacheRecorder(const CacheRecorder& obj);
     CacheRecorder& operator=(const CacheRecorder& obj);
 
-    std::vector<TraceRecord*> m_records;
-    uint8_t* m_uncompressed_trace;
-    uint64_t m_uncompressed_trace_size;
+    class TraceReader;
+
+    /** A record read ahead of time, along with its block data. */
+    struct BufferedRecord
+    {
+        TraceRecord record;
+        std::vector<uint8_t> data;
+    };
+
+    /** State of the warmup requests replayed by one port. */
+    struct ReplaySlot
+    {
+        /** Requests of the current record that are still in flight */
+        int outstanding = 0;
+        /** Block data of the current record */
+        std::vector<uint8_t> data;
+        /** Records read on behalf of this slot while serving others */
+        std::deque<BufferedRecord> pending;
+        /** Whether the slot waits for a full queue to drain */
+        bool stalled = false;
+    };
+
+    /**
+     * Read the next record of the trace, in replay order.
+     *
+     * @param rec Record to fill in
+     * @param data Buffer of a block for the data of the record
+     * @return false if the trace has no more records
+     */
+    bool readRecord(TraceRecord &rec, uint8_t *data);
+
+    /**
+     * Get the next record to be replayed by a slot.
+     *
+     * @return false if there are no records left for the slot, or if
+     *         the slot is stalled until a full queue drains
+     */
+    bool nextRecordFor(int slot, TraceRecord &rec);
+
+    /** Issue the next record of the slots that are no longer stalled. */
+    void resumeStalledSlots();
+
+    /** Replay a record through the port of a slot. */
+    void issueRecord(int slot, const TraceRecord &rec);
+
+    /** Index of the slot that replays the records of a controller. */
+    int slotOf(int cntrl) const;
+
+    void finishWarmupIfDone();
+
+    std::vector<TraceRecord> m_records;
+    std::vector<uint8_t> m_data;
     std::vector<RubyPort*> m_ruby_port_map;
-    uint64_t m_bytes_read;
+
+    /** Incremental decoder of the checkpointed trace, if any */
+    std::unique_ptr<TraceReader> m_reader;
+    std::vector<ReplaySlot> m_slots;
+    std::unordered_map<RubyPort*, int> m_port_slot;
+    bool m_parallel_warmup;
+    bool m_warmup_done;
+    /** Number of slots whose queue of pending records is full */
+    int m_full_slots;
+
     uint64_t m_records_read;
     uint64_t m_records_flushed;
     uint64_t m_block_size_bytes;
 };
 
 inline bool
-compareTraceRecords(const TraceRecord* n1, const TraceRecord* n2)
+compareTraceRecords(const TraceRecord& n1, const TraceRecord& n2)
 {
-    return n1->m_time > n2->m_time;
+    return n1.m_time > n2.m_time;
 }
 
 inline std::ostream&
@@ -1007,7 +1007,7 @@ GPUCoalescer::completeHitCallback(std::vector<PacketPtr> & mylist)
 
     RubySystem *rs = m_ruby_system;
     if (RubySystem::getWarmupEnabled()) {
-        rs->m_cache_recorder->enqueueNextFetchRequest();
+        rs->m_cache_recorder->enqueueNextFetchRequest(this);
     } else if (RubySystem::getCooldownEnabled()) {
         rs->m_cache_recorder->enqueueNextFlushRequest();
     } else {
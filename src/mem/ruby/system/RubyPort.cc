@@ -320,6 +320,44 @@ RubyPort::MemResponsePort::recvTimingReq(PacketPtr pkt)
 
 Tick
 RubyPort::MemResponsePort::recvAtomic(PacketPtr pkt)
+{
+    return atomicAccess(pkt, nullptr);
+}
+
+Tick
+RubyPort::MemResponsePort::recvAtomicBackdoor(PacketPtr pkt,
+                                              MemBackdoorPtr &backdoor)
+{
+    return atomicAccess(pkt, &backdoor);
+}
+
+AbstractController *
+RubyPort::MemResponsePort::getMemInterface(Addr addr) const
+{
+    // Find the machine type of memory controller interface
+    RubySystem *rs = owner.m_ruby_system;
+    static int mem_interface_type = -1;
+    if (mem_interface_type == -1) {
+        if (rs->m_abstract_controls[MachineType_Directory].size() != 0) {
+            mem_interface_type = MachineType_Directory;
+        }
+        else if (rs->m_abstract_controls[MachineType_Memory].size() != 0) {
+            mem_interface_type = MachineType_Memory;
+        }
+        else {
+            panic("Can't find the memory controller interface\n");
+        }
+    }
+
+    // Find the controller for the target address
+    MachineID id = owner.m_controller->mapAddressToMachine(
+                    addr, (MachineType)mem_interface_type);
+    return rs->m_abstract_controls[mem_interface_type][id.getNum()];
+}
+
+Tick
+RubyPort::MemResponsePort::atomicAccess(PacketPtr pkt,
+                                        MemBackdoorPtr *backdoor)
 {
     // Only atomic_noncaching mode supported!
     if (!owner.system->bypassCaches()) {
@@ -347,29 +385,22 @@ RubyPort::MemResponsePort::recvAtomic(PacketPtr pkt)
                RubySystem::getBlockSizeBytes());
     }
 
-    // Find the machine type of memory controller interface
     RubySystem *rs = owner.m_ruby_system;
-    static int mem_interface_type = -1;
-    if (mem_interface_type == -1) {
-        if (rs->m_abstract_controls[MachineType_Directory].size() != 0) {
-            mem_interface_type = MachineType_Directory;
-        }
-        else if (rs->m_abstract_controls[MachineType_Memory].size() != 0) {
-            mem_interface_type = MachineType_Memory;
-        }
-        else {
-            panic("Can't find the memory controller interface\n");
-        }
-    }
+    AbstractController *mem_interface = getMemInterface(pkt->getAddr());
 
-    // Find the controller for the target address
-    MachineID id = owner.m_controller->mapAddressToMachine(
-                    pkt->getAddr(), (MachineType)mem_interface_type);
-    AbstractController *mem_interface =
-        rs->m_abstract_controls[mem_interface_type][id.getNum()];
-    Tick latency = mem_interface->recvAtomic(pkt);
-    if (access_backing_store)
+    // Since the caches are bypassed, the memory holds the only copy of the
+    // data and the requestor can access it directly from now on.
+    Tick latency;
+    if (access_backing_store) {
+        latency = mem_interface->recvAtomic(pkt);
         rs->getPhysMem()->access(pkt);
+        if (backdoor)
+            rs->getPhysMem()->getBackdoor(*backdoor);
+    } else if (backdoor) {
+        latency = mem_interface->recvAtomicBackdoor(pkt, *backdoor);
+    } else {
+        latency = mem_interface->recvAtomic(pkt);
+    }
     return latency;
 }
 
@@ -448,6 +479,23 @@ RubyPort::MemResponsePort::recvFunctional(PacketPtr pkt)
     }
 }
 
+void
+RubyPort::MemResponsePort::recvMemBackdoorReq(const MemBackdoorReq &req,
+                                              MemBackdoorPtr &backdoor)
+{
+    // When the caches are in use they may hold newer data than the memory,
+    // so a backdoor can only be handed out while they are bypassed.
+    if (!owner.system->bypassCaches())
+        return;
+
+    if (access_backing_store) {
+        owner.m_ruby_system->getPhysMem()->getBackdoor(backdoor);
+    } else {
+        getMemInterface(req.range().start())->recvMemBackdoorReq(
+            req, backdoor);
+    }
+}
+
 void
 RubyPort::ruby_hit_callback(PacketPtr pkt)
 {
@@ -100,8 +100,14 @@ class RubyPort : public ClockedObject
 
         Tick recvAtomic(PacketPtr pkt);
 
+        Tick recvAtomicBackdoor(PacketPtr pkt,
+                                MemBackdoorPtr &backdoor) override;
+
         void recvFunctional(PacketPtr pkt);
 
+        void recvMemBackdoorReq(const MemBackdoorReq &req,
+                                MemBackdoorPtr &backdoor) override;
+
         AddrRangeList getAddrRanges() const
         { AddrRangeList ranges; return ranges; }
 
@@ -110,6 +116,23 @@ class RubyPort : public ClockedObject
       private:
         bool isShadowRomAddress(Addr addr) const;
         bool isPhysMemAddress(PacketPtr pkt) const;
+
+        /**
+         * Get the controller that interfaces with the memory holding an
+         * address, i.e., the directory or the memory controller.
+         */
+        AbstractController *getMemInterface(Addr addr) const;
+
+        /**
+         * Service an atomic access to memory. The caches are bypassed, so
+         * they must not hold any data (atomic_noncaching mode).
+         *
+         * @param pkt The packet to service
+         * @param backdoor If not nullptr, filled in with a backdoor to the
+         *        memory if it offers one
+         * @return The latency of the access
+         */
+        Tick atomicAccess(PacketPtr pkt, MemBackdoorPtr *backdoor);
     };
 
     class PioRequestPort : public QueuedRequestPort
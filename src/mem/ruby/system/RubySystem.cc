@@ -40,10 +40,6 @@
 
 #include "mem/ruby/system/RubySystem.hh"
 
-#include <fcntl.h>
-#include <zlib.h>
-
-#include <cstdio>
 #include <list>
 
 #include "base/compiler.hh"
@@ -78,6 +74,7 @@ bool RubySystem::m_cooldown_enabled = false;
 
 RubySystem::RubySystem(const Params &p)
     : ClockedObject(p), m_access_backing_store(p.access_backing_store),
+      m_parallel_cache_warmup(p.parallel_cache_warmup),
       m_cache_recorder(NULL)
 {
     m_randomization = p.randomization;
@@ -173,9 +170,7 @@ RubySystem::~RubySystem()
 }
 
 void
-RubySystem::makeCacheRecorder(uint8_t *uncompressed_trace,
-                              uint64_t cache_trace_size,
-                              uint64_t block_size_bytes)
+RubySystem::makeCacheRecorder(uint64_t block_size_bytes)
 {
     std::vector<RubyPort*> ruby_port_map;
     RubyPort* ruby_port_ptr = NULL;
@@ -211,9 +206,8 @@ RubySystem::makeCacheRecorder(uint8_t *uncompressed_trace,
     }
 
     // Create the CacheRecorder and record the cache trace
-    m_cache_recorder = new CacheRecorder(uncompressed_trace, cache_trace_size,
-                                         ruby_port_map,
-                                         block_size_bytes);
+    m_cache_recorder = new CacheRecorder(ruby_port_map, block_size_bytes,
+                                         m_parallel_cache_warmup);
 }
 
 void
@@ -223,7 +217,7 @@ RubySystem::memWriteback()
 
     // Make the trace so we know what to write back.
     DPRINTF(RubyCacheTrace, "Recording Cache Trace\n");
-    makeCacheRecorder(NULL, 0, getBlockSizeBytes());
+    makeCacheRecorder(getBlockSizeBytes());
     for (int cntrl = 0; cntrl < m_abs_cntrl_vec.size(); cntrl++) {
         m_abs_cntrl_vec[cntrl]->recordCacheTrace(cntrl, m_cache_recorder);
     }
@@ -296,35 +290,6 @@ RubySystem::memWriteback()
     // checkpoint is immediately taken.
 }
 
-void
-RubySystem::writeCompressedTrace(uint8_t *raw_data, std::string filename,
-                                 uint64_t uncompressed_trace_size)
-{
-    // Create the checkpoint file for the memory
-    std::string thefile = CheckpointIn::dir() + "/" + filename.c_str();
-
-    int fd = creat(thefile.c_str(), 0664);
-    if (fd < 0) {
-        perror("creat");
-        fatal("Can't open memory trace file '%s'\n", filename);
-    }
-
-    gzFile compressedMemory = gzdopen(fd, "wb");
-    if (compressedMemory == NULL)
-        fatal("Insufficient memory to allocate compression state for %s\n",
-              filename);
-
-    if (gzwrite(compressedMemory, raw_data, uncompressed_trace_size) !=
-        uncompressed_trace_size) {
-        fatal("Write failed on memory trace file '%s'\n", filename);
-    }
-
-    if (gzclose(compressedMemory)) {
-        fatal("Close failed on memory trace file '%s'\n", filename);
-    }
-    delete[] raw_data;
-}
-
 void
 RubySystem::serialize(CheckpointOut &cp) const
 {
@@ -342,15 +307,16 @@ RubySystem::serialize(CheckpointOut &cp) const
                 "ruby trace");
     }
 
-    // Aggregate the trace entries together into a single array
-    uint8_t *raw_data = new uint8_t[4096];
-    uint64_t cache_trace_size = m_cache_recorder->aggregateRecords(
-                                                        &raw_data, 4096);
+    // Stream the trace entries to the checkpoint
     std::string cache_trace_file = name() + ".cache.gz";
-    writeCompressedTrace(raw_data, cache_trace_file, cache_trace_size);
+    int cache_trace_version = CacheRecorder::traceVersion;
+    uint64_t cache_trace_records = m_cache_recorder->writeTrace(
+        CheckpointIn::dir() + "/" + cache_trace_file);
+    DPRINTF(RubyCacheTrace, "Wrote %d records to %s\n",
+            cache_trace_records, cache_trace_file);
 
     SERIALIZE_SCALAR(cache_trace_file);
-    SERIALIZE_SCALAR(cache_trace_size);
+    SERIALIZE_SCALAR(cache_trace_version);
 }
 
 void
@@ -364,42 +330,9 @@ RubySystem::drainResume()
     }
 }
 
-void
-RubySystem::readCompressedTrace(std::string filename, uint8_t *&raw_data,
-                                uint64_t &uncompressed_trace_size)
-{
-    // Read the trace file
-    gzFile compressedTrace;
-
-    // trace file
-    int fd = open(filename.c_str(), O_RDONLY);
-    if (fd < 0) {
-        perror("open");
-        fatal("Unable to open trace file %s", filename);
-    }
-
-    compressedTrace = gzdopen(fd, "rb");
-    if (compressedTrace == NULL) {
-        fatal("Insufficient memory to allocate compression state for %s\n",
-              filename);
-    }
-
-    raw_data = new uint8_t[uncompressed_trace_size];
-    if (gzread(compressedTrace, raw_data, uncompressed_trace_size) <
-            uncompressed_trace_size) {
-        fatal("Unable to read complete trace from file %s\n", filename);
-    }
-
-    if (gzclose(compressedTrace)) {
-        fatal("Failed to close cache trace file '%s'\n", filename);
-    }
-}
-
 void
 RubySystem::unserialize(CheckpointIn &cp)
 {
-    uint8_t *uncompressed_trace = NULL;
-
     // This value should be set to the checkpoint-system's block-size.
     // Optional, as checkpoints without it can be run if the
     // checkpoint-system's block-size == current block-size.
@@ -407,19 +340,25 @@ RubySystem::unserialize(CheckpointIn &cp)
     UNSERIALIZE_OPT_SCALAR(block_size_bytes);
 
     std::string cache_trace_file;
-    uint64_t cache_trace_size = 0;
-
     UNSERIALIZE_SCALAR(cache_trace_file);
-    UNSERIALIZE_SCALAR(cache_trace_size);
     cache_trace_file = cp.getCptDir() + "/" + cache_trace_file;
 
-    readCompressedTrace(cache_trace_file, uncompressed_trace,
-                        cache_trace_size);
+    // Checkpoints without a trace version hold the legacy raw trace,
+    // whose uncompressed size is needed to read it.
+    int cache_trace_version = 0;
+    uint64_t cache_trace_size = 0;
+    UNSERIALIZE_OPT_SCALAR(cache_trace_version);
+    if (cache_trace_version == 0)
+        UNSERIALIZE_SCALAR(cache_trace_size);
+
     m_warmup_enabled = true;
     m_systems_to_warmup++;
 
-    // Create the cache recorder that will hang around until startup.
-    makeCacheRecorder(uncompressed_trace, cache_trace_size, block_size_bytes);
+    // Create the cache recorder that will hang around until startup. The
+    // trace is decoded as the warmup requests are issued.
+    makeCacheRecorder(block_size_bytes);
+    m_cache_recorder->openTrace(cache_trace_file, cache_trace_version,
+                                cache_trace_size);
 }
 
 void
@@ -488,7 +427,7 @@ void
 RubySystem::processRubyEvent()
 {
     if (getWarmupEnabled()) {
-        m_cache_recorder->enqueueNextFetchRequest();
+        m_cache_recorder->startWarmup();
     } else if (getCooldownEnabled()) {
         m_cache_recorder->enqueueNextFlushRequest();
     }
@@ -56,6 +56,12 @@ class RubySystem(ClockedObject):
         "Use phys_mem as the functional \
         store and only use ruby for timing.",
     )
+    parallel_cache_warmup = Param.Bool(
+        False,
+        "When restoring from a checkpoint, let every sequencer replay its "
+        "own part of the cache trace in parallel instead of replaying the "
+        "whole trace one request at a time",
+    )
 
     # Profiler related configuration variables
     hot_lines = Param.Bool(False, "")
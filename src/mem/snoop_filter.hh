@@ -95,6 +95,14 @@ class SnoopFilter : public SimObject
 
     typedef std::vector<QueuedResponsePort*> SnoopList;
 
+    /**
+     * The underlying type for the bitmask we use for tracking. This
+     * limits the number of snooping ports supported per crossbar. Bit i
+     * of a mask corresponds to the i-th snooping port in the list given
+     * to setCPUSidePorts.
+     */
+    typedef std::bitset<SNOOP_MASK_SIZE> SnoopMask;
+
     SnoopFilter (const SnoopFilterParams &p) :
         SimObject(p), reqLookupResult(cachedLocations.end()),
         linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
@@ -137,9 +145,9 @@ class SnoopFilter : public SimObject
      *
      * @param cpkt              Pointer to the request packet. Not changed.
      * @param cpu_side_port     Response port where the request came from.
-     * @return Pair of a vector of snoop target ports and lookup latency.
+     * @return Pair of a mask of snoop target ports and lookup latency.
      */
-    std::pair<SnoopList, Cycles> lookupRequest(const Packet* cpkt,
+    std::pair<SnoopMask, Cycles> lookupRequest(const Packet* cpkt,
                                         const ResponsePort& cpu_side_port);
 
     /**
@@ -159,10 +167,10 @@ class SnoopFilter : public SimObject
      * additional steering thanks to the snoop filter.
      *
      * @param cpkt Pointer to const Packet containing the snoop.
-     * @return Pair with a vector of ResponsePorts that need snooping and a
+     * @return Pair with a mask of ResponsePorts that need snooping and a
      * lookup latency.
      */
-    std::pair<SnoopList, Cycles> lookupSnoop(const Packet* cpkt);
+    std::pair<SnoopMask, Cycles> lookupSnoop(const Packet* cpkt);
 
     /**
      * Let the snoop filter see any snoop responses that turn into
@@ -204,12 +212,6 @@ class SnoopFilter : public SimObject
 
   protected:
 
-    /**
-     * The underlying type for the bitmask we use for tracking. This
-     * limits the number of snooping ports supported per crossbar.
-     */
-    typedef std::bitset<SNOOP_MASK_SIZE> SnoopMask;
-
     /**
     * Per cache line item tracking a bitmask of ResponsePorts who have an
     * outstanding request to this line (requested) or already share a
@@ -228,19 +230,21 @@ class SnoopFilter : public SimObject
     /**
      * Simple factory methods for standard return values.
      */
-    std::pair<SnoopList, Cycles> snoopAll(Cycles latency) const
+    std::pair<SnoopMask, Cycles> snoopAll(Cycles latency) const
     {
-        return std::make_pair(cpuSidePorts, latency);
+        SnoopMask all;
+        for (size_t i = 0; i < cpuSidePorts.size(); ++i)
+            all.set(i);
+        return std::make_pair(all, latency);
     }
-    std::pair<SnoopList, Cycles> snoopSelected(const SnoopList&
+    std::pair<SnoopMask, Cycles> snoopSelected(const SnoopMask&
                                 _cpu_side_ports, Cycles latency) const
     {
         return std::make_pair(_cpu_side_ports, latency);
     }
-    std::pair<SnoopList, Cycles> snoopDown(Cycles latency) const
+    std::pair<SnoopMask, Cycles> snoopDown(Cycles latency) const
     {
-        SnoopList empty;
-        return std::make_pair(empty , latency);
+        return std::make_pair(SnoopMask(), latency);
     }
 
     /**
@@ -249,12 +253,6 @@ class SnoopFilter : public SimObject
      * @return One-hot bitmask corresponding to the port.
      */
     SnoopMask portToMask(const ResponsePort& port) const;
-    /**
-     * Converts a bitmask of ports into the corresponing list of ports
-     * @param ports SnoopMask of the requested ports
-     * @return SnoopList containing all the requested ResponsePorts
-     */
-    SnoopList maskToPortList(SnoopMask ports) const;
 
   private:
 
@@ -337,18 +335,10 @@ SnoopFilter::portToMask(const ResponsePort& port) const
 {
     assert(port.getId() != InvalidPortID);
     // if this is not a snooping port, return a zero mask
-    return !port.isSnooping() ? 0 :
-        ((SnoopMask)1) << localResponsePortIds[port.getId()];
-}
-
-inline SnoopFilter::SnoopList
-SnoopFilter::maskToPortList(SnoopMask port_mask) const
-{
-    SnoopList res;
-    for (const auto& p : cpuSidePorts)
-        if ((port_mask & portToMask(*p)).any())
-            res.push_back(p);
-    return res;
+    SnoopMask mask;
+    if (port.isSnooping())
+        mask.set(localResponsePortIds[port.getId()]);
+    return mask;
 }
 
 } // namespace gem5
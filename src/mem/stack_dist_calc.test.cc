@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "mem/stack_dist_calc.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Reference stack distance, as the position of an address in a stack */
+uint64_t
+naiveStackDist(std::vector<Addr> &stack, Addr addr, bool update, bool push)
+{
+    auto it = std::find(stack.rbegin(), stack.rend(), addr);
+    uint64_t stack_dist = StackDistCalc::Infinity;
+    if (it != stack.rend()) {
+        stack_dist = it - stack.rbegin();
+        if (update)
+            stack.erase(std::next(it).base());
+    }
+    if (update && push)
+        stack.push_back(addr);
+    return stack_dist;
+}
+
+} // anonymous namespace
+
+TEST(StackDistCalcTest, FirstAccessIsInfinite)
+{
+    StackDistCalc calc;
+    EXPECT_EQ(StackDistCalc::Infinity, calc.calcStackDist(0x40).first);
+    EXPECT_EQ(StackDistCalc::Infinity,
+              calc.calcStackDistAndUpdate(0x40).first);
+    EXPECT_EQ(0, calc.calcStackDistAndUpdate(0x40).first);
+    EXPECT_EQ(1, calc.size());
+}
+
+TEST(StackDistCalcTest, CountsUniqueAddressesInBetween)
+{
+    StackDistCalc calc;
+    calc.calcStackDistAndUpdate(0x0);
+    calc.calcStackDistAndUpdate(0x40);
+    calc.calcStackDistAndUpdate(0x80);
+    calc.calcStackDistAndUpdate(0x40);
+
+    EXPECT_EQ(2, calc.calcStackDist(0x0).first);
+    EXPECT_EQ(0, calc.calcStackDist(0x40).first);
+    EXPECT_EQ(1, calc.calcStackDist(0x80).first);
+    EXPECT_EQ(2, calc.calcStackDistAndUpdate(0x0).first);
+    EXPECT_EQ(3, calc.size());
+}
+
+TEST(StackDistCalcTest, RemoveEntry)
+{
+    StackDistCalc calc;
+    calc.calcStackDistAndUpdate(0x0);
+    calc.calcStackDistAndUpdate(0x40);
+
+    EXPECT_EQ(1, calc.calcStackDistAndUpdate(0x0, false).first);
+    EXPECT_EQ(StackDistCalc::Infinity, calc.calcStackDist(0x0).first);
+    EXPECT_EQ(0, calc.calcStackDist(0x40).first);
+    EXPECT_EQ(1, calc.size());
+}
+
+TEST(StackDistCalcTest, MarkEntries)
+{
+    StackDistCalc calc;
+    calc.calcStackDistAndUpdate(0x0);
+
+    EXPECT_FALSE(calc.calcStackDist(0x0, true).second);
+    EXPECT_TRUE(calc.calcStackDist(0x0, true).second);
+    EXPECT_TRUE(calc.calcStackDistAndUpdate(0x0).second);
+    // The new entry of the address is not marked
+    EXPECT_FALSE(calc.calcStackDist(0x0).second);
+}
+
+/**
+ * Check a long random stream against a naive stack, so that the
+ * sequence of positions has to be compacted and grown many times.
+ */
+TEST(StackDistCalcTest, MatchesNaiveStack)
+{
+    StackDistCalc calc;
+    std::vector<Addr> stack;
+    std::mt19937_64 rng(0x5eed);
+
+    for (int i = 0; i < 200000; ++i) {
+        // Change the number of addresses in use along the stream, so
+        // the stack both grows and shrinks
+        const Addr num_addrs = i < 100000 ? 4096 : 256;
+        const Addr addr = (rng() % num_addrs) * 64;
+        const unsigned op = rng() % 16;
+
+        if (op == 0) {
+            ASSERT_EQ(naiveStackDist(stack, addr, false, false),
+                      calc.calcStackDist(addr).first) << "access " << i;
+        } else if (op == 1) {
+            ASSERT_EQ(naiveStackDist(stack, addr, true, false),
+                      calc.calcStackDistAndUpdate(addr, false).first)
+                << "access " << i;
+        } else {
+            ASSERT_EQ(naiveStackDist(stack, addr, true, true),
+                      calc.calcStackDistAndUpdate(addr).first)
+                << "access " << i;
+        }
+        ASSERT_EQ(stack.size(), calc.size());
+    }
+}
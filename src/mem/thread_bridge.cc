@@ -27,6 +27,7 @@
 
 #include "mem/thread_bridge.hh"
 
+#include "base/logging.hh"
 #include "base/trace.hh"
 #include "sim/eventq.hh"
 
@@ -34,10 +35,87 @@ namespace gem5
 {
 
 ThreadBridge::ThreadBridge(const ThreadBridgeParams &p)
-    : SimObject(p), in_port_("in_port", *this), out_port_("out_port", *this)
+    : SimObject(p), in_port_("in_port", *this), out_port_("out_port", *this),
+      delay_(p.delay)
 {
 }
 
+void
+ThreadBridge::init()
+{
+    SimObject::init();
+
+    if (delay_ == 0 && numMainEventQueues > 1)
+        delay_ = simQuantum;
+
+    fatal_if(numMainEventQueues > 1 && delay_ < simQuantum,
+             "%s: delay (%d) must be at least the simulation quantum (%d) "
+             "for timing accesses across event queues.\n",
+             name(), delay_, simQuantum);
+}
+
+DrainState
+ThreadBridge::drain()
+{
+    return inFlight_ == 0 ? DrainState::Drained : DrainState::Draining;
+}
+
+void
+ThreadBridge::scheduleOn(EventQueue *eq, std::function<void()> callback)
+{
+    // The event is owned by the receiving queue once scheduled, and is
+    // inserted asynchronously if that queue belongs to another thread
+    auto *event = new EventFunctionWrapper(std::move(callback),
+                                           name() + ".crossEvent", true);
+    eq->schedule(event, curTick() + delay_);
+}
+
+void
+ThreadBridge::cross(EventQueue *eq, PacketPtr pkt,
+                    std::function<void(PacketPtr)> deliver)
+{
+    std::list<PacketPtr>::iterator it;
+    {
+        std::lock_guard<std::mutex> lock(crossingMutex_);
+        it = crossing_.insert(crossing_.end(), pkt);
+    }
+    scheduleOn(eq, [this, it, pkt, deliver = std::move(deliver)]{
+        {
+            std::lock_guard<std::mutex> lock(crossingMutex_);
+            crossing_.erase(it);
+        }
+        deliver(pkt);
+    });
+}
+
+bool
+ThreadBridge::trySatisfyCrossing(PacketPtr pkt)
+{
+    std::lock_guard<std::mutex> lock(crossingMutex_);
+    for (auto *crossing : crossing_) {
+        if (pkt->trySatisfyFunctional(crossing))
+            return true;
+    }
+    return false;
+}
+
+void
+ThreadBridge::packetDone()
+{
+    if (inFlight_.fetch_sub(1) != 1)
+        return;
+
+    // The drain state only changes while the event queues are stopped,
+    // so it can be read from either of them
+    if (drainState() != DrainState::Draining)
+        return;
+
+    if (curEventQueue() == eventQueue())
+        signalDrainDone();
+    else
+        scheduleOn(eventQueue(), [this]{ signalDrainDone(); });
+}
+
 ThreadBridge::IncomingPort::IncomingPort(const std::string &name,
                                          ThreadBridge &device)
     : ResponsePort(name), device_(device)
@@ -54,12 +132,48 @@ ThreadBridge::IncomingPort::getAddrRanges() const
 bool
 ThreadBridge::IncomingPort::recvTimingReq(PacketPtr pkt)
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    panic_if(pkt->isExpressSnoop(),
+             "ThreadBridge does not support express snoops.");
+
+    if (!device_.inEventQueue_)
+        device_.inEventQueue_ = curEventQueue();
+    panic_if(device_.inEventQueue_ != curEventQueue(),
+             "ThreadBridge requests must all come from the same thread.");
+
+    // Requests are always accepted, and buffered on the far side until
+    // the responder takes them
+    ++device_.inFlight_;
+    device_.cross(device_.eventQueue(), pkt,
+                  [this](PacketPtr pkt){ device_.out_port_.queueReq(pkt); });
+    return true;
 }
+
 void
 ThreadBridge::IncomingPort::recvRespRetry()
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    assert(waitingForRetry_);
+    waitingForRetry_ = false;
+    trySendResp();
+}
+
+void
+ThreadBridge::IncomingPort::queueResp(PacketPtr pkt)
+{
+    respQueue_.push_back(pkt);
+    trySendResp();
+}
+
+void
+ThreadBridge::IncomingPort::trySendResp()
+{
+    while (!waitingForRetry_ && !respQueue_.empty()) {
+        if (!sendTimingResp(respQueue_.front())) {
+            waitingForRetry_ = true;
+            break;
+        }
+        respQueue_.pop_front();
+        device_.packetDone();
+    }
 }
 
 // AtomicResponseProtocol
@@ -74,7 +188,30 @@ ThreadBridge::IncomingPort::recvAtomic(PacketPtr pkt)
 void
 ThreadBridge::IncomingPort::recvFunctional(PacketPtr pkt)
 {
+    pkt->pushLabel(name());
+
+    // check the responses waiting on this side, and the packets that
+    // are crossing in either direction
+    for (auto *resp : respQueue_) {
+        if (pkt->trySatisfyFunctional(resp)) {
+            pkt->makeResponse();
+            return;
+        }
+    }
+    if (device_.trySatisfyCrossing(pkt)) {
+        pkt->makeResponse();
+        return;
+    }
+
     EventQueue::ScopedMigration migrate(device_.eventQueue());
+
+    // also check the requests waiting on the far side
+    if (device_.out_port_.trySatisfyFunctional(pkt))
+        return;
+
+    pkt->popLabel();
+
+    // fall through if pkt still not satisfied
     device_.out_port_.sendFunctional(pkt);
 }
 
@@ -94,12 +231,50 @@ ThreadBridge::OutgoingPort::recvRangeChange()
 bool
 ThreadBridge::OutgoingPort::recvTimingResp(PacketPtr pkt)
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    ++device_.inFlight_;
+    device_.cross(device_.inEventQueue_, pkt,
+                  [this](PacketPtr pkt){ device_.in_port_.queueResp(pkt); });
+    return true;
 }
+
 void
 ThreadBridge::OutgoingPort::recvReqRetry()
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    assert(waitingForRetry_);
+    waitingForRetry_ = false;
+    trySendReq();
+}
+
+void
+ThreadBridge::OutgoingPort::queueReq(PacketPtr pkt)
+{
+    reqQueue_.push_back(pkt);
+    trySendReq();
+}
+
+void
+ThreadBridge::OutgoingPort::trySendReq()
+{
+    while (!waitingForRetry_ && !reqQueue_.empty()) {
+        if (!sendTimingReq(reqQueue_.front())) {
+            waitingForRetry_ = true;
+            break;
+        }
+        reqQueue_.pop_front();
+        device_.packetDone();
+    }
+}
+
+bool
+ThreadBridge::OutgoingPort::trySatisfyFunctional(PacketPtr pkt)
+{
+    for (auto *req : reqQueue_) {
+        if (pkt->trySatisfyFunctional(req)) {
+            pkt->makeResponse();
+            return true;
+        }
+    }
+    return false;
 }
 
 Port &
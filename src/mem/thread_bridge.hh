@@ -28,6 +28,12 @@
 #ifndef __MEM_THREAD_BRIDGE_HH__
 #define __MEM_THREAD_BRIDGE_HH__
 
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <list>
+#include <mutex>
+
 #include "mem/port.hh"
 #include "params/ThreadBridge.hh"
 #include "sim/sim_object.hh"
@@ -43,6 +49,10 @@ class ThreadBridge : public SimObject
     Port &getPort(const std::string &if_name,
                   PortID idx = InvalidPortID) override;
 
+    void init() override;
+
+    DrainState drain() override;
+
   private:
     class IncomingPort : public ResponsePort
     {
@@ -62,6 +72,17 @@ class ThreadBridge : public SimObject
 
       private:
         ThreadBridge &device_;
+
+        /** Responses delivered on this side, waiting to be sent. */
+        std::deque<PacketPtr> respQueue_;
+
+        /** Are we waiting for a retry from the requestor? */
+        bool waitingForRetry_ = false;
+
+      public:
+        /** Queue a response and send as many as the requestor takes. */
+        void queueResp(PacketPtr pkt);
+        void trySendResp();
     };
 
     class OutgoingPort : public RequestPort
@@ -76,10 +97,69 @@ class ThreadBridge : public SimObject
 
       private:
         ThreadBridge &device_;
+
+        /** Requests delivered on this side, waiting to be sent. */
+        std::deque<PacketPtr> reqQueue_;
+
+        /** Are we waiting for a retry from the responder? */
+        bool waitingForRetry_ = false;
+
+      public:
+        /** Queue a request and send as many as the responder takes. */
+        void queueReq(PacketPtr pkt);
+        void trySendReq();
+
+        /** Try to satisfy a functional access with the queued requests. */
+        bool trySatisfyFunctional(PacketPtr pkt);
     };
 
     IncomingPort in_port_;
     OutgoingPort out_port_;
+
+    /**
+     * Latency of a timing crossing. When the two sides run on different
+     * event queues in parallel, it must be at least one simulation
+     * quantum so that the crossing is never scheduled in the past of
+     * the receiving queue. A delay of 0 is replaced by that minimum.
+     */
+    Tick delay_;
+
+    /**
+     * Event queue of the requestor side, i.e. the queue responses are
+     * handed back on. It is captured from the first timing request.
+     */
+    EventQueue *inEventQueue_ = nullptr;
+
+    /**
+     * Timing packets that have entered but not yet left the bridge, in
+     * either direction. Updated from both event queues.
+     */
+    std::atomic<unsigned> inFlight_{0};
+
+    /**
+     * Packets currently crossing between the event queues, i.e. whose
+     * delivery event has not run yet, so that functional accesses can
+     * see them. Accessed from both event queues under crossingMutex_.
+     */
+    std::list<PacketPtr> crossing_;
+    std::mutex crossingMutex_;
+
+    /** Run a callback on the given event queue after the bridge delay. */
+    void scheduleOn(EventQueue *eq, std::function<void()> callback);
+
+    /** Move a packet to the given event queue after the bridge delay. */
+    void cross(EventQueue *eq, PacketPtr pkt,
+               std::function<void(PacketPtr)> deliver);
+
+    /** Try to satisfy a functional access with the crossing packets. */
+    bool trySatisfyCrossing(PacketPtr pkt);
+
+    /**
+     * Account for a packet leaving the bridge. This may be called from
+     * either event queue, but the drain is only ever signalled from the
+     * event queue of the bridge.
+     */
+    void packetDone();
 };
 
 }  // namespace gem5
@@ -68,7 +68,7 @@ class TokenRequestPort : public RequestPort
      * Receive tokens returned by the response port. This increments the number
      * or available tokens across the port.
      */
-    void recvTokens(int num_tokens);
+    virtual void recvTokens(int num_tokens);
 
     /**
      * Query if there are at least num_tokens tokens available to acquire.
@@ -49,6 +49,7 @@
 #include <deque>
 #include <unordered_map>
 
+#include "base/addr_decoder.hh"
 #include "base/addr_range_map.hh"
 #include "base/types.hh"
 #include "mem/qport.hh"
@@ -318,6 +319,13 @@ class BaseXBar : public ClockedObject
 
     AddrRangeMap<PortID, 3> portMap;
 
+    /**
+     * Flattened copy of portMap used to decode packet addresses. It is
+     * rebuilt whenever the ranges change, once we have the ranges of all
+     * connected ports.
+     */
+    AddrDecoder<PortID> portDecoder;
+
     /**
      * Remember where request packets came from so that we can route
      * responses to the appropriate port. This relies on the fact that
@@ -37,28 +37,366 @@
 
 #include "proto/protoio.hh"
 
+#include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <string>
 
 #include "base/logging.hh"
+#include "config/have_zstd.hh"
+
+#if HAVE_ZSTD
+#include <zstd.h>
+
+#endif
 
 using namespace google::protobuf;
 
+namespace
+{
+
+/// First bytes of a gzip stream
+const unsigned char gzipMagic[] = { 0x1f, 0x8b };
+
+/// First bytes of a zstd frame
+const unsigned char zstdMagic[] = { 0x28, 0xb5, 0x2f, 0xfd };
+
+bool
+hasExtension(const std::string& filename, const std::string& extension)
+{
+    return filename.find_last_of('.') != std::string::npos &&
+        filename.substr(filename.find_last_of('.') + 1) == extension;
+}
+
+#if HAVE_ZSTD
+
+/**
+ * Zero-copy stream decompressing a zstd stream read from another
+ * zero-copy stream.
+ */
+class ZstdInputStream : public io::ZeroCopyInputStream
+{
+  public:
+    ZstdInputStream(io::ZeroCopyInputStream* source)
+        : source(source), dstream(ZSTD_createDStream()),
+          buffer(ZSTD_DStreamOutSize()), input{nullptr, 0, 0},
+          available(0), backedUp(0), outputPending(false), byteCount(0)
+    {
+        panic_if(!dstream, "Could not create a zstd decompression stream\n");
+    }
+
+    ~ZstdInputStream()
+    {
+        ZSTD_freeDStream(dstream);
+    }
+
+    bool
+    Next(const void** data, int* size) override
+    {
+        if (backedUp) {
+            *data = buffer.data() + available - backedUp;
+            *size = backedUp;
+            backedUp = 0;
+        } else if (decompress()) {
+            *data = buffer.data();
+            *size = available;
+        } else {
+            return false;
+        }
+
+        byteCount += *size;
+        return true;
+    }
+
+    void
+    BackUp(int count) override
+    {
+        backedUp = count;
+        byteCount -= count;
+    }
+
+    bool
+    Skip(int count) override
+    {
+        const void* data;
+        int size;
+        while (count > 0 && Next(&data, &size)) {
+            if (size > count) {
+                BackUp(size - count);
+                return true;
+            }
+            count -= size;
+        }
+        return count == 0;
+    }
+
+    int64_t ByteCount() const override { return byteCount; }
+
+  private:
+    /**
+     * Decompress data into the buffer, reading more input from the
+     * wrapped stream as needed.
+     *
+     * @return False if there is no more data to decompress
+     */
+    bool
+    decompress()
+    {
+        ZSTD_outBuffer output = { buffer.data(), buffer.size(), 0 };
+        while (output.pos == 0) {
+            // Only read more input once everything decompressed from
+            // the previous one has been flushed
+            if (input.pos == input.size && !outputPending) {
+                const void* data;
+                int size;
+                if (!source->Next(&data, &size))
+                    return false;
+                input = { data, (size_t)size, 0 };
+            }
+
+            size_t ret = ZSTD_decompressStream(dstream, &output, &input);
+            panic_if(ZSTD_isError(ret), "Failed to decompress zstd stream: "
+                     "%s\n", ZSTD_getErrorName(ret));
+            outputPending = output.pos == output.size;
+        }
+        available = output.pos;
+        return true;
+    }
+
+    io::ZeroCopyInputStream* source;
+    ZSTD_DStream* dstream;
+    std::vector<char> buffer;
+    ZSTD_inBuffer input;
+    int available;
+    int backedUp;
+    bool outputPending;
+    int64_t byteCount;
+};
+
+/**
+ * Zero-copy stream compressing the data written to it with zstd into
+ * another zero-copy stream. The zstd frame is finished when the
+ * stream is destroyed.
+ */
+class ZstdOutputStream : public io::ZeroCopyOutputStream
+{
+  public:
+    ZstdOutputStream(io::ZeroCopyOutputStream* sink)
+        : sink(sink), cstream(ZSTD_createCStream()),
+          buffer(ZSTD_CStreamInSize()), used(0), byteCount(0)
+    {
+        panic_if(!cstream, "Could not create a zstd compression stream\n");
+    }
+
+    ~ZstdOutputStream()
+    {
+        compress(ZSTD_e_end);
+        ZSTD_freeCStream(cstream);
+    }
+
+    bool
+    Next(void** data, int* size) override
+    {
+        if (used == buffer.size())
+            compress(ZSTD_e_continue);
+
+        *data = buffer.data() + used;
+        *size = buffer.size() - used;
+        used = buffer.size();
+        byteCount += *size;
+        return true;
+    }
+
+    void
+    BackUp(int count) override
+    {
+        used -= count;
+        byteCount -= count;
+    }
+
+    int64_t ByteCount() const override { return byteCount; }
+
+  private:
+    /**
+     * Compress the buffered data into the wrapped stream.
+     *
+     * @param mode Whether to end the frame or just consume the input
+     */
+    void
+    compress(ZSTD_EndDirective mode)
+    {
+        ZSTD_inBuffer input = { buffer.data(), used, 0 };
+        bool done = false;
+        while (!done) {
+            void* data;
+            int size;
+            panic_if(!sink->Next(&data, &size),
+                     "Failed to write zstd compressed stream\n");
+
+            ZSTD_outBuffer output = { data, (size_t)size, 0 };
+            size_t ret = ZSTD_compressStream2(cstream, &output, &input, mode);
+            panic_if(ZSTD_isError(ret), "Failed to compress zstd stream: "
+                     "%s\n", ZSTD_getErrorName(ret));
+            sink->BackUp(size - output.pos);
+
+            done = mode == ZSTD_e_end ? ret == 0 : input.pos == input.size;
+        }
+        used = 0;
+    }
+
+    io::ZeroCopyOutputStream* sink;
+    ZSTD_CStream* cstream;
+    std::vector<char> buffer;
+    size_t used;
+    int64_t byteCount;
+};
+
+#endif // HAVE_ZSTD
+
+} // anonymous namespace
+
+PrefetchInputStream::PrefetchInputStream(io::ZeroCopyInputStream* source) :
+    source(source), sourceDone(false), stopping(false), chunkPos(0),
+    byteCount(0), thread(&PrefetchInputStream::prefetch, this)
+{
+}
+
+PrefetchInputStream::~PrefetchInputStream()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cond.notify_all();
+    thread.join();
+}
+
+void
+PrefetchInputStream::prefetch()
+{
+    bool more = true;
+    while (more) {
+        std::vector<char> next;
+        {
+            // Wait until there is room for another chunk
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this]() {
+                return stopping || readyChunks.size() < maxReadyChunks;
+            });
+            if (stopping)
+                return;
+            if (!freeChunks.empty()) {
+                next = std::move(freeChunks.back());
+                freeChunks.pop_back();
+            }
+        }
+
+        // Fill the chunk without holding the lock, this is where the
+        // time goes when the source is compressed
+        next.clear();
+        next.reserve(chunkSize);
+        const void* data;
+        int size;
+        while (next.size() < chunkSize &&
+               (more = source->Next(&data, &size))) {
+            size_t count = std::min<size_t>(size, chunkSize - next.size());
+            const char* bytes = static_cast<const char*>(data);
+            next.insert(next.end(), bytes, bytes + count);
+            if (count < size)
+                source->BackUp(size - count);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!next.empty())
+                readyChunks.push_back(std::move(next));
+            sourceDone = !more;
+        }
+        cond.notify_all();
+    }
+}
+
+bool
+PrefetchInputStream::nextChunk()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // Hand the consumed chunk back to be filled again
+    if (chunk.capacity())
+        freeChunks.push_back(std::move(chunk));
+    chunk.clear();
+    chunkPos = 0;
+
+    cond.wait(lock, [this]() { return !readyChunks.empty() || sourceDone; });
+    if (readyChunks.empty())
+        return false;
+
+    chunk = std::move(readyChunks.front());
+    readyChunks.pop_front();
+    lock.unlock();
+    cond.notify_all();
+    return true;
+}
+
+bool
+PrefetchInputStream::Next(const void** data, int* size)
+{
+    if (chunkPos == chunk.size() && !nextChunk())
+        return false;
+
+    *data = chunk.data() + chunkPos;
+    *size = chunk.size() - chunkPos;
+    chunkPos = chunk.size();
+    byteCount += *size;
+    return true;
+}
+
+void
+PrefetchInputStream::BackUp(int count)
+{
+    assert(count <= chunkPos);
+    chunkPos -= count;
+    byteCount -= count;
+}
+
+bool
+PrefetchInputStream::Skip(int count)
+{
+    while (count > 0) {
+        if (chunkPos == chunk.size() && !nextChunk())
+            return false;
+
+        size_t skipped = std::min<size_t>(count, chunk.size() - chunkPos);
+        chunkPos += skipped;
+        byteCount += skipped;
+        count -= skipped;
+    }
+    return true;
+}
+
 ProtoOutputStream::ProtoOutputStream(const std::string& filename) :
     fileStream(filename.c_str(),
             std::ios::out | std::ios::binary | std::ios::trunc),
-    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL)
+    wrappedFileStream(NULL), compressStream(NULL), zeroCopyStream(NULL)
 {
     if (!fileStream.good())
         panic("Could not open %s for writing\n", filename);
 
     // Wrap the output file in a zero copy stream, that in turn is
-    // wrapped in a gzip stream if the filename ends with .gz. The
-    // latter stream is in turn wrapped in a coded stream
+    // wrapped in a gzip or zstd stream if the filename ends with .gz
+    // or .zst. The latter stream is in turn wrapped in a coded stream
     wrappedFileStream = new io::OstreamOutputStream(&fileStream);
-    if (filename.find_last_of('.') != std::string::npos &&
-        filename.substr(filename.find_last_of('.') + 1) == "gz") {
-        gzipStream = new io::GzipOutputStream(wrappedFileStream);
-        zeroCopyStream = gzipStream;
+    if (hasExtension(filename, "gz")) {
+        compressStream = new io::GzipOutputStream(wrappedFileStream);
+        zeroCopyStream = compressStream;
+    } else if (hasExtension(filename, "zst")) {
+#if HAVE_ZSTD
+        compressStream = new ZstdOutputStream(wrappedFileStream);
+        zeroCopyStream = compressStream;
+#else
+        fatal("Can't write %s, gem5 was built without zstd support\n",
+              filename);
+#endif
     } else {
         zeroCopyStream = wrappedFileStream;
     }
@@ -74,8 +412,8 @@ ProtoOutputStream::ProtoOutputStream(const std::string& filename) :
 ProtoOutputStream::~ProtoOutputStream()
 {
     // As the compression is optional, see if the stream exists
-    if (gzipStream != NULL)
-        delete gzipStream;
+    if (compressStream != NULL)
+        delete compressStream;
     delete wrappedFileStream;
     fileStream.close();
 }
@@ -102,16 +440,23 @@ ProtoOutputStream::write(const Message& msg)
 
 ProtoInputStream::ProtoInputStream(const std::string& filename) :
     fileStream(filename.c_str(), std::ios::in | std::ios::binary),
-    fileName(filename), useGzip(false),
-    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL)
+    fileName(filename), useGzip(false), useZstd(false),
+    wrappedFileStream(NULL), decompressStream(NULL), zeroCopyStream(NULL)
 {
     if (!fileStream.good())
         panic("Could not open %s for reading\n", filename);
 
-    // check the magic number to see if this is a gzip stream
-    unsigned char bytes[2];
-    fileStream.read((char*) bytes, 2);
-    useGzip = fileStream.good() && bytes[0] == 0x1f && bytes[1] == 0x8b;
+    // check the magic number to see if this is a gzip or zstd stream
+    unsigned char bytes[4];
+    fileStream.read((char*) bytes, 4);
+    useGzip = fileStream.gcount() >= 2 &&
+        !memcmp(bytes, gzipMagic, sizeof(gzipMagic));
+    useZstd = fileStream.gcount() >= 4 &&
+        !memcmp(bytes, zstdMagic, sizeof(zstdMagic));
+#if !HAVE_ZSTD
+    fatal_if(useZstd, "Can't read %s, gem5 was built without zstd "
+             "support\n", filename);
+#endif
 
     // seek to the start of the input file and clear any flags
     fileStream.clear();
@@ -124,19 +469,23 @@ void
 ProtoInputStream::createStreams()
 {
     // All streams should be NULL at this point
-    assert(wrappedFileStream == NULL && gzipStream == NULL &&
+    assert(wrappedFileStream == NULL && decompressStream == NULL &&
            zeroCopyStream == NULL);
 
     // Wrap the input file in a zero copy stream, that in turn is
-    // wrapped in a gzip stream if the filename ends with .gz. The
-    // latter stream is in turn wrapped in a coded stream
+    // wrapped in a gzip or zstd stream if the file is compressed. The
+    // latter stream is read ahead in the background by a prefetch
+    // stream, which is in turn wrapped in a coded stream
     wrappedFileStream = new io::IstreamInputStream(&fileStream);
     if (useGzip) {
-        gzipStream = new io::GzipInputStream(wrappedFileStream);
-        zeroCopyStream = gzipStream;
-    } else {
-        zeroCopyStream = wrappedFileStream;
+        decompressStream = new io::GzipInputStream(wrappedFileStream);
+    } else if (useZstd) {
+#if HAVE_ZSTD
+        decompressStream = new ZstdInputStream(wrappedFileStream);
+#endif
     }
+    zeroCopyStream = new PrefetchInputStream(
+        decompressStream ? decompressStream : wrappedFileStream);
 
     uint32_t magic_check;
     io::CodedInputStream codedStream(zeroCopyStream);
@@ -149,15 +498,17 @@ ProtoInputStream::createStreams()
 void
 ProtoInputStream::destroyStreams()
 {
+    // Stop reading ahead before destroying the streams below
+    delete zeroCopyStream;
+    zeroCopyStream = NULL;
+
     // As the compression is optional, see if the stream exists
-    if (gzipStream != NULL) {
-        delete gzipStream;
-        gzipStream = NULL;
+    if (decompressStream != NULL) {
+        delete decompressStream;
+        decompressStream = NULL;
     }
     delete wrappedFileStream;
     wrappedFileStream = NULL;
-
-    zeroCopyStream = NULL;
 }
 
 
@@ -204,3 +555,23 @@ ProtoInputStream::read(Message& msg)
 
     return false;
 }
+
+uint64_t
+ProtoInputStream::skip(uint64_t num_msgs)
+{
+    uint64_t skipped = 0;
+    uint32_t size;
+
+    // As when reading, create a coded stream for every message to
+    // stay clear of its byte limit
+    while (skipped < num_msgs) {
+        io::CodedInputStream codedStream(zeroCopyStream);
+        if (!codedStream.ReadVarint32(&size))
+            break;
+        panic_if(!codedStream.Skip(size),
+                 "Unable to skip message in coded stream %s\n", fileName);
+        ++skipped;
+    }
+
+    return skipped;
+}
@@ -49,7 +49,13 @@
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/message.h>
 
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 /**
  * A ProtoStream provides the shared functionality of the input and
@@ -79,6 +85,94 @@ class ProtoStream
     /** @} */
 };
 
+/**
+ * A PrefetchInputStream reads ahead from another zero-copy stream in
+ * a background thread, so that reading and decompressing a trace
+ * overlaps with the simulation consuming it. The data is handed over
+ * in large chunks, with a bounded number of them ready at any time,
+ * and the chunks are recycled once they are consumed.
+ *
+ * The wrapped stream must not be used by anyone else while the
+ * prefetch stream exists.
+ */
+class PrefetchInputStream : public google::protobuf::io::ZeroCopyInputStream
+{
+
+  public:
+
+    /**
+     * Create a prefetch stream and start reading from the wrapped
+     * stream in the background.
+     *
+     * @param source Stream to read ahead from
+     */
+    PrefetchInputStream(google::protobuf::io::ZeroCopyInputStream* source);
+
+    /**
+     * Stop the background thread. The wrapped stream is not destroyed.
+     */
+    ~PrefetchInputStream();
+
+    bool Next(const void** data, int* size) override;
+    void BackUp(int count) override;
+    bool Skip(int count) override;
+    int64_t ByteCount() const override { return byteCount; }
+
+  private:
+
+    /**
+     * Move on to the next chunk read by the background thread,
+     * waiting for it if it is not ready yet.
+     *
+     * @return False if the wrapped stream has no more data
+     */
+    bool nextChunk();
+
+    /**
+     * Body of the background thread, reading chunks from the wrapped
+     * stream until it runs out of data or the prefetch stream is
+     * destroyed.
+     */
+    void prefetch();
+
+    /// Size of the chunks handed over by the background thread
+    static const size_t chunkSize = 1 << 20;
+
+    /// Number of chunks read ahead of the one being consumed
+    static const size_t maxReadyChunks = 2;
+
+    /// Stream wrapped by this one, only used by the background thread
+    google::protobuf::io::ZeroCopyInputStream* source;
+
+    /// Protects the chunk queues and the flags below
+    std::mutex mutex;
+
+    /// Signals changes in the chunk queues and the flags below
+    std::condition_variable cond;
+
+    /// Chunks read by the background thread, in order
+    std::deque<std::vector<char>> readyChunks;
+
+    /// Consumed chunks that can be filled again
+    std::vector<std::vector<char>> freeChunks;
+
+    /// Whether the wrapped stream has no more data
+    bool sourceDone;
+
+    /// Whether the background thread must stop
+    bool stopping;
+
+    /// Chunk being consumed and position in it
+    std::vector<char> chunk;
+    size_t chunkPos;
+
+    /// Number of bytes consumed so far
+    int64_t byteCount;
+
+    /// Background thread reading from the wrapped stream
+    std::thread thread;
+};
+
 /**
  * A ProtoOutputStream wraps a coded stream, potentially with
  * compression, based on looking at the file name. Writing to the
@@ -94,7 +188,9 @@ class ProtoOutputStream : public ProtoStream
 
     /**
      * Create an output stream for a given file name. If the filename
-     * ends with .gz then the file will be compressed accordinly.
+     * ends with .gz then the file will be compressed accordinly, and
+     * if it ends with .zst it will be compressed with zstd, which is
+     * much faster to decompress.
      *
      * @param filename Path to the file to create or truncate
      */
@@ -122,8 +218,8 @@ class ProtoOutputStream : public ProtoStream
     /// Zero Copy stream wrapping the STL output stream
     google::protobuf::io::OstreamOutputStream* wrappedFileStream;
 
-    /// Optional Gzip stream to wrap the Zero Copy stream
-    google::protobuf::io::GzipOutputStream* gzipStream;
+    /// Optional compression stream to wrap the Zero Copy stream
+    google::protobuf::io::ZeroCopyOutputStream* compressStream;
 
     /// Top-level zero-copy stream, either with compression or not
     google::protobuf::io::ZeroCopyOutputStream* zeroCopyStream;
@@ -143,8 +239,10 @@ class ProtoInputStream : public ProtoStream
   public:
 
     /**
-     * Create an input stream for a given file name. If the filename
-     * ends with .gz then the file will be decompressed accordingly.
+     * Create an input stream for a given file name. If the file is
+     * compressed with gzip or zstd then it will be decompressed
+     * accordingly. The file is read and decompressed ahead of time in
+     * a background thread.
      *
      * @param filename Path to the file to read from
      */
@@ -164,6 +262,16 @@ class ProtoInputStream : public ProtoStream
      */
     bool read(google::protobuf::Message& msg);
 
+    /**
+     * Skip messages without parsing them, e.g., to start replaying a
+     * trace at some point other than its beginning.
+     *
+     * @param num_msgs Number of messages to skip
+     * @return Number of messages skipped, which is less than num_msgs
+     *         if the end of the stream is reached
+     */
+    uint64_t skip(uint64_t num_msgs);
+
     /**
      * Reset the input stream and seek to the beginning of the file.
      */
@@ -190,14 +298,17 @@ class ProtoInputStream : public ProtoStream
     /// Boolean flag to remember whether we use gzip or not
     bool useGzip;
 
+    /// Boolean flag to remember whether we use zstd or not
+    bool useZstd;
+
     /// Zero Copy stream wrapping the STL input stream
     google::protobuf::io::IstreamInputStream* wrappedFileStream;
 
-    /// Optional Gzip stream to wrap the Zero Copy stream
-    google::protobuf::io::GzipInputStream* gzipStream;
+    /// Optional decompression stream to wrap the Zero Copy stream
+    google::protobuf::io::ZeroCopyInputStream* decompressStream;
 
-    /// Top-level zero-copy stream, either with compression or not
-    google::protobuf::io::ZeroCopyInputStream* zeroCopyStream;
+    /// Top-level zero-copy stream, reading ahead of the others
+    PrefetchInputStream* zeroCopyStream;
 
 };
 
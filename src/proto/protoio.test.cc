@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <google/protobuf/wrappers.pb.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "config/have_zstd.hh"
+#include "proto/protoio.hh"
+
+namespace
+{
+
+/** Enough messages for the trace to span several prefetch chunks */
+const uint64_t NumMsgs = 4000;
+
+/** Contents of message i, of varying size */
+std::string
+payload(uint64_t i)
+{
+    return std::string(i % 1021, 'a' + i % 26) + std::to_string(i);
+}
+
+/**
+ * Fixture writing a trace of NumMsgs messages to a temporary file,
+ * compressed as given by the file extension of the parameter.
+ */
+class ProtoIOTest : public testing::TestWithParam<std::string>
+{
+  protected:
+    std::string fileName;
+
+    void
+    SetUp() override
+    {
+        if (GetParam() == ".zst" && !HAVE_ZSTD)
+            GTEST_SKIP() << "gem5 was built without zstd support";
+
+        char name[] = "/tmp/protoio.test.XXXXXX";
+        int fd = mkstemp(name);
+        ASSERT_NE(fd, -1);
+        close(fd);
+        unlink(name);
+        fileName = std::string(name) + GetParam();
+
+        ProtoOutputStream out(fileName);
+        google::protobuf::StringValue msg;
+        for (uint64_t i = 0; i < NumMsgs; i++) {
+            msg.set_value(payload(i));
+            out.write(msg);
+        }
+    }
+
+    void
+    TearDown() override
+    {
+        if (!fileName.empty())
+            unlink(fileName.c_str());
+    }
+
+    /** Read the next message and check that it is message i */
+    void
+    expectMsg(ProtoInputStream &in, uint64_t i)
+    {
+        google::protobuf::StringValue msg;
+        ASSERT_TRUE(in.read(msg));
+        EXPECT_EQ(msg.value(), payload(i));
+    }
+};
+
+} // anonymous namespace
+
+/** Check that all the messages written are read back in order */
+TEST_P(ProtoIOTest, RoundTrip)
+{
+    ProtoInputStream in(fileName);
+    for (uint64_t i = 0; i < NumMsgs; i++)
+        expectMsg(in, i);
+
+    google::protobuf::StringValue msg;
+    EXPECT_FALSE(in.read(msg));
+}
+
+/** Check that skipping messages leaves the stream at the next one */
+TEST_P(ProtoIOTest, Skip)
+{
+    ProtoInputStream in(fileName);
+    EXPECT_EQ(in.skip(0), 0);
+    expectMsg(in, 0);
+    EXPECT_EQ(in.skip(1), 1);
+    expectMsg(in, 2);
+    EXPECT_EQ(in.skip(NumMsgs / 2), NumMsgs / 2);
+    expectMsg(in, NumMsgs / 2 + 3);
+}
+
+/** Check that skipping past the end only skips the messages left */
+TEST_P(ProtoIOTest, SkipPastEnd)
+{
+    ProtoInputStream in(fileName);
+    EXPECT_EQ(in.skip(10), 10);
+    EXPECT_EQ(in.skip(NumMsgs), NumMsgs - 10);
+
+    google::protobuf::StringValue msg;
+    EXPECT_FALSE(in.read(msg));
+    EXPECT_EQ(in.skip(1), 0);
+}
+
+/** Check that resetting the stream after skipping starts over */
+TEST_P(ProtoIOTest, ResetAfterSkip)
+{
+    ProtoInputStream in(fileName);
+    EXPECT_EQ(in.skip(NumMsgs - 1), NumMsgs - 1);
+    expectMsg(in, NumMsgs - 1);
+
+    in.reset();
+    expectMsg(in, 0);
+    EXPECT_EQ(in.skip(5), 5);
+    expectMsg(in, 6);
+}
+
+INSTANTIATE_TEST_CASE_P(Compression, ProtoIOTest,
+    testing::Values("", ".gz", ".zst"),
+    [](const testing::TestParamInfo<std::string> &info) {
+        return info.param.empty() ? std::string("None") :
+                                    info.param.substr(1);
+    });
@@ -169,7 +169,8 @@ class HighBandwidthMemory(ChanneledMemory):
                 )
             )
         return [
-            (addr_ranges[i], ctrl.port) for i, ctrl in enumerate(self.mem_ctrl)
+            (addr_ranges[i], self._get_channel_port(i))
+            for i in range(len(self.mem_ctrl))
         ]
 
 
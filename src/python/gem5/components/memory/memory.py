@@ -42,6 +42,7 @@ from m5.objects import (
     DRAMInterface,
     MemCtrl,
     Port,
+    ThreadBridge,
 )
 from m5.util.convert import toMemorySize
 
@@ -122,6 +123,8 @@ class ChanneledMemory(AbstractMemorySystem):
         else:
             self._size = self._get_dram_size(num_channels, self._dram_class)
 
+        self._channel_eventq_index = None
+
         self._create_mem_interfaces_controller()
 
     def _create_mem_interfaces_controller(self):
@@ -177,9 +180,57 @@ class ChanneledMemory(AbstractMemorySystem):
                 f"size: {self._intlv_size}"
             )
 
+    def run_channels_in_parallel(
+        self, first_eventq_index: int = 1, bridge_latency: str = "0ns"
+    ) -> None:
+        """Simulate each memory channel on its own event queue.
+
+        The controller of channel ``i`` (and its interfaces) is placed on
+        event queue ``first_eventq_index + i`` and is reached through a
+        ``ThreadBridge``, so that independent channels are simulated by
+        separate threads. This must be called before the memory is
+        connected to the board.
+
+        The root's ``sim_quantum`` must be set. Every access crossing into
+        or out of a channel is delayed by ``bridge_latency``, which must
+        not be smaller than the quantum, so the quantum should be kept
+        small.
+
+        :param first_eventq_index: The event queue of the first channel.
+        :param bridge_latency: The latency of a bridge crossing. By default
+                               this is the simulation quantum, the smallest
+                               allowed latency.
+        """
+        if first_eventq_index < 1:
+            raise ValueError(
+                "Memory channels must not share the main event queue (0)."
+            )
+        self._channel_eventq_index = first_eventq_index
+
+        self.channel_bridge = [
+            ThreadBridge(
+                eventq_index=first_eventq_index + i, delay=bridge_latency
+            )
+            for i in range(len(self.mem_ctrl))
+        ]
+        for i, (ctrl, bridge) in enumerate(
+            zip(self.mem_ctrl, self.channel_bridge)
+        ):
+            ctrl.eventq_index = first_eventq_index + i
+            bridge.out_port = ctrl.port
+
+    def _get_channel_port(self, channel: int) -> Port:
+        """Get the port the rest of the system uses to reach a channel."""
+        if self._channel_eventq_index is None:
+            return self.mem_ctrl[channel].port
+        return self.channel_bridge[channel].in_port
+
     @overrides(AbstractMemorySystem)
     def get_mem_ports(self) -> Sequence[Tuple[AddrRange, Port]]:
-        return [(ctrl.dram.range, ctrl.port) for ctrl in self.mem_ctrl]
+        return [
+            (ctrl.dram.range, self._get_channel_port(i))
+            for i, ctrl in enumerate(self.mem_ctrl)
+        ]
 
     @overrides(AbstractMemorySystem)
     def get_memory_controllers(self) -> List[MemCtrl]:
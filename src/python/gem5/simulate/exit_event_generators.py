@@ -38,6 +38,10 @@ from gem5.resources.looppoint import Looppoint
 from ..components.processors.abstract_processor import AbstractProcessor
 from ..components.processors.switchable_processor import SwitchableProcessor
 from ..resources.resource import SimpointResource
+from .sampling import (
+    SampledStats,
+    SamplingPlan,
+)
 
 """
 In this package we store generators for simulation exit events.
@@ -221,3 +225,83 @@ def looppoint_save_checkpoint_generator(
         yield False
 
     yield True
+
+
+def sampling_generator(
+    processor: SwitchableProcessor,
+    plan: SamplingPlan,
+    sampled_stats: SampledStats,
+    report_path: Optional[Path] = None,
+):
+    """
+    A generator for running a sampled simulation on the ``MAX_INSTS`` exit
+    events. The processor must start with its fast-forward cores, and it is
+    switched to its detailed cores at the start of each sample and back at
+    its end. Each exit event ends a fast-forward, warmup or measurement
+    window, and the next one is scheduled before continuing.
+
+    The statistics are reset at the start of each measurement window and
+    dumped at its end, and the window is added to ``sampled_stats``. After
+    the last sample the weighted estimates are written to ``report_path``
+    and the Simulation loop exits.
+
+    The first fast-forward window must be scheduled before the simulation
+    starts, e.g., with ``Simulator.schedule_sampling``.
+
+    :param processor: The processor to switch between fast-forwarding and
+                      detailed simulation.
+    :param plan: Where to take the samples.
+    :param sampled_stats: Where to record the statistics of each sample.
+    :param report_path: Where to write the estimates. By default this is
+                        ``sampling.json`` in the output directory.
+    """
+    if not report_path:
+        from m5 import options
+
+        report_path = Path(options.outdir) / "sampling.json"
+
+    def schedule(insts: int) -> None:
+        processor.get_cores()[0]._set_inst_stop_any_thread(insts, True)
+
+    def total_insts() -> int:
+        # The committed instruction counts of the cores are not cleared by
+        # a stats reset, so the window is measured by their difference.
+        return sum(
+            core.get_simobject().totalInsts() for core in processor.get_cores()
+        )
+
+    for index in range(plan.get_num_samples()):
+        # The fast-forward window before this sample has ended.
+        processor.switch()
+
+        warmup = plan.get_warmup_insts(index)
+        if warmup:
+            schedule(warmup)
+            yield False
+
+        m5.stats.reset()
+        start_insts = total_insts()
+        start_tick = m5.curTick()
+        schedule(plan.get_measurement_insts())
+        yield False
+
+        cycles = sum(
+            core.get_simobject().resolveStat("numCycles").value
+            for core in processor.get_cores()
+        )
+        sampled_stats.add_sample(
+            weight=plan.get_weight(index),
+            insts=total_insts() - start_insts,
+            cycles=cycles,
+            ticks=m5.curTick() - start_tick,
+        )
+        m5.stats.dump()
+
+        processor.switch()
+
+        if index + 1 < plan.get_num_samples():
+            schedule(plan.get_fast_forward_insts(index + 1))
+            yield False
+
+    sampled_stats.dump(report_path)
+    yield True
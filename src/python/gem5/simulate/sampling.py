@@ -0,0 +1,289 @@
+# Copyright (c) 2026 University of Murcia
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+This module contains the classes used to run a sampled simulation, in which
+most of the workload is fast-forwarded with a fast CPU model and only short
+windows of it are simulated with a detailed one. The statistics measured in
+those windows are combined into weighted estimates for the whole workload.
+"""
+
+import json
+import math
+from pathlib import Path
+from typing import (
+    Dict,
+    List,
+    Optional,
+    Tuple,
+)
+
+from m5.util import fatal
+
+from ..resources.resource import SimpointResource
+
+
+class SamplingPlan:
+    """
+    The samples of a sampled simulation. Each sample starts with a detailed
+    warmup window, which is simulated but not measured, followed by a
+    measurement window. The instructions between samples are fast-forwarded.
+    """
+
+    def __init__(
+        self,
+        start_insts: List[int],
+        measurement_insts: int,
+        warmup_insts: List[int],
+        weights: Optional[List[float]] = None,
+    ) -> None:
+        """
+        :param start_insts: The instruction at which each sample starts,
+                            i.e., where its warmup window begins.
+        :param measurement_insts: The length of the measurement windows.
+        :param warmup_insts: The length of the warmup window of each sample.
+        :param weights: The weight of each sample. If not specified, all the
+                        samples have the same weight.
+        """
+        if weights is None:
+            weights = [1.0] * len(start_insts)
+
+        if not len(start_insts) == len(warmup_insts) == len(weights):
+            fatal(
+                "A sampling plan needs a warmup length and a weight for "
+                "each sample."
+            )
+        if len(start_insts) == 0:
+            fatal("A sampling plan needs at least one sample.")
+        if measurement_insts <= 0:
+            fatal("The measurement windows must be at least one instruction.")
+
+        samples = sorted(zip(start_insts, warmup_insts, weights))
+        self._start_insts = [sample[0] for sample in samples]
+        self._warmup_insts = [sample[1] for sample in samples]
+        self._weights = [sample[2] for sample in samples]
+        self._measurement_insts = measurement_insts
+
+        end = 0
+        for start, warmup in zip(self._start_insts, self._warmup_insts):
+            if start < end:
+                fatal(
+                    f"The sample starting at instruction {start} overlaps "
+                    "with the previous one."
+                )
+            end = start + warmup + measurement_insts
+
+    @classmethod
+    def from_simpoint(cls, simpoint: SimpointResource) -> "SamplingPlan":
+        """
+        Creates a plan with one sample per SimPoint, weighted by the weight
+        of the SimPoint. The measurement windows are as long as the SimPoint
+        interval, and are preceded by the SimPoint warmup.
+
+        :param simpoint: The SimPoints of the workload.
+        """
+        return cls(
+            start_insts=simpoint.get_simpoint_start_insts(),
+            measurement_insts=simpoint.get_simpoint_interval(),
+            warmup_insts=simpoint.get_warmup_list(),
+            weights=simpoint.get_weight_list(),
+        )
+
+    @classmethod
+    def periodic(
+        cls,
+        period: int,
+        num_samples: int,
+        measurement_insts: int,
+        warmup_insts: int = 0,
+        offset: int = 0,
+    ) -> "SamplingPlan":
+        """
+        Creates a plan with samples evenly spread over the workload, as done
+        by systematic sampling (SMARTS). All the samples have the same
+        weight.
+
+        :param period: The number of instructions between the starts of two
+                       consecutive samples.
+        :param num_samples: The number of samples to take.
+        :param measurement_insts: The length of the measurement windows.
+        :param warmup_insts: The length of the warmup windows.
+        :param offset: The instruction at which the first sample starts.
+        """
+        return cls(
+            start_insts=[offset + i * period for i in range(num_samples)],
+            measurement_insts=measurement_insts,
+            warmup_insts=[warmup_insts] * num_samples,
+        )
+
+    def get_num_samples(self) -> int:
+        return len(self._start_insts)
+
+    def get_start_insts(self) -> List[int]:
+        return self._start_insts
+
+    def get_warmup_insts(self, index: int) -> int:
+        return self._warmup_insts[index]
+
+    def get_measurement_insts(self) -> int:
+        return self._measurement_insts
+
+    def get_weight(self, index: int) -> float:
+        return self._weights[index]
+
+    def get_fast_forward_insts(self, index: int) -> int:
+        """
+        Returns the number of instructions to fast-forward before the given
+        sample, counting from the end of the previous one.
+
+        .. note::
+
+            Instruction count events cannot be scheduled for the current
+            instruction, so at least one instruction is fast-forwarded. A
+            sample starting right after the previous one, or at the very
+            beginning of the workload, starts one instruction late.
+        """
+        if index == 0:
+            end = 0
+        else:
+            end = (
+                self._start_insts[index - 1]
+                + self._warmup_insts[index - 1]
+                + self._measurement_insts
+            )
+        return max(1, self._start_insts[index] - end)
+
+
+def _z_score(confidence: float) -> float:
+    """
+    Returns the two-sided z score of a normal distribution for the given
+    confidence level, found by bisection on the error function.
+    """
+    low, high = 0.0, 10.0
+    for _ in range(100):
+        mid = (low + high) / 2
+        if math.erf(mid / math.sqrt(2)) < confidence:
+            low = mid
+        else:
+            high = mid
+    return (low + high) / 2
+
+
+class SampledStats:
+    """
+    The statistics measured in the samples of a sampled simulation, and the
+    weighted estimates computed from them.
+    """
+
+    def __init__(self, confidence: float = 0.95) -> None:
+        """
+        :param confidence: The confidence level of the reported intervals.
+        """
+        if not 0 < confidence < 1:
+            fatal("The confidence level must be between 0 and 1.")
+        self._confidence = confidence
+        self._samples = []
+
+    def add_sample(
+        self, weight: float, insts: int, cycles: int, ticks: int
+    ) -> None:
+        """
+        Records the statistics of a measurement window.
+
+        :param weight: The weight of the sample.
+        :param insts: The instructions committed in the window.
+        :param cycles: The cycles the window took.
+        :param ticks: The ticks the window took.
+        """
+        self._samples.append(
+            {
+                "weight": weight,
+                "insts": insts,
+                "cycles": cycles,
+                "ticks": ticks,
+            }
+        )
+
+    def get_num_samples(self) -> int:
+        return len(self._samples)
+
+    def get_cpi(self) -> Tuple[float, Optional[float]]:
+        """
+        Returns the weighted mean of the CPI of the samples and the half
+        width of its confidence interval. The interval uses the effective
+        number of samples of the weights, so that it matches the usual one
+        when all the weights are the same. The half width is ``None`` if
+        there are not enough samples to estimate it.
+        """
+        samples = [s for s in self._samples if s["insts"] > 0]
+        if not samples:
+            fatal("There are no samples to estimate the CPI from.")
+
+        weights = [s["weight"] for s in samples]
+        values = [s["cycles"] / s["insts"] for s in samples]
+        total = sum(weights)
+        mean = sum(w * v for w, v in zip(weights, values)) / total
+
+        num_eff = total**2 / sum(w**2 for w in weights)
+        if num_eff <= 1:
+            return mean, None
+
+        variance = (
+            sum(w * (v - mean) ** 2 for w, v in zip(weights, values))
+            / total
+            * num_eff
+            / (num_eff - 1)
+        )
+        return mean, _z_score(self._confidence) * math.sqrt(
+            variance / num_eff
+        )
+
+    def to_json(self) -> Dict:
+        """
+        Returns the samples and the estimates in a JSON-style dictionary.
+        """
+        cpi, half_width = self.get_cpi()
+        report = {
+            "confidence": self._confidence,
+            "samples": self._samples,
+            "cpi": {"mean": cpi, "interval": None},
+            "ipc": {"mean": 1 / cpi, "interval": None},
+        }
+        if half_width is not None:
+            low, high = cpi - half_width, cpi + half_width
+            report["cpi"]["interval"] = [low, high]
+            if low > 0:
+                report["ipc"]["interval"] = [1 / high, 1 / low]
+        return report
+
+    def dump(self, path: Path) -> None:
+        """
+        Writes the samples and the estimates to a JSON file.
+
+        :param path: The path of the file to write.
+        """
+        with open(path, "w") as report_file:
+            json.dump(self.to_json(), report_file, indent=4)
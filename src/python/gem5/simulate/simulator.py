@@ -51,10 +51,15 @@ from .exit_event_generators import (
     dump_stats_generator,
     exit_generator,
     reset_stats_generator,
+    sampling_generator,
     save_checkpoint_generator,
     switch_generator,
     warn_default_decorator,
 )
+from .sampling import (
+    SampledStats,
+    SamplingPlan,
+)
 
 
 class Simulator:
@@ -264,7 +269,8 @@ class Simulator:
             * ExitEvent.MAX_TICK: exit simulation
             * ExitEvent.SCHEDULED_TICK: exit simulation
             * ExitEvent.SIMPOINT_BEGIN: reset stats
-            * ExitEvent.MAX_INSTS: exit simulation
+            * ExitEvent.MAX_INSTS: exit simulation, or take the next sample
+              window if ``schedule_sampling`` was called
 
         These generators can be found in the ``exit_event_generator.py`` module.
 
@@ -387,6 +393,66 @@ class Simulator:
         for core in self._board.get_processor().get_cores():
             core._set_inst_stop_any_thread(inst, self._instantiated)
 
+    def schedule_sampling(
+        self,
+        plan: SamplingPlan,
+        confidence: float = 0.95,
+        report_path: Optional[Path] = None,
+    ) -> SampledStats:
+        """
+        Run the simulation as a sampled simulation. The workload is
+        fast-forwarded with the starting cores of the processor, which must be
+        a ``SwitchableProcessor`` (e.g., a ``SimpleSwitchableProcessor``
+        starting with atomic cores), and each sample is simulated with the
+        cores it switches to. The statistics are reset and dumped for each
+        sample, and once all the samples are taken the weighted estimates are
+        written as JSON and the Simulator run loop exits.
+
+        The samples are taken on ``MAX_INSTS`` exit events, which replaces any
+        other behavior set for them. This must be called before the
+        simulation starts.
+
+        .. warning::
+
+            Sampling only works with one core.
+
+        :param plan: Where to take the samples.
+        :param confidence: The confidence level of the reported intervals.
+        :param report_path: Where to write the estimates. By default this is
+                            ``sampling.json`` in the output directory.
+
+        :returns: The statistics of the samples, which may be inspected once
+                  the simulation ends.
+        """
+        processor = self._board.get_processor()
+        if not isinstance(processor, SwitchableProcessor):
+            raise Exception("Sampling needs a SwitchableProcessor.")
+        if self._instantiated:
+            raise Exception(
+                "Sampling must be scheduled before the simulation starts."
+            )
+        if processor.get_num_cores() > 1:
+            warn("Sampling only works with one core")
+
+        sampled_stats = SampledStats(confidence=confidence)
+
+        processor.get_cores()[0]._set_inst_stop_any_thread(
+            plan.get_fast_forward_insts(0), self._instantiated
+        )
+
+        # Do not modify the defaults, which are used when a user generator
+        # ends.
+        if self._on_exit_event is self._default_on_exit_dict:
+            self._on_exit_event = dict(self._default_on_exit_dict)
+        self._on_exit_event[ExitEvent.MAX_INSTS] = sampling_generator(
+            processor=processor,
+            plan=plan,
+            sampled_stats=sampled_stats,
+            report_path=report_path,
+        )
+
+        return sampled_stats
+
     def get_stats(self) -> Dict:
         """
         Obtain the current simulation statistics as a Dictionary, conforming
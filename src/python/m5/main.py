@@ -301,6 +301,13 @@ def parse_options():
         help="Sets the output file for debug. Append '.gz' to the name for it"
         " to be compressed automatically [Default: %default]",
     )
+    option(
+        "--debug-binary",
+        action="store_true",
+        help="Record the debug output in a compact binary format instead of"
+        " formatting it, in debug_trace.bin unless --debug-file names another"
+        " file. Use util/decode_debug_trace.py to turn it into text",
+    )
     option(
         "--debug-activate",
         metavar="EXPR[,EXPR]",
@@ -610,7 +617,14 @@ def main():
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    if options.debug_binary:
+        # Binary traces would garble the terminal, so they go to a file
+        # in the output directory unless another one is given.
+        if options.debug_file in ("cout", "stdout", "cerr", "stderr"):
+            options.debug_file = "debug_trace.bin"
+        trace.output_binary(options.debug_file)
+    else:
+        trace.output(options.debug_file)
 
     for activate in options.debug_activate:
         _check_tracing()
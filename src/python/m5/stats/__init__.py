@@ -37,6 +37,8 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+import atexit
+
 import m5
 from m5.objects import Root
 from m5.params import isNullPointer
@@ -348,12 +350,15 @@ def prepare():
     """Prepare all stats for data access.  This must be done before
     dumping and serialization."""
 
-    # Legacy stats
-    for stat in stats_list:
-        stat.prepare()
-
-    # New stats
-    _visit_stats(lambda g, s: s.prepare())
+    sim_root = Root.getInstance()
+    if sim_root:
+        # Legacy and new stats, without going through Python for each
+        # of them.
+        _m5.stats.prepareStats(sim_root.getCCObject(), stats_list)
+    else:
+        # Legacy stats
+        for stat in stats_list:
+            stat.prepare()
 
 
 def _dump_to_visitor(visitor, roots=None):
@@ -384,6 +389,11 @@ def _dump_to_visitor(visitor, roots=None):
 
 
 lastDump = 0
+
+# Make sure that the dumps still being written when the simulator exits
+# reach their outputs. This handler runs after the ones registered when
+# the simulation starts, including the final dump.
+atexit.register(_m5.stats.drainDumps)
 # List[SimObject].
 global_dump_roots = []
 
@@ -417,13 +427,29 @@ def dump(roots=None):
             sim_root.preDumpStats()
         prepare()
 
+    # Full dumps to the native outputs take a snapshot of the stats and
+    # leave the formatting and the writing to a background thread.
+    native_outputs = [
+        output
+        for output in outputList
+        if not isinstance(output, JsonOutputVistor)
+    ]
+    if not all_roots and native_outputs:
+        _m5.stats.dumpAsync(
+            Root.getInstance().getCCObject(), stats_list, native_outputs
+        )
+    elif native_outputs:
+        # The native outputs can't be used while they are being
+        # written to.
+        _m5.stats.drainDumps()
+
     for output in outputList:
         if isinstance(output, JsonOutputVistor):
             if not all_roots:
                 output.dump(Root.getInstance())
             else:
                 output.dump(all_roots)
-        else:
+        elif all_roots:
             if output.valid():
                 output.begin()
                 _dump_to_visitor(output, roots=all_roots)
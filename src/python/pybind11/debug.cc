@@ -42,13 +42,18 @@
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 
+#include <fstream>
 #include <map>
+#include <string>
 #include <vector>
 
+#include "base/binary_logger.hh"
 #include "base/compiler.hh"
 #include "base/debug.hh"
+#include "base/logging.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
+#include "sim/core.hh"
 #include "sim/debug.hh"
 
 namespace py = pybind11;
@@ -67,6 +72,41 @@ output(const char *filename)
     trace::setDebugLogger(new trace::OstreamLogger(*file_stream->stream()));
 }
 
+static void
+outputBinary(const char *filename)
+{
+    const std::string name(filename);
+    fatal_if(name == "cout" || name == "stdout" ||
+             name == "cerr" || name == "stderr",
+             "Binary debug traces cannot be written to %s, use "
+             "--debug-file to name a file.\n", name);
+
+    OutputStream *file_stream = simout.find(filename);
+
+    if (!file_stream)
+        file_stream = simout.create(filename, true);
+
+    auto *logger = new trace::BinaryLogger(*file_stream->stream());
+    trace::setDebugLogger(logger);
+    // The logger is never deleted, so write what is left in its buffers
+    // before the output files are closed, or when a panic or a fatal
+    // ends the simulation, since the trace is most needed then.
+    auto flush = [logger]() { logger->flush(); };
+    registerExitCallback(flush);
+    Logger::addExitHook(flush);
+}
+
+static void
+decodeBinary(const char *in_name, const char *out_name)
+{
+    std::ifstream in(in_name, std::ios::binary);
+    fatal_if(!in, "Can't open binary debug trace '%s'\n", in_name);
+    std::ofstream out(out_name);
+    fatal_if(!out, "Can't open '%s' for writing\n", out_name);
+
+    trace::decodeBinaryTrace(in, out);
+}
+
 static void
 activate(const char *expr)
 {
@@ -129,6 +169,8 @@ pybind_init_debug(py::module_ &m_native)
     py::module_ m_trace = m_native.def_submodule("trace");
     m_trace
         .def("output", &output)
+        .def("output_binary", &outputBinary)
+        .def("decode_binary", &decodeBinary)
         .def("activate", &activate)
         .def("ignore", &ignore)
         .def("enable", &trace::enable)
@@ -42,6 +42,7 @@
 #include "pybind11/stl.h"
 
 #include "base/statistics.hh"
+#include "base/stats/snapshot.hh"
 #include "base/stats/text.hh"
 #include "config/have_hdf5.hh"
 
@@ -124,6 +125,10 @@ pybind_init_stats(py::module_ &m_native)
         .def("enable", &statistics::enable)
         .def("enabled", &statistics::enabled)
         .def("statsList", &statistics::statsList)
+        .def("prepareStats", &statistics::prepareStats)
+        .def("dumpAsync", &statistics::dumpAsync)
+        .def("drainDumps", &statistics::drainDumps,
+            py::call_guard<py::gil_scoped_release>())
         ;
 
     py::class_<statistics::Output>(m, "Output")
@@ -37,6 +37,8 @@
 
 #include "sim/linear_solver.hh"
 
+#include <algorithm>
+
 namespace gem5
 {
 
@@ -87,4 +89,139 @@ LinearSystem::solve() const
     return ret;
 }
 
+void
+SparseLinearSystem::addCoefficient(unsigned eq, unsigned unkw, double value)
+{
+    assert(eq < rows.size() && unkw < rows.size());
+    auto &row = rows[eq];
+    auto it = std::lower_bound(row.begin(), row.end(), unkw,
+        [](const Coefficient &c, unsigned u) { return c.unkw < u; });
+    if (it != row.end() && it->unkw == unkw)
+        it->value += value;
+    else
+        row.insert(it, Coefficient{unkw, value});
+}
+
+double
+SparseLinearSystem::coefficient(unsigned eq, unsigned unkw) const
+{
+    assert(eq < rows.size() && unkw < rows.size());
+    for (const auto &c : rows[eq]) {
+        if (c.unkw == unkw)
+            return c.value;
+    }
+    return 0;
+}
+
+void
+SparseLinearSystem::clearConstants()
+{
+    std::fill(constants.begin(), constants.end(), 0);
+}
+
+LinearSystem
+SparseLinearSystem::toDense() const
+{
+    LinearSystem ls(size());
+    for (unsigned i = 0; i < size(); i++) {
+        for (const auto &c : rows[i])
+            ls[i][c.unkw] = c.value;
+        ls[i][ls[i].cnt()] = constants[i];
+    }
+    return ls;
+}
+
+void
+SparseLinearSystem::multiply(const std::vector<double> &x,
+                             std::vector<double> &y) const
+{
+    for (unsigned i = 0; i < rows.size(); i++) {
+        double sum = 0;
+        for (const auto &c : rows[i])
+            sum += c.value * x[c.unkw];
+        y[i] = sum;
+    }
+}
+
+unsigned
+SparseLinearSystem::solve(std::vector<double> &x, double tolerance) const
+{
+    const unsigned n = size();
+    x.resize(n, 0);
+
+    // Solve A * x = b, with b being the negated constant terms
+    double b_norm2 = 0;
+    for (auto c : constants)
+        b_norm2 += c * c;
+    if (b_norm2 == 0) {
+        std::fill(x.begin(), x.end(), 0);
+        return 0;
+    }
+    const double max_r_norm2 = tolerance * tolerance * b_norm2;
+
+    // Inverse of the diagonal, used as a preconditioner
+    std::vector<double> inv_diag(n, 1.0);
+    for (unsigned i = 0; i < n; i++) {
+        const double d = coefficient(i, i);
+        if (d != 0)
+            inv_diag[i] = 1.0 / d;
+    }
+
+    std::vector<double> r(n), z(n), p(n), ap(n);
+    multiply(x, ap);
+    double r_norm2 = 0;
+    double rz = 0;
+    for (unsigned i = 0; i < n; i++) {
+        r[i] = -constants[i] - ap[i];
+        z[i] = inv_diag[i] * r[i];
+        p[i] = z[i];
+        r_norm2 += r[i] * r[i];
+        rz += r[i] * z[i];
+    }
+
+    // Conjugate gradient converges in n steps with exact arithmetic,
+    // leave some room for rounding errors
+    const unsigned max_iterations = 2 * n + 10;
+    unsigned iter = 0;
+    while (r_norm2 > max_r_norm2 && iter < max_iterations) {
+        multiply(p, ap);
+        double pap = 0;
+        for (unsigned i = 0; i < n; i++)
+            pap += p[i] * ap[i];
+        if (pap == 0)
+            break;
+
+        const double alpha = rz / pap;
+        double rz_next = 0;
+        r_norm2 = 0;
+        for (unsigned i = 0; i < n; i++) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * ap[i];
+            z[i] = inv_diag[i] * r[i];
+            r_norm2 += r[i] * r[i];
+            rz_next += r[i] * z[i];
+        }
+
+        const double beta = rz_next / rz;
+        for (unsigned i = 0; i < n; i++)
+            p[i] = z[i] + beta * p[i];
+        rz = rz_next;
+        iter++;
+    }
+
+    // Check the actual residual, as the iterations only keep track of an
+    // estimate, and fall back to Gaussian elimination if the method is
+    // far from converging, e.g., because the system is not symmetric
+    multiply(x, ap);
+    double res_norm2 = 0;
+    for (unsigned i = 0; i < n; i++) {
+        const double res = -constants[i] - ap[i];
+        res_norm2 += res * res;
+    }
+    if (res_norm2 > 1e4 * max_r_norm2)
+        x = toDense().solve();
+
+    return iter;
+}
+
 } // namespace gem5
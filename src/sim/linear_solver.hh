@@ -134,6 +134,86 @@ class LinearSystem
     std::vector < LinearEquation > matrix;
 };
 
+/**
+ * A linear system where each equation only involves a few of the
+ * unknowns, such as the nodal equations of a circuit. Only the non-zero
+ * coefficients are kept. The constant terms are kept apart from them, so
+ * that they can be changed on their own when solving the same system
+ * repeatedly, and the system is solved iteratively starting from a guess,
+ * e.g., the previous solution.
+ *
+ * As in LinearEquation, each equation is the sum of the coefficients
+ * times the unknowns plus the constant term, equal to zero.
+ */
+class SparseLinearSystem
+{
+  public:
+    SparseLinearSystem(unsigned unknowns = 0)
+        : rows(unknowns), constants(unknowns, 0)
+    {}
+
+    /** Number of equations and unknowns of the system. */
+    unsigned size() const { return rows.size(); }
+
+    /** Add a value to the coefficient of an unknown in an equation. */
+    void addCoefficient(unsigned eq, unsigned unkw, double value);
+
+    /** Get the coefficient of an unknown in an equation. */
+    double coefficient(unsigned eq, unsigned unkw) const;
+
+    /** Add a value to the constant term of an equation. */
+    void
+    addConstant(unsigned eq, double value)
+    {
+        assert(eq < constants.size());
+        constants[eq] += value;
+    }
+
+    /** Get the constant term of an equation. */
+    double
+    constant(unsigned eq) const
+    {
+        assert(eq < constants.size());
+        return constants[eq];
+    }
+
+    /** Set all the constant terms to zero. */
+    void clearConstants();
+
+    /** Build the equivalent dense system. */
+    LinearSystem toDense() const;
+
+    /**
+     * Solve the system with the conjugate gradient method, using the
+     * diagonal of the coefficients as a preconditioner. This converges
+     * quickly for the symmetric, diagonally dominant systems of RC
+     * networks, and even more so when starting close to the solution.
+     * If it does not converge, the system is solved with Gaussian
+     * elimination instead.
+     *
+     * @param x Initial guess of the solution, replaced by the solution
+     * @param tolerance Largest residual, relative to the constant terms
+     * @return Number of iterations done
+     */
+    unsigned solve(std::vector<double> &x, double tolerance = 1e-10) const;
+
+  private:
+    struct Coefficient
+    {
+        unsigned unkw;
+        double value;
+    };
+
+    /** Compute y = A * x, where A are the coefficients. */
+    void multiply(const std::vector<double> &x, std::vector<double> &y) const;
+
+    /** Non-zero coefficients of each equation, sorted by unknown. */
+    std::vector<std::vector<Coefficient>> rows;
+
+    /** Constant term of each equation. */
+    std::vector<double> constants;
+};
+
 } // namespace gem5
 
 #endif
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "sim/linear_solver.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/**
+ * Build the nodal equations of a square grid of thermal nodes, in the
+ * same way as the thermal model. Neighbouring nodes are connected by
+ * resistors, each node has a capacitor to a reference, and the nodes on
+ * the left edge are connected to that reference. Some power is injected
+ * into each node.
+ */
+SparseLinearSystem
+makeGrid(unsigned side, double step)
+{
+    const double r = 2.0, c = 0.05, r_ref = 1.0, t_ref = 300.0;
+    const double t_prev = 320.0;
+
+    SparseLinearSystem ls(side * side);
+    auto resistor = [&](unsigned a, unsigned b) {
+        ls.addCoefficient(a, a, -1 / r);
+        ls.addCoefficient(a, b, 1 / r);
+        ls.addCoefficient(b, b, -1 / r);
+        ls.addCoefficient(b, a, 1 / r);
+    };
+
+    for (unsigned y = 0; y < side; y++) {
+        for (unsigned x = 0; x < side; x++) {
+            unsigned n = y * side + x;
+            if (x + 1 < side)
+                resistor(n, n + 1);
+            if (y + 1 < side)
+                resistor(n, n + side);
+
+            // Capacitor to the reference
+            ls.addCoefficient(n, n, -c / step);
+            ls.addConstant(n, c / step * t_prev);
+
+            // Resistor to the reference
+            if (x == 0) {
+                ls.addCoefficient(n, n, -1 / r_ref);
+                ls.addConstant(n, t_ref / r_ref);
+            }
+
+            // Power
+            ls.addConstant(n, 0.1 + 0.01 * (n % 7));
+        }
+    }
+
+    return ls;
+}
+
+/** Largest residual of a solution of the system. */
+double
+maxResidual(const SparseLinearSystem &ls, const std::vector<double> &x)
+{
+    double max_res = 0;
+    for (unsigned i = 0; i < ls.size(); i++) {
+        double res = ls.constant(i);
+        for (unsigned j = 0; j < ls.size(); j++)
+            res += ls.coefficient(i, j) * x[j];
+        max_res = std::max(max_res, std::fabs(res));
+    }
+    return max_res;
+}
+
+} // anonymous namespace
+
+/** Test adding and reading back coefficients and constants. */
+TEST(SparseLinearSystemTest, Coefficients)
+{
+    SparseLinearSystem ls(3);
+    ls.addCoefficient(0, 2, 1.5);
+    ls.addCoefficient(0, 0, 2.0);
+    ls.addCoefficient(0, 2, 1.0);
+    ls.addConstant(1, 4.0);
+
+    EXPECT_EQ(ls.coefficient(0, 0), 2.0);
+    EXPECT_EQ(ls.coefficient(0, 1), 0.0);
+    EXPECT_EQ(ls.coefficient(0, 2), 2.5);
+    EXPECT_EQ(ls.constant(1), 4.0);
+
+    ls.clearConstants();
+    EXPECT_EQ(ls.constant(1), 0.0);
+    EXPECT_EQ(ls.coefficient(0, 2), 2.5);
+}
+
+/** Test that the iterative solution matches Gaussian elimination. */
+TEST(SparseLinearSystemTest, MatchesDense)
+{
+    for (unsigned side : {1, 2, 5, 12}) {
+        SparseLinearSystem ls = makeGrid(side, 0.01);
+        std::vector<double> dense = ls.toDense().solve();
+
+        std::vector<double> x(ls.size(), 0.0);
+        ls.solve(x);
+        ASSERT_EQ(x.size(), dense.size());
+        for (unsigned i = 0; i < x.size(); i++)
+            EXPECT_NEAR(x[i], dense[i], 1e-6) << side << " " << i;
+    }
+}
+
+/** Test that starting close to the solution takes fewer iterations. */
+TEST(SparseLinearSystemTest, WarmStart)
+{
+    SparseLinearSystem ls = makeGrid(32, 0.01);
+
+    std::vector<double> x(ls.size(), 0.0);
+    unsigned cold = ls.solve(x);
+    EXPECT_LT(maxResidual(ls, x), 1e-6);
+
+    // Slightly different power, as in the next step of the model
+    for (unsigned i = 0; i < ls.size(); i++)
+        ls.addConstant(i, 1e-4);
+    unsigned warm = ls.solve(x);
+    EXPECT_LT(maxResidual(ls, x), 1e-6);
+    EXPECT_LT(warm, cold);
+}
+
+/** Test that non-symmetric systems are still solved correctly. */
+TEST(SparseLinearSystemTest, NonSymmetric)
+{
+    SparseLinearSystem ls(2);
+    // x0 + 2 * x1 = 5, 3 * x0 + x1 = 5
+    ls.addCoefficient(0, 0, 1);
+    ls.addCoefficient(0, 1, 2);
+    ls.addConstant(0, -5);
+    ls.addCoefficient(1, 0, 3);
+    ls.addCoefficient(1, 1, 1);
+    ls.addConstant(1, -5);
+
+    std::vector<double> x;
+    ls.solve(x);
+    ASSERT_EQ(x.size(), 2);
+    EXPECT_NEAR(x[0], 1.0, 1e-9);
+    EXPECT_NEAR(x[1], 2.0, 1e-9);
+}
+
+/** Test that a system without constant terms is solved by zeros. */
+TEST(SparseLinearSystemTest, Homogeneous)
+{
+    SparseLinearSystem ls = makeGrid(4, 0.01);
+    ls.clearConstants();
+
+    std::vector<double> x(ls.size(), 1.0);
+    ls.solve(x);
+    for (auto v : x)
+        EXPECT_EQ(v, 0.0);
+}
@@ -38,6 +38,7 @@
 #include "sim/mathexpr.hh"
 
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <regex>
 #include <string>
@@ -166,6 +167,98 @@ MathExpr::eval(const Node *n, EvalCallback fn) const {
     return 0;
 }
 
+MathExpr::Program
+MathExpr::compile() const
+{
+    Program prog;
+    compile(root, prog, 0);
+    return prog;
+}
+
+void
+MathExpr::compile(const Node *n, Program &prog, unsigned depth) const
+{
+    Program::Instruction inst{n ? n->op : sValue, 0, 0};
+
+    if (!n) {
+        // Missing operands evaluate to 0, as in eval()
+    } else if (n->op == sValue) {
+        inst.value = n->value;
+    } else if (n->op == sVariable) {
+        auto &vars = prog.variables;
+        auto it = std::find(vars.begin(), vars.end(), n->variable);
+        inst.var = it - vars.begin();
+        if (it == vars.end())
+            vars.push_back(n->variable);
+    } else {
+        panic_if(n->op == nInvalid, "Invalid node!\n");
+        // The unary minus only uses its right operand
+        if (n->op != uNeg) {
+            compile(n->l, prog, depth);
+            depth++;
+        }
+        compile(n->r, prog, depth);
+        prog.code.push_back(inst);
+        return;
+    }
+
+    prog.code.push_back(inst);
+    prog.maxDepth = std::max(prog.maxDepth, depth + 1);
+}
+
+double
+MathExpr::Program::eval(const double *values) const
+{
+    // Expressions rarely need more than a few values on the stack
+    double small_stack[16];
+    std::vector<double> large_stack;
+    double *stack = small_stack;
+    if (maxDepth > 16) {
+        large_stack.resize(maxDepth);
+        stack = large_stack.data();
+    }
+
+    unsigned top = 0;
+    for (const auto &inst : code) {
+        switch (inst.op) {
+          case sValue:
+            stack[top++] = inst.value;
+            break;
+          case sVariable:
+            stack[top++] = values[inst.var];
+            break;
+          case uNeg:
+            stack[top - 1] = -stack[top - 1];
+            break;
+          case bAdd:
+            top--;
+            stack[top - 1] = stack[top - 1] + stack[top];
+            break;
+          case bSub:
+            top--;
+            stack[top - 1] = stack[top - 1] - stack[top];
+            break;
+          case bMul:
+            top--;
+            stack[top - 1] = stack[top - 1] * stack[top];
+            break;
+          case bDiv:
+            top--;
+            stack[top - 1] = stack[top - 1] / stack[top];
+            break;
+          case bPow:
+            top--;
+            stack[top - 1] = std::pow(stack[top - 1], stack[top]);
+            break;
+          default:
+            panic("Invalid instruction!\n");
+        }
+    }
+
+    assert(top == 1);
+    return stack[0];
+}
+
 std::string
 MathExpr::toStr(Node *n, std::string prefix) const {
     std::string ret;
@@ -93,6 +93,67 @@ class MathExpr
         bAdd, bSub, bMul, bDiv, bPow, uNeg, sValue, sVariable, nInvalid
     };
 
+  public:
+    /**
+     * A compiled expression, i.e., a flat program in reverse Polish
+     * notation for a stack machine. Evaluating a program involves no
+     * recursion, no callbacks, and no lookups of the variables by name:
+     * each distinct variable is given an index, and its value is read
+     * from that position of an array provided by the caller.
+     */
+    class Program
+    {
+      public:
+        /**
+         * Return the distinct variables of the program, in the order
+         * of the indices they have been given.
+         *
+         * @return A vector with the names of the variables
+         */
+        const std::vector<std::string> &
+        getVariables() const
+        {
+            return variables;
+        }
+
+        /**
+         * Evaluates the program
+         *
+         * @param values Values of the variables, indexed as in
+         *        getVariables()
+         *
+         * @return The value for this expression
+         */
+        double eval(const double *values) const;
+
+      private:
+        friend class MathExpr;
+
+        struct Instruction
+        {
+            Operator op;
+            /** Constant pushed by sValue, or index of an sVariable. */
+            double value;
+            unsigned var;
+        };
+
+        std::vector<Instruction> code;
+        std::vector<std::string> variables;
+
+        /** Largest number of values on the stack at any time. */
+        unsigned maxDepth = 0;
+    };
+
+    /**
+     * Compiles the expression into a Program, to be evaluated many
+     * times.
+     *
+     * @return The compiled expression
+     */
+    Program compile() const;
+
+  private:
+
     // Match operators
     const int MAX_PRIO = 4;
     typedef double (*binOp)(double, double);
@@ -147,6 +208,15 @@ class MathExpr
     /** Return all variable reachable from a node to a vector of
      * strings */
     void getVariables(const Node *n, std::vector<std::string> &vars) const;
+
+    /**
+     * Append the code for a node to a program, in post-order.
+     *
+     * @param n Node to compile
+     * @param prog Program to append the code to
+     * @param depth Number of values on the stack before this node
+     */
+    void compile(const Node *n, Program &prog, unsigned depth) const;
 };
 
 } // namespace gem5
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 University of Murcia
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "sim/mathexpr.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+const std::map<std::string, double> variables = {
+    {"a", 2.0}, {"b", -3.5}, {"system.cpu.numCycles", 1000.0},
+};
+
+double
+evalTree(const MathExpr &expr)
+{
+    return expr.eval([](std::string name) { return variables.at(name); });
+}
+
+double
+evalProgram(const MathExpr &expr)
+{
+    MathExpr::Program prog = expr.compile();
+    std::vector<double> values;
+    for (const auto &var : prog.getVariables())
+        values.push_back(variables.at(var));
+    return prog.eval(values.data());
+}
+
+} // anonymous namespace
+
+/** Test that constant expressions are evaluated with the usual priorities. */
+TEST(MathExprTest, Constants)
+{
+    EXPECT_EQ(evalProgram(MathExpr("1 + 2 * 3")), 7);
+    EXPECT_EQ(evalProgram(MathExpr("(1 + 2) * 3")), 9);
+    EXPECT_EQ(evalProgram(MathExpr("2 ^ 3 - 10 / 4")), 5.5);
+    EXPECT_EQ(evalProgram(MathExpr("-2 * 3")), -6);
+    EXPECT_EQ(evalProgram(MathExpr("8 - 2 - 1")), 5);
+}
+
+/** Test that each distinct variable is given a single index. */
+TEST(MathExprTest, ProgramVariables)
+{
+    MathExpr::Program prog = MathExpr("a * b + a / system.cpu.numCycles")
+        .compile();
+    ASSERT_EQ(prog.getVariables(),
+              std::vector<std::string>({"a", "b", "system.cpu.numCycles"}));
+
+    double values[] = {1.0, 2.0, 4.0};
+    EXPECT_EQ(prog.eval(values), 1.0 * 2.0 + 1.0 / 4.0);
+}
+
+/** Test that compiled expressions evaluate to the same as the tree. */
+TEST(MathExprTest, ProgramMatchesTree)
+{
+    const char *exprs[] = {
+        "a", "-a", "a - -b", "a ^ 2 ^ 0.5", "(a + b) * (a - b) / 7",
+        "0.5 * system.cpu.numCycles * a ^ 2 + b * 1e-3",
+        "((((((((((((((((((a + 1) + 1) + 1) + 1) + 1) + 1) + 1) + 1) + 1)"
+        " + 1) + 1) + 1) + 1) + 1) + 1) + 1) + 1) * b)",
+        "a + (b + (a + (b + (a + (b + (a + (b + (a + (b + (a + (b + (a + (b"
+        " + (a + (b + (a + b))))))))))))))))",
+    };
+
+    for (auto *e : exprs) {
+        MathExpr expr(e);
+        EXPECT_EQ(evalProgram(expr), evalTree(expr)) << e;
+    }
+}
@@ -37,6 +37,7 @@
 
 #include "sim/power/mathexpr_powermodel.hh"
 
+#include <algorithm>
 #include <string>
 
 #include "base/statistics.hh"
@@ -71,15 +72,71 @@ MathExprPowerModel::startup()
             statsMap[var] = info;
         }
     }
+
+    compile(dyn_expr, dyn_prog);
+    compile(st_expr, st_prog);
+}
+
+void
+MathExprPowerModel::compile(const MathExpr &expr, CompiledExpr &prog)
+{
+    using namespace statistics;
+
+    prog.program = expr.compile();
+    prog.vars.clear();
+
+    for (const auto &var : prog.program.getVariables()) {
+        Variable v;
+        if (var == "temp") {
+            v.kind = Variable::Temp;
+        } else if (var == "voltage") {
+            v.kind = Variable::Voltage;
+        } else if (var == "clock_period") {
+            v.kind = Variable::ClockPeriod;
+        } else {
+            const Info *info = statsMap.at(var);
+
+            // Try to cast the stat, only these are supported right now
+            if ((v.scalar = dynamic_cast<const ScalarInfo *>(info))) {
+                v.kind = Variable::Scalar;
+            } else if ((v.formula = dynamic_cast<const FormulaInfo *>(info))) {
+                v.kind = Variable::Formula;
+            } else {
+                fatal("Unsupported type for stat %s in expression:\n%s\n",
+                      var, expr.toStr());
+            }
+        }
+        prog.vars.push_back(v);
+    }
+
+    values.resize(std::max(values.size(), prog.vars.size()));
 }
 
 double
-MathExprPowerModel::eval(const MathExpr &expr) const
+MathExprPowerModel::eval(const CompiledExpr &prog) const
 {
-    return expr.eval(
-        std::bind(&MathExprPowerModel::getStatValue,
-                  this, std::placeholders::_1)
-        );
+    for (size_t i = 0; i < prog.vars.size(); i++) {
+        const Variable &v = prog.vars[i];
+        switch (v.kind) {
+          case Variable::Temp:
+            values[i] = _temp.toCelsius();
+            break;
+          case Variable::Voltage:
+            values[i] = clocked_object->voltage();
+            break;
+          case Variable::ClockPeriod:
+            values[i] = clocked_object->clockPeriod();
+            break;
+          case Variable::Scalar:
+            values[i] = v.scalar->value();
+            break;
+          case Variable::Formula:
+            values[i] = v.formula->total();
+            break;
+        }
+    }
+
+    return prog.program.eval(values.data());
 }
 
 double
@@ -39,6 +39,7 @@
 #define __SIM_MATHEXPR_POWERMODEL_PM_HH__
 
 #include <unordered_map>
+#include <vector>
 
 #include "params/MathExprPowerModel.hh"
 #include "sim/mathexpr.hh"
@@ -50,6 +51,8 @@ namespace gem5
 namespace statistics
 {
     class Info;
+    class ScalarInfo;
+    class FormulaInfo;
 }
 
 /**
@@ -68,14 +71,14 @@ class MathExprPowerModel : public PowerModelState
      *
      * @return Power (Watts) consumed by this object (dynamic component)
      */
-    double getDynamicPower() const override { return eval(dyn_expr); }
+    double getDynamicPower() const override { return eval(dyn_prog); }
 
     /**
      * Get the static power consumption.
      *
      * @return Power (Watts) consumed by this object (static component)
      */
-    double getStaticPower() const override { return eval(st_expr); }
+    double getStaticPower() const override { return eval(st_prog); }
 
     /**
      * Get the value for a variable (maps to a stat)
@@ -90,18 +93,53 @@ class MathExprPowerModel : public PowerModelState
     void regStats() override;
 
   private:
+    /** Source of the value of a variable in a compiled expression. */
+    struct Variable
+    {
+        enum Kind { Temp, Voltage, ClockPeriod, Scalar, Formula };
+
+        Kind kind;
+        const statistics::ScalarInfo *scalar = nullptr;
+        const statistics::FormulaInfo *formula = nullptr;
+    };
+
+    /**
+     * An expression compiled at startup, with its variables bound to
+     * their sources, so that evaluating it involves no lookups.
+     */
+    struct CompiledExpr
+    {
+        MathExpr::Program program;
+        std::vector<Variable> vars;
+    };
+
     /**
-     * Evaluate an expression in the context of this object, fatal if
-     * evaluation fails.
+     * Compile an expression and bind its variables, fatal if any of
+     * them does not map to a supported stat.
      *
-     * @param expr Expression to evaluate
+     * @param expr Expression to compile
+     * @param prog Compiled expression
+     */
+    void compile(const MathExpr &expr, CompiledExpr &prog);
+
+    /**
+     * Evaluate a compiled expression in the context of this object.
+     * Each variable is read once, however many times it appears.
+     *
+     * @param prog Expression to evaluate
      * @return Value of expression.
      */
-    double eval(const MathExpr &expr) const;
+    double eval(const CompiledExpr &prog) const;
 
     // Math expressions for dynamic and static power
     MathExpr dyn_expr, st_expr;
 
+    // Compiled dynamic and static power expressions
+    CompiledExpr dyn_prog, st_prog;
+
+    // Values of the variables of the expression being evaluated
+    mutable std::vector<double> values;
+
     // Map that contains relevant stats for this power model
     std::unordered_map<std::string, const statistics::Info*> statsMap;
 };
@@ -43,8 +43,7 @@
 namespace gem5
 {
 
-class LinearEquation;
-class ThermalNode;
+class SparseLinearSystem;
 
 /**
  * An abstract class that represents any thermal entity which is used
@@ -54,9 +53,21 @@ class ThermalNode;
 class ThermalEntity
 {
   public:
-    // Get the equation given a node and a step in seconds (assuming N nodes)
-    virtual LinearEquation getEquation(ThermalNode *tn, unsigned n,
-                                       double step) const = 0;
+    /**
+     * Add the coefficients of the unknown temperatures this entity
+     * contributes to the nodal equations of the nodes it is connected
+     * to, given a step in seconds. These do not change between steps.
+     */
+    virtual void addCoefficients(SparseLinearSystem &ls,
+                                 double step) const = 0;
+
+    /**
+     * Add the constant terms this entity contributes to the nodal
+     * equations of the nodes it is connected to, given a step in
+     * seconds. These depend on the current temperatures and power.
+     */
+    virtual void addConstants(SparseLinearSystem &ls,
+                              double step) const = 0;
 };
 
 } // namespace gem5
@@ -58,11 +58,15 @@ ThermalReference::ThermalReference(const Params &p)
 {
 }
 
-LinearEquation
-ThermalReference::getEquation(ThermalNode * n, unsigned nnodes,
-                              double step) const {
-    // Just return an empty equation
-    return LinearEquation(nnodes);
+void
+ThermalReference::addCoefficients(SparseLinearSystem &ls, double step) const
+{
+    // References have no nodal equation
+}
+
+void
+ThermalReference::addConstants(SparseLinearSystem &ls, double step) const
+{
 }
 
 /**
@@ -73,31 +77,38 @@ ThermalResistor::ThermalResistor(const Params &p)
 {
 }
 
-LinearEquation
-ThermalResistor::getEquation(ThermalNode * n, unsigned nnodes,
-                             double step) const
+void
+ThermalResistor::addCoefficients(SparseLinearSystem &ls, double step) const
 {
-    // i[n] = (Vn2 - Vn1)/R
-    LinearEquation eq(nnodes);
-
-    if (n != node1 && n != node2)
-        return eq;
-
-    if (node1->isref)
-        eq[eq.cnt()] += -node1->temp.toKelvin() / _resistance;
-    else
-        eq[node1->id] += -1.0f / _resistance;
-
-    if (node2->isref)
-        eq[eq.cnt()] += node2->temp.toKelvin() / _resistance;
-    else
-        eq[node2->id] += 1.0f / _resistance;
-
-    // We've assumed n was node1, reverse if necessary
-    if (n == node2)
-        eq *= -1.0f;
+    // i[n] = (Vn2 - Vn1)/R for node1, and the reverse for node2
+    for (auto n : {node1, node2}) {
+        if (n->isref)
+            continue;
+        double sign = n == node1 ? 1.0 : -1.0;
+
+        if (!node1->isref)
+            ls.addCoefficient(n->id, node1->id, -sign / _resistance);
+        if (!node2->isref)
+            ls.addCoefficient(n->id, node2->id, sign / _resistance);
+    }
+}
 
-    return eq;
+void
+ThermalResistor::addConstants(SparseLinearSystem &ls, double step) const
+{
+    // The temperatures of the references are known
+    for (auto n : {node1, node2}) {
+        if (n->isref)
+            continue;
+        double sign = n == node1 ? 1.0 : -1.0;
+
+        if (node1->isref)
+            ls.addConstant(n->id, -sign * node1->temp.toKelvin() /
+                                  _resistance);
+        if (node2->isref)
+            ls.addConstant(n->id, sign * node2->temp.toKelvin() /
+                                  _resistance);
+    }
 }
 
 /**
@@ -108,35 +119,43 @@ ThermalCapacitor::ThermalCapacitor(const Params &p)
 {
 }
 
-LinearEquation
-ThermalCapacitor::getEquation(ThermalNode * n, unsigned nnodes,
-                              double step) const
+void
+ThermalCapacitor::addCoefficients(SparseLinearSystem &ls, double step) const
 {
     // i(t) = C * d(Vn2 - Vn1)/dt
     // i[n] = C/step * (Vn2 - Vn1 - Vn2[n-1] + Vn1[n-1])
-    LinearEquation eq(nnodes);
-
-    if (n != node1 && n != node2)
-        return eq;
-
-    eq[eq.cnt()] += _capacitance / step *
-        (node1->temp - node2->temp).toKelvin();
-
-    if (node1->isref)
-        eq[eq.cnt()] += _capacitance / step * (-node1->temp.toKelvin());
-    else
-        eq[node1->id] += -1.0f * _capacitance / step;
-
-    if (node2->isref)
-        eq[eq.cnt()] += _capacitance / step * (node2->temp.toKelvin());
-    else
-        eq[node2->id] += 1.0f * _capacitance / step;
-
-    // We've assumed n was node1, reverse if necessary
-    if (n == node2)
-        eq *= -1.0f;
+    // for node1, and the reverse for node2
+    for (auto n : {node1, node2}) {
+        if (n->isref)
+            continue;
+        double sign = n == node1 ? 1.0 : -1.0;
+
+        if (!node1->isref)
+            ls.addCoefficient(n->id, node1->id,
+                              -sign * _capacitance / step);
+        if (!node2->isref)
+            ls.addCoefficient(n->id, node2->id, sign * _capacitance / step);
+    }
+}
 
-    return eq;
+void
+ThermalCapacitor::addConstants(SparseLinearSystem &ls, double step) const
+{
+    // The previous temperatures, and those of the references, are known
+    for (auto n : {node1, node2}) {
+        if (n->isref)
+            continue;
+        double sign = n == node1 ? 1.0 : -1.0;
+
+        ls.addConstant(n->id, sign * _capacitance / step *
+                              (node1->temp - node2->temp).toKelvin());
+        if (node1->isref)
+            ls.addConstant(n->id, -sign * _capacitance / step *
+                                  node1->temp.toKelvin());
+        if (node2->isref)
+            ls.addConstant(n->id, sign * _capacitance / step *
+                                  node2->temp.toKelvin());
+    }
 }
 
 /**
@@ -151,20 +170,14 @@ void
 ThermalModel::doStep()
 {
     // Calculate new temperatures!
-    // For each node in the system, create the kirchhoff nodal equation
-    LinearSystem ls(eq_nodes.size());
-    for (unsigned i = 0; i < eq_nodes.size(); i++) {
-        auto n = eq_nodes[i];
-        LinearEquation node_equation (eq_nodes.size());
-        for (auto e : entities) {
-            LinearEquation eq = e->getEquation(n, eq_nodes.size(), _step);
-            node_equation = node_equation + eq;
-        }
-        ls[i] = node_equation;
-    }
-
-    // Get temperatures for this iteration
-    std::vector <double> temps = ls.solve();
+    // The coefficients of the kirchhoff nodal equations do not change,
+    // only their constant terms need to be computed again
+    system.clearConstants();
+    for (auto e : entities)
+        e->addConstants(system, _step);
+
+    // Get temperatures for this iteration, starting from the last ones
+    system.solve(temps);
     for (unsigned i = 0; i < eq_nodes.size(); i++)
         eq_nodes[i]->temp = Temperature::fromKelvin(temps[i]);
 
@@ -205,6 +218,15 @@ ThermalModel::startup()
     for (unsigned i = 0; i < eq_nodes.size(); i++)
         eq_nodes[i]->id = i;
 
+    // For each node in the system, create the kirchhoff nodal equation
+    system = SparseLinearSystem(eq_nodes.size());
+    for (auto e : entities)
+        e->addCoefficients(system, _step);
+
+    temps.resize(eq_nodes.size());
+    for (unsigned i = 0; i < eq_nodes.size(); i++)
+        temps[i] = eq_nodes[i]->temp.toKelvin();
+
     // Schedule first thermal update
     schedule(stepEvent, curTick() + sim_clock::as_int::s * _step);
 }
@@ -42,6 +42,7 @@
 
 #include "base/temperature.hh"
 #include "sim/clocked_object.hh"
+#include "sim/linear_solver.hh"
 #include "sim/power/thermal_domain.hh"
 #include "sim/power/thermal_entity.hh"
 #include "sim/power/thermal_node.hh"
@@ -71,8 +72,9 @@ class ThermalResistor : public SimObject, public ThermalEntity
         node2 = n2;
     }
 
-    LinearEquation getEquation(ThermalNode * tn, unsigned n,
-                               double step) const override;
+    void addCoefficients(SparseLinearSystem &ls,
+                         double step) const override;
+    void addConstants(SparseLinearSystem &ls, double step) const override;
 
   private:
     /* Resistance value in K/W */
@@ -92,8 +94,9 @@ class ThermalCapacitor : public SimObject, public ThermalEntity
     typedef ThermalCapacitorParams Params;
     ThermalCapacitor(const Params &p);
 
-    LinearEquation getEquation(ThermalNode * tn, unsigned n,
-                               double step) const override;
+    void addCoefficients(SparseLinearSystem &ls,
+                         double step) const override;
+    void addConstants(SparseLinearSystem &ls, double step) const override;
 
     void setNodes(ThermalNode * n1, ThermalNode * n2) {
         node1 = n1;
@@ -123,8 +126,9 @@ class ThermalReference : public SimObject, public ThermalEntity
         node = n;
     }
 
-    LinearEquation getEquation(ThermalNode * tn, unsigned n,
-                               double step) const override;
+    void addCoefficients(SparseLinearSystem &ls,
+                         double step) const override;
+    void addConstants(SparseLinearSystem &ls, double step) const override;
 
     /* Fixed temperature value */
     const Temperature _temperature;
@@ -178,6 +182,12 @@ class ThermalModel : public ClockedObject
 
     /** Step in seconds for thermal updates */
     const double _step;
+
+    /** Nodal equations of the unknown temperature nodes */
+    SparseLinearSystem system;
+
+    /** Temperatures of the unknown nodes (K) of the last step */
+    std::vector<double> temps;
 };
 
 } // namespace gem5
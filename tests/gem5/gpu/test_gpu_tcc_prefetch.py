@@ -0,0 +1,73 @@
+# Copyright (c) 2026 University of Murcia
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Runs the square kernel with apu_se.py and a prefetcher in the VIPER TCC,
+checking that the kernel still passes and that prefetches are issued.
+"""
+
+import re
+
+from testlib import *
+
+if config.bin_path:
+    resource_path = config.bin_path
+else:
+    resource_path = joinpath(absdirpath(__file__), "..", "resources")
+
+# The kernel runs on the ROCm runtime, which has to be available, e.g., in
+# the gcn-gpu docker image
+binary_dir = joinpath(resource_path, "gpu", "square")
+square = DownloadedProgram(
+    config.resource_url + "/test-progs/square/square", binary_dir, "square"
+)
+
+# A tagged (next-line) prefetcher issues prefetches on every demand miss
+gem5_verify_config(
+    name="gpu-tcc-prefetch-square",
+    fixtures=(square,),
+    verifiers=(
+        verifier.MatchRegex(re.compile(r"PASSED!")),
+        verifier.MatchFileRegex(
+            re.compile(
+                r"system\.ruby\.tcc_cntrl0\.prefetcher\.pfIssued\s+[1-9]"
+            ),
+            ["stats.txt"],
+        ),
+    ),
+    config=joinpath(config.base_dir, "configs", "example", "apu_se.py"),
+    config_args=[
+        "-n",
+        "3",
+        "--tcc-hwp-type",
+        "TaggedPrefetcher",
+        "-c",
+        joinpath(binary_dir, "square"),
+    ],
+    valid_isas=(constants.vega_x86_tag,),
+    valid_hosts=constants.supported_hosts,
+    length=constants.long_tag,
+)
@@ -70,6 +70,16 @@ gem5_verify_config(
     length=constants.long_tag,
 )
 
+for name, args in [("serial", []), ("parallel", ["--parallel"])]:
+    gem5_verify_config(
+        name="thread_bridge_" + name,
+        verifiers=(),  # No need for verfiers this will return non-zero on fail
+        config=joinpath(getcwd(), "thread-bridge-run.py"),
+        config_args=args,
+        valid_isas=(constants.null_tag,),
+        length=constants.long_tag,
+    )
+
 null_tests = [
     ("garnet_synth_traffic", None, ["--sim-cycles", "5000000"]),
     ("memcheck", None, ["--maxtick", "2000000000", "--prefetchers"]),
@@ -0,0 +1,82 @@
+# Copyright (c) 2026 University of Murcia
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Run MemTest against a memory behind a ThreadBridge. The testers have
+private caches, so writebacks and responses are often crossing the bridge
+when a functional access reaches it, and MemTest checks that the data it
+reads back is never stale. With --parallel the memory is simulated on its
+own event queue, in parallel with the rest of the system.
+"""
+
+import argparse
+
+import m5
+from m5.objects import *
+
+m5.util.addToPath("../../../configs/")
+from common.Caches import *
+
+parser = argparse.ArgumentParser()
+parser.add_argument(
+    "--parallel",
+    action="store_true",
+    help="Simulate the memory on its own event queue",
+)
+args = parser.parse_args()
+
+nb_cores = 4
+cpus = [MemTest(max_loads=1e5, progress_interval=1e4) for i in range(nb_cores)]
+
+system = System(cpu=cpus, physmem=SimpleMemory(), membus=SystemXBar())
+system.voltage_domain = VoltageDomain()
+system.clk_domain = SrcClockDomain(
+    clock="1GHz", voltage_domain=system.voltage_domain
+)
+
+# Small caches, so that there are plenty of writebacks
+for cpu in cpus:
+    cpu.l1c = L1Cache(size="1kB", assoc=2)
+    cpu.l1c.cpu_side = cpu.port
+    cpu.l1c.mem_side = system.membus.cpu_side_ports
+
+system.system_port = system.membus.cpu_side_ports
+
+memory_eventq = 1 if args.parallel else 0
+system.bridge = ThreadBridge(eventq_index=memory_eventq)
+system.physmem.eventq_index = memory_eventq
+system.membus.mem_side_ports = system.bridge.in_port
+system.bridge.out_port = system.physmem.port
+
+root = Root(full_system=False, system=system)
+root.system.mem_mode = "timing"
+if args.parallel:
+    root.sim_quantum = 1000
+
+m5.instantiate()
+exit_event = m5.simulate()
+if exit_event.getCause() != "maximum number of loads reached":
+    exit(1)
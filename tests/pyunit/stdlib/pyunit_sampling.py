@@ -0,0 +1,247 @@
+# Copyright (c) 2026 University of Murcia
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import json
+import tempfile
+import unittest
+from pathlib import Path
+from unittest.mock import patch
+
+from gem5.simulate.exit_event_generators import sampling_generator
+from gem5.simulate.sampling import (
+    SampledStats,
+    SamplingPlan,
+)
+
+
+class SamplingPlanTestSuite(unittest.TestCase):
+    """Tests the simulate.sampling.SamplingPlan class."""
+
+    def test_periodic(self) -> None:
+        plan = SamplingPlan.periodic(
+            period=1000,
+            num_samples=3,
+            measurement_insts=100,
+            warmup_insts=50,
+            offset=200,
+        )
+
+        self.assertEqual(3, plan.get_num_samples())
+        self.assertEqual([200, 1200, 2200], plan.get_start_insts())
+        self.assertEqual(50, plan.get_warmup_insts(1))
+        self.assertEqual(100, plan.get_measurement_insts())
+        self.assertEqual(1.0, plan.get_weight(2))
+        self.assertEqual(200, plan.get_fast_forward_insts(0))
+        self.assertEqual(850, plan.get_fast_forward_insts(1))
+        self.assertEqual(850, plan.get_fast_forward_insts(2))
+
+    def test_sorted_by_start(self) -> None:
+        plan = SamplingPlan(
+            start_insts=[3000, 1000],
+            measurement_insts=100,
+            warmup_insts=[20, 10],
+            weights=[0.75, 0.25],
+        )
+
+        self.assertEqual([1000, 3000], plan.get_start_insts())
+        self.assertEqual(10, plan.get_warmup_insts(0))
+        self.assertEqual(0.25, plan.get_weight(0))
+        self.assertEqual(1890, plan.get_fast_forward_insts(1))
+
+    def test_fast_forward_at_least_one(self) -> None:
+        plan = SamplingPlan(
+            start_insts=[0, 100],
+            measurement_insts=100,
+            warmup_insts=[0, 0],
+        )
+
+        self.assertEqual(1, plan.get_fast_forward_insts(0))
+        self.assertEqual(1, plan.get_fast_forward_insts(1))
+
+    def test_overlapping_samples(self) -> None:
+        with self.assertRaises(SystemExit):
+            SamplingPlan(
+                start_insts=[0, 50],
+                measurement_insts=100,
+                warmup_insts=[0, 0],
+            )
+
+
+class SampledStatsTestSuite(unittest.TestCase):
+    """Tests the simulate.sampling.SampledStats class."""
+
+    def test_single_sample(self) -> None:
+        stats = SampledStats()
+        stats.add_sample(weight=1.0, insts=100, cycles=150, ticks=1500)
+
+        cpi, half_width = stats.get_cpi()
+        self.assertAlmostEqual(1.5, cpi)
+        self.assertIsNone(half_width)
+        self.assertIsNone(stats.to_json()["cpi"]["interval"])
+
+    def test_equal_weights(self) -> None:
+        stats = SampledStats(confidence=0.95)
+        for cycles in [100, 200, 300, 400]:
+            stats.add_sample(weight=1.0, insts=100, cycles=cycles, ticks=0)
+
+        cpi, half_width = stats.get_cpi()
+        self.assertAlmostEqual(2.5, cpi)
+        # The sample standard deviation is sqrt(5/3), so the half width is
+        # 1.96 * sqrt(5/3) / sqrt(4).
+        self.assertAlmostEqual(1.959964 * (5 / 3) ** 0.5 / 2, half_width, 5)
+
+    def test_weighted_mean(self) -> None:
+        stats = SampledStats()
+        stats.add_sample(weight=0.75, insts=100, cycles=100, ticks=0)
+        stats.add_sample(weight=0.25, insts=200, cycles=600, ticks=0)
+
+        cpi, _ = stats.get_cpi()
+        self.assertAlmostEqual(1.5, cpi)
+
+        report = stats.to_json()
+        self.assertAlmostEqual(1 / 1.5, report["ipc"]["mean"])
+        self.assertEqual(2, len(report["samples"]))
+
+
+class _FakeStat:
+    def __init__(self, value: int) -> None:
+        self.value = value
+
+
+class _FakeCPU:
+    """A BaseCPU stand-in whose committed instructions are never reset."""
+
+    def __init__(self, cpi: int) -> None:
+        self.cpi = cpi
+        self.insts = 0
+        self.cycles = 0
+        self.stop = None
+
+    def totalInsts(self) -> int:
+        return self.insts
+
+    def resolveStat(self, name: str) -> _FakeStat:
+        assert name == "numCycles"
+        return _FakeStat(self.cycles)
+
+
+class _FakeCore:
+    def __init__(self, cpu: _FakeCPU) -> None:
+        self.cpu = cpu
+
+    def get_simobject(self) -> _FakeCPU:
+        return self.cpu
+
+    def _set_inst_stop_any_thread(self, inst: int, at_start: bool) -> None:
+        self.cpu.stop = inst
+
+
+class _FakeSimulation:
+    """
+    Runs a sampling generator against a processor with a fast-forward and a
+    detailed core, committing the instructions scheduled on the active core
+    before each exit event.
+    """
+
+    def __init__(self) -> None:
+        self.tick = 0
+        self.fast = _FakeCore(_FakeCPU(cpi=1))
+        self.detailed = _FakeCore(_FakeCPU(cpi=2))
+        self.active = self.fast
+
+    # The SwitchableProcessor interface used by the generator.
+    def get_cores(self):
+        return [self.active]
+
+    def switch(self) -> None:
+        self.active = self.detailed if self.active is self.fast else self.fast
+
+    def reset_stats(self) -> None:
+        self.fast.cpu.cycles = 0
+        self.detailed.cpu.cycles = 0
+
+    def cur_tick(self) -> int:
+        return self.tick
+
+    def run(self) -> None:
+        cpu = self.active.cpu
+        cpu.insts += cpu.stop
+        cpu.cycles += cpu.stop * cpu.cpi
+        self.tick += cpu.stop * cpu.cpi * 1000
+        cpu.stop = None
+
+
+class SamplingGeneratorTestSuite(unittest.TestCase):
+    """Tests the simulate.exit_event_generators.sampling_generator."""
+
+    def test_measures_only_the_window(self) -> None:
+        sim = _FakeSimulation()
+        plan = SamplingPlan.periodic(
+            period=1000,
+            num_samples=3,
+            measurement_insts=100,
+            warmup_insts=50,
+            offset=200,
+        )
+        stats = SampledStats()
+
+        with tempfile.TemporaryDirectory() as outdir, patch(
+            "m5.stats.reset", side_effect=sim.reset_stats
+        ), patch("m5.stats.dump"), patch(
+            "m5.curTick", side_effect=sim.cur_tick
+        ):
+            report_path = Path(outdir) / "sampling.json"
+            generator = sampling_generator(
+                processor=sim,
+                plan=plan,
+                sampled_stats=stats,
+                report_path=report_path,
+            )
+
+            # The first fast-forward window is scheduled before starting.
+            sim.fast._set_inst_stop_any_thread(
+                plan.get_fast_forward_insts(0), True
+            )
+            exits = 0
+            while True:
+                sim.run()
+                exits += 1
+                if next(generator):
+                    break
+
+            with open(report_path) as report_file:
+                report = json.load(report_file)
+
+        # A fast-forward, warmup and measurement window per sample.
+        self.assertEqual(9, exits)
+        self.assertIs(sim.fast, sim.active)
+        self.assertEqual(3, stats.get_num_samples())
+        for sample in report["samples"]:
+            self.assertEqual(100, sample["insts"])
+            self.assertEqual(200, sample["cycles"])
+            self.assertEqual(200000, sample["ticks"])
+        self.assertAlmostEqual(2.0, report["cpi"]["mean"])
+        self.assertAlmostEqual(0.0, report["cpi"]["interval"][1] - 2.0)